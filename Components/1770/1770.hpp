@@ -36,6 +36,9 @@ class WD1770: public Storage::Disk::MFMController {
 		/// Sets the value of the double-density input; when @c is_double_density is @c true, reads and writes double-density format data.
 		using Storage::Disk::MFMController::set_is_double_density;
 
+		/// Enables or disables reading of sector-image tracks directly, rather than via flux transitions and the PLL.
+		using Storage::Disk::MFMController::set_allows_direct_reading;
+
 		/// Writes @c value to the register at @c address. Only the low two bits of the address are decoded.
 		void write(int address, uint8_t value);
 
@@ -8,6 +8,7 @@
 
 #include "6560.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace MOS::MOS6560;
@@ -112,14 +113,80 @@ void AudioGenerator::get_samples(std::size_t number_of_samples, int16_t *target)
 		update(2, 0, shift);
 		update(3, 1, increment);
 
-		// this sums the output of all three sounds channels plus a DC offset for volume;
-		// TODO: what's the real ratio of this stuff?
-		target[c] = int16_t(
-			(shift_registers_[0]&1) +
-			(shift_registers_[1]&1) +
-			(shift_registers_[2]&1) +
-			((noise_pattern[shift_registers_[3] >> 3] >> (shift_registers_[3]&7))&(control_registers_[3] >> 7)&1)
-		) * volume_ + (volume_ >> 4);
+		target[c] = output_level();
+	}
+}
+
+int16_t AudioGenerator::output_level() const {
+	// this sums the output of all three sounds channels plus a DC offset for volume;
+	// TODO: what's the real ratio of this stuff?
+	return int16_t(int16_t(
+		(shift_registers_[0]&1) +
+		(shift_registers_[1]&1) +
+		(shift_registers_[2]&1) +
+		((noise_pattern[shift_registers_[3] >> 3] >> (shift_registers_[3]&7))&(control_registers_[3] >> 7)&1)
+	) * volume_ + (volume_ >> 4));
+}
+
+unsigned int AudioGenerator::advance_counter(int channel, int shift, unsigned int samples) {
+	// Counters update upon reaching 0x80 << shift; cf. the update macro above.
+	const unsigned int until = (0x80u << shift) - counters_[channel];
+	if(samples < until) {
+		counters_[channel] += samples;
+		return 0;
+	}
+
+	const unsigned int reload = unsigned(control_registers_[channel]&0x7f) << shift;
+	const unsigned int period = (0x80u << shift) - reload;
+	counters_[channel] = reload + (samples - until) % period;
+	return 1 + (samples - until) / period;
+}
+
+void AudioGenerator::get_steps(std::size_t number_of_samples, Outputs::Speaker::StepTarget &target) {
+	// Catch up on any change in level since the last call, e.g. due to a volume change.
+	int16_t level = output_level();
+	if(level != reported_level_) {
+		target.add_step(0, level - reported_level_);
+		reported_level_ = level;
+	}
+
+	static constexpr int shifts[4] = {2, 1, 0, 1};
+	std::size_t c = 0;
+	while(c < number_of_samples) {
+		// Find the number of samples that will pass before anything audible happens. A tone channel
+		// that is disabled and has fully drained is inert, as updating it will affect nothing observable,
+		// and the noise channel is inert while disabled.
+		unsigned int quiet = unsigned(number_of_samples - c);
+		for(int channel = 0; channel < 4; channel++) {
+			const bool is_inert = !(control_registers_[channel]&0x80) && (channel == 3 || !(shift_registers_[channel]&0xff));
+			if(!is_inert) {
+				quiet = std::min(quiet, (0x80u << shifts[channel]) - counters_[channel] - 1);
+			}
+		}
+
+		// Skip those, if any.
+		if(quiet) {
+			advance_counter(0, 2, quiet);
+			advance_counter(1, 1, quiet);
+			advance_counter(2, 0, quiet);
+			shift_registers_[3] = (shift_registers_[3] + advance_counter(3, 1, quiet)) % 8191;
+
+			c += quiet;
+			if(c == number_of_samples) break;
+		}
+
+		// Perform the next sample in full.
+		update(0, 2, shift);
+		update(1, 1, shift);
+		update(2, 0, shift);
+		update(3, 1, increment);
+
+		level = output_level();
+		if(level != reported_level_) {
+			target.add_step(c, level - reported_level_);
+			reported_level_ = level;
+		}
+		++c;
 	}
 }
 
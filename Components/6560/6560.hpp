@@ -28,6 +28,8 @@ class AudioGenerator: public ::Outputs::Speaker::SampleSource {
 
 		// For ::SampleSource.
 		void get_samples(std::size_t number_of_samples, int16_t *target);
+		void get_steps(std::size_t number_of_samples, Outputs::Speaker::StepTarget &target);
+		static constexpr bool get_supplies_steps() { return true; }
 		void skip_samples(std::size_t number_of_samples);
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return false; }
@@ -40,6 +42,10 @@ class AudioGenerator: public ::Outputs::Speaker::SampleSource {
 		uint8_t control_registers_[4] = {0, 0, 0, 0};
 		int16_t volume_ = 0;
 		int16_t range_multiplier_ = 1;
+
+		int16_t output_level() const;
+		int16_t reported_level_ = 0;
+		unsigned int advance_counter(int channel, int shift, unsigned int samples);
 };
 
 struct BusHandler {
@@ -11,8 +11,10 @@
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
+#include <type_traits>
 
 namespace Motorola {
 namespace CRTC {
@@ -41,6 +43,26 @@ class BusHandler {
 			having to wait until the next cycle has begun.
 		*/
 		void perform_bus_cycle_phase2(const BusState &) {}
+
+		/*!
+			Performs both phases of @c count consecutive bus cycles, across which nothing changes other than
+			the refresh address. That is @c refresh_address for the first and increments by one, modulo 0x4000,
+			for each subsequent cycle.
+
+			Since no sync or other state changes across the run, phase 2 of each cycle would be identical
+			to phase 2 of the cycle immediately before the run and therefore carries no new information.
+
+			The default implementation performs phase 1 of each cycle individually. Handlers that inherit it
+			are supplied their own @c perform_bus_cycle_phase1 per cycle by the CRTC, so need implement this
+			only if they can do better.
+		*/
+		void perform_bus_cycles(const BusState &state, int count) {
+			BusState cycle_state = state;
+			while(count--) {
+				perform_bus_cycle_phase1(cycle_state);
+				cycle_state.refresh_address = (cycle_state.refresh_address + 1) & 0x3fff;
+			}
+		}
 };
 
 enum Personality {
@@ -112,7 +134,17 @@ template <class T> class CRTC6845 {
 
 		void run_for(Cycles cycles) {
 			auto cyles_remaining = cycles.as_integral();
-			while(cyles_remaining--) {
+			while(cyles_remaining) {
+				// Hand over any run of cycles in which only the refresh address changes as a single
+				// span; the cycle that follows it is then performed individually below.
+				const auto quiet_cycles = std::min(Cycles::IntType(quiet_cycles_remaining()), cyles_remaining);
+				if(quiet_cycles > 1) {
+					perform_bus_cycles(int(quiet_cycles));
+					cyles_remaining -= quiet_cycles;
+					continue;
+				}
+				--cyles_remaining;
+
 				// check for end of visible characters
 				if(character_counter_ == registers_[1]) {
 					// TODO: consider skew in character_is_visible_. Or maybe defer until perform_bus_cycle?
@@ -164,7 +196,53 @@ template <class T> class CRTC6845 {
 			return bus_state_;
 		}
 
+		/*!
+			@returns the number of cycles from now that will pass before the next change to the bus state
+			other than to its refresh address, i.e. before the next change to sync, display enable or
+			row address. Might be zero.
+		*/
+		Cycles get_next_sequence_point() const {
+			return Cycles(quiet_cycles_remaining());
+		}
+
 	private:
+		/// @returns The number of cycles, starting with the next, in which nothing will happen other than increment of the refresh address.
+		inline int quiet_cycles_remaining() const {
+			// Horizontal sync has a counter that is checked every cycle; display enable will be in flux
+			// until the skew shifter has filled with the current visibility.
+			if(bus_state_.hsync) return 0;
+			if((character_is_visible_shifter_ & 3) != (character_is_visible_ ? 3u : 0u)) return 0;
+
+			// Otherwise the next events are the end of visible characters, the end of the line, or the
+			// start of horizontal sync. The last is tested for after character_counter_ has been incremented.
+			// These are all equality tests against a uint8_t counter, so distances are modulo 256.
+			return std::min({
+				uint8_t(registers_[1] - character_counter_),
+				uint8_t(registers_[0] - character_counter_),
+				uint8_t(registers_[2] - character_counter_ - 1),
+			});
+		}
+
+		inline void perform_bus_cycles(int count) {
+			// The skew shifter's low bits are already uniformly character_is_visible_, so a single shift
+			// is enough to leave them as they would be after count.
+			character_is_visible_shifter_ = (character_is_visible_shifter_ << 1) | unsigned(character_is_visible_);
+			bus_state_.display_enable = (int(character_is_visible_shifter_) & display_skew_mask_) && line_is_visible_;
+			if constexpr (std::is_same_v<decltype(&T::perform_bus_cycles), decltype(&BusHandler::perform_bus_cycles)>) {
+				// The inherited default can't reach T's phase 1, so loop here instead.
+				BusState cycle_state = bus_state_;
+				for(int c = 0; c < count; c++) {
+					bus_handler_.perform_bus_cycle_phase1(cycle_state);
+					cycle_state.refresh_address = (cycle_state.refresh_address + 1) & 0x3fff;
+				}
+			} else {
+				bus_handler_.perform_bus_cycles(bus_state_, count);
+			}
+
+			bus_state_.refresh_address = (bus_state_.refresh_address + count) & 0x3fff;
+			character_counter_ = uint8_t(character_counter_ + count);
+		}
+
 		inline void perform_bus_cycle_phase1() {
 			// Skew theory of operation: keep a history of the last three states, and apply whichever is selected.
 			character_is_visible_shifter_ = (character_is_visible_shifter_ << 1) | unsigned(character_is_visible_);
@@ -40,6 +40,9 @@ class i8272 : public Storage::Disk::MFMController {
 		void set_dma_acknowledge(bool dack);
 		void set_terminal_count(bool tc);
 
+		/// Enables or disables reading of sector-image tracks directly, rather than via flux transitions and the PLL.
+		using Storage::Disk::MFMController::set_allows_direct_reading;
+
 		ClockingHint::Preference preferred_clocking() const final;
 
 	protected:
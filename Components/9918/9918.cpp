@@ -13,6 +13,14 @@
 #include <cstdlib>
 #include "../../Outputs/Log.hpp"
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TMS_USE_X86_SIMD
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define TMS_USE_NEON
+#endif
+
 using namespace TI::TMS;
 
 namespace {
@@ -47,6 +55,171 @@ struct ReverseTable {
 	}
 } reverse_table;
 
+/*!
+	Maps from a byte of pattern to eight bytes, each either 0 or 1, being its bits in
+	display order, i.e. most-significant first or, if flipped, least-significant first.
+
+	Expanding each plane of a planar tile row and combining them with shifts and ORs
+	then produces all eight pixels' palette indices at once, without carries between bytes.
+*/
+struct PatternExpansionTable {
+	uint64_t map[2][256];
+
+	PatternExpansionTable() {
+		for(int c = 0; c < 256; ++c) {
+			uint8_t bytes[8];
+			for(int bit = 0; bit < 8; ++bit) bytes[bit] = uint8_t((c >> (bit ^ 7)) & 1);
+			memcpy(&map[0][c], bytes, sizeof(bytes));
+
+			for(int bit = 0; bit < 8; ++bit) bytes[bit] = uint8_t((c >> bit) & 1);
+			memcpy(&map[1][c], bytes, sizeof(bytes));
+		}
+	}
+
+	/// @returns Eight palette indices, one per byte in display order, for the four-plane pattern at @c planes.
+	uint64_t expand(const uint8_t *planes, bool flipped) const {
+		const auto &table = map[flipped];
+		return
+			table[planes[0]] |
+			(table[planes[1]] << 1) |
+			(table[planes[2]] << 2) |
+			(table[planes[3]] << 3);
+	}
+} pattern_expansion_table;
+
+// MARK: - Whole-column and whole-line pixel helpers.
+
+/// Writes eight pixels to @c target, each being @c colours[1] if the corresponding bit of @c pattern is set,
+/// or @c colours[0] otherwise; the most-significant bit is output first.
+void expand_1bpp_scalar(uint8_t pattern, const uint32_t *colours, uint32_t *target) {
+	for(int c = 0; c < 8; ++c) {
+		target[c] = colours[(pattern >> (c ^ 7)) & 1];
+	}
+}
+
+/// Takes the sprite colour in place of the background colour wherever @c sprites is non-zero and
+/// @c colours indicates neither tile priority (bit 5) nor transparency (a zero in the low four bits).
+void composite_sprites_scalar(uint8_t *colours, const uint8_t *sprites, int start, int end) {
+	for(int c = start; c < end; ++c) {
+		if(
+			sprites[c] &&
+			(!(colours[c]&0x20) || !(colours[c]&0xf))
+		) colours[c] = sprites[c];
+	}
+}
+
+#ifdef TMS_USE_X86_SIMD
+
+bool has_sse2() {
+	static const bool has_sse2 = __builtin_cpu_supports("sse2");
+	return has_sse2;
+}
+
+__attribute__((target("sse2"))) void expand_1bpp_sse2(uint8_t pattern, const uint32_t *colours, uint32_t *target) {
+	const __m128i bits = _mm_set1_epi32(pattern);
+	const __m128i masks[2] = {
+		_mm_setr_epi32(0x80, 0x40, 0x20, 0x10),
+		_mm_setr_epi32(0x08, 0x04, 0x02, 0x01)
+	};
+	const __m128i background = _mm_set1_epi32(int(colours[0]));
+	const __m128i difference = _mm_xor_si128(background, _mm_set1_epi32(int(colours[1])));
+
+	for(int c = 0; c < 2; ++c) {
+		const __m128i selected = _mm_cmpeq_epi32(_mm_and_si128(bits, masks[c]), masks[c]);
+		_mm_storeu_si128(
+			reinterpret_cast<__m128i *>(&target[c << 2]),
+			_mm_xor_si128(background, _mm_and_si128(selected, difference))
+		);
+	}
+}
+
+__attribute__((target("sse2"))) void composite_sprites_sse2(uint8_t *colours, const uint8_t *sprites, int start, int end) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i priority = _mm_set1_epi8(0x20);
+	const __m128i index = _mm_set1_epi8(0x0f);
+
+	int c = start;
+	for(; c + 16 <= end; c += 16) {
+		const __m128i sprite = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&sprites[c]));
+		const __m128i colour = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&colours[c]));
+
+		const __m128i sprite_visible = _mm_or_si128(
+			_mm_cmpeq_epi8(_mm_and_si128(colour, priority), zero),
+			_mm_cmpeq_epi8(_mm_and_si128(colour, index), zero)
+		);
+		const __m128i take_sprite = _mm_andnot_si128(_mm_cmpeq_epi8(sprite, zero), sprite_visible);
+
+		_mm_storeu_si128(
+			reinterpret_cast<__m128i *>(&colours[c]),
+			_mm_or_si128(_mm_and_si128(take_sprite, sprite), _mm_andnot_si128(take_sprite, colour))
+		);
+	}
+	composite_sprites_scalar(colours, sprites, c, end);
+}
+
+#endif
+
+#ifdef TMS_USE_NEON
+
+void expand_1bpp_neon(uint8_t pattern, const uint32_t *colours, uint32_t *target) {
+	static constexpr uint32_t masks[8] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+	const uint32x4_t bits = vdupq_n_u32(pattern);
+	const uint32x4_t background = vdupq_n_u32(colours[0]);
+	const uint32x4_t foreground = vdupq_n_u32(colours[1]);
+
+	for(int c = 0; c < 2; ++c) {
+		const uint32x4_t selected = vtstq_u32(bits, vld1q_u32(&masks[c << 2]));
+		vst1q_u32(&target[c << 2], vbslq_u32(selected, foreground, background));
+	}
+}
+
+void composite_sprites_neon(uint8_t *colours, const uint8_t *sprites, int start, int end) {
+	const uint8x16_t priority = vdupq_n_u8(0x20);
+	const uint8x16_t index = vdupq_n_u8(0x0f);
+
+	int c = start;
+	for(; c + 16 <= end; c += 16) {
+		const uint8x16_t sprite = vld1q_u8(&sprites[c]);
+		const uint8x16_t colour = vld1q_u8(&colours[c]);
+
+		// A lane is taken from the sprite if the sprite is non-zero and the background has either
+		// no priority or a transparent colour, i.e. if it is not the case that both are set.
+		const uint8x16_t background_wins = vandq_u8(vtstq_u8(colour, priority), vtstq_u8(colour, index));
+		const uint8x16_t take_sprite = vbicq_u8(vtstq_u8(sprite, sprite), background_wins);
+
+		vst1q_u8(&colours[c], vbslq_u8(take_sprite, sprite, colour));
+	}
+	composite_sprites_scalar(colours, sprites, c, end);
+}
+
+#endif
+
+void expand_1bpp(uint8_t pattern, const uint32_t *colours, uint32_t *target) {
+#if defined(TMS_USE_X86_SIMD)
+	if(has_sse2()) {
+		expand_1bpp_sse2(pattern, colours, target);
+		return;
+	}
+#elif defined(TMS_USE_NEON)
+	expand_1bpp_neon(pattern, colours, target);
+	return;
+#endif
+	expand_1bpp_scalar(pattern, colours, target);
+}
+
+void composite_sprites(uint8_t *colours, const uint8_t *sprites, int start, int end) {
+#if defined(TMS_USE_X86_SIMD)
+	if(has_sse2()) {
+		composite_sprites_sse2(colours, sprites, start, end);
+		return;
+	}
+#elif defined(TMS_USE_NEON)
+	composite_sprites_neon(colours, sprites, start, end);
+	return;
+#endif
+	composite_sprites_scalar(colours, sprites, start, end);
+}
+
 }
 
 Base::Base(Personality p) :
@@ -812,9 +985,13 @@ void Base::draw_tms_character(int start, int end) {
 		int background_pixels_left = pixels_left;
 		while(true) {
 			background_pixels_left -= length;
-			for(int c = 0; c < length; ++c) {
-				pixel_target_[c] = colours[pattern&0x01];
-				pattern >>= 1;
+			if(length == 8) {
+				expand_1bpp(line_buffer.patterns[byte_column][0], colours, pixel_target_);
+			} else {
+				for(int c = 0; c < length; ++c) {
+					pixel_target_[c] = colours[pattern&0x01];
+					pattern >>= 1;
+				}
 			}
 			pixel_target_ += length;
 
@@ -888,9 +1065,16 @@ void Base::draw_tms_text(int start, int end) {
 	int length = std::min(pixels_left, 6 - shift);
 	while(true) {
 		pixels_left -= length;
-		for(int c = 0; c < length; ++c) {
-			pixel_target_[c] = colours[pattern&0x01];
-			pattern >>= 1;
+
+		// Whole columns can be expanded to eight pixels, provided that the two extra
+		// are within this run and so will subsequently be overwritten.
+		if(length == 6 && pixels_left >= 2) {
+			expand_1bpp(line_buffer.patterns[byte_column][0], colours, pixel_target_);
+		} else {
+			for(int c = 0; c < length; ++c) {
+				pixel_target_[c] = colours[pattern&0x01];
+				pattern >>= 1;
+			}
 		}
 		pixel_target_ += length;
 
@@ -903,80 +1087,43 @@ void Base::draw_tms_text(int start, int end) {
 
 void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 	LineBuffer &line_buffer = line_buffers_[read_pointer_.row];
-	int colour_buffer[256];
+
+	// Whole tile columns are written to the colour buffer, so allow for the final one
+	// to be partially scrolled out of view.
+	uint8_t colour_buffer[256 + 8];
 
 	/*
-		Add extra border for any pixels that fall before the fine scroll.
+		Determine the fine scroll, if applicable; tile pixel x is displayed at x + fine_scroll.
 	*/
-	int tile_start = start, tile_end = end;
-	int tile_offset = start;
+	int fine_scroll = 0;
 	if(read_pointer_.row >= 16 || !master_system_.horizontal_scroll_lock) {
-		for(int c = start; c < (line_buffer.latched_horizontal_scroll & 7); ++c) {
-			colour_buffer[c] = 16 + background_colour_;
-			++tile_offset;
-		}
-
-		// Remove the border area from that to which tiles will be drawn.
-		tile_start = std::max(start - (line_buffer.latched_horizontal_scroll & 7), 0);
-		tile_end = std::max(end - (line_buffer.latched_horizontal_scroll & 7), 0);
+		fine_scroll = line_buffer.latched_horizontal_scroll & 7;
 	}
-
-
-	uint32_t pattern;
-	uint8_t *const pattern_index = reinterpret_cast<uint8_t *>(&pattern);
+	const int tile_start = std::max(start - fine_scroll, 0);
+	const int tile_end = std::max(end - fine_scroll, 0);
 
 	/*
 		Add background tiles; these will fill the colour_buffer with values in which
 		the low five bits are a palette index, and bit six is set if this tile has
 		priority over sprites.
 	*/
-	if(tile_start < end) {
-		const int shift = tile_start & 7;
-		int byte_column = tile_start >> 3;
-		int pixels_left = tile_end - tile_start;
-		int length = std::min(pixels_left, 8 - shift);
-
-		pattern = *reinterpret_cast<const uint32_t *>(line_buffer.patterns[byte_column]);
-		if(line_buffer.names[byte_column].flags&2)
-			pattern >>= shift;
-		else
-			pattern <<= shift;
-
-		while(true) {
-			const int palette_offset = (line_buffer.names[byte_column].flags&0x18) << 1;
-			if(line_buffer.names[byte_column].flags&2) {
-				for(int c = 0; c < length; ++c) {
-					colour_buffer[tile_offset] =
-						((pattern_index[3] & 0x01) << 3) |
-						((pattern_index[2] & 0x01) << 2) |
-						((pattern_index[1] & 0x01) << 1) |
-						((pattern_index[0] & 0x01) << 0) |
-						palette_offset;
-					++tile_offset;
-					pattern >>= 1;
-				}
-			} else {
-				for(int c = 0; c < length; ++c) {
-					colour_buffer[tile_offset] =
-						((pattern_index[3] & 0x80) >> 4) |
-						((pattern_index[2] & 0x80) >> 5) |
-						((pattern_index[1] & 0x80) >> 6) |
-						((pattern_index[0] & 0x80) >> 7) |
-						palette_offset;
-					++tile_offset;
-					pattern <<= 1;
-				}
-			}
-
-			pixels_left -= length;
-			if(!pixels_left) break;
-
-			length = std::min(8, pixels_left);
-			byte_column++;
-			pattern = *reinterpret_cast<const uint32_t *>(line_buffer.patterns[byte_column]);
+	if(tile_start < tile_end) {
+		for(int byte_column = tile_start >> 3; byte_column <= (tile_end - 1) >> 3; ++byte_column) {
+			const uint8_t flags = line_buffer.names[byte_column].flags;
+			const uint64_t colours =
+				pattern_expansion_table.expand(line_buffer.patterns[byte_column], flags & 2) |
+				(uint64_t((flags & 0x18) << 1) * 0x0101'0101'0101'0101);
+			memcpy(&colour_buffer[fine_scroll + (byte_column << 3)], &colours, sizeof(colours));
 		}
 	}
 
+	/*
+		Add extra border for any pixels that fall before the fine scroll.
+	*/
+	for(int c = start; c < fine_scroll; ++c) {
+		colour_buffer[c] = uint8_t(16 + background_colour_);
+	}
+
 	/*
 		Apply sprites (if any).
 	*/
@@ -991,7 +1138,7 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 			}
 		}
 
-		int sprite_buffer[256];
+		uint8_t sprite_buffer[256];
 		int sprite_collision = 0;
 		memset(&sprite_buffer[start], 0, size_t(end - start)*sizeof(sprite_buffer[0]));
 
@@ -1001,16 +1148,12 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 			if(sprite.shift_position < 16) {
 				const int pixel_start = std::max(start, sprite.x);
 
-				// TODO: it feels like the work below should be simplifiable;
-				// the double shift in particular, and hopefully the variable shift.
-				for(int c = pixel_start; c < end && sprite.shift_position < 16; ++c) {
-					const int shift = (sprite.shift_position >> 1);
-					const int sprite_colour =
-						(((sprite.image[3] << shift) & 0x80) >> 4) |
-						(((sprite.image[2] << shift) & 0x80) >> 5) |
-						(((sprite.image[1] << shift) & 0x80) >> 6) |
-						(((sprite.image[0] << shift) & 0x80) >> 7);
+				uint8_t sprite_colours[8];
+				const uint64_t expanded_colours = pattern_expansion_table.expand(sprite.image, false);
+				memcpy(sprite_colours, &expanded_colours, sizeof(sprite_colours));
 
+				for(int c = pixel_start; c < end && sprite.shift_position < 16; ++c) {
+					const uint8_t sprite_colour = sprite_colours[sprite.shift_position >> 1];
 					if(sprite_colour) {
 						sprite_collision |= sprite_buffer[c];
 						sprite_buffer[c] = sprite_colour | 0x10;
@@ -1023,12 +1166,7 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 
 		// Draw the sprite buffer onto the colour buffer, wherever the tile map doesn't have
 		// priority (or is transparent).
-		for(int c = start; c < end; ++c) {
-			if(
-				sprite_buffer[c] &&
-				(!(colour_buffer[c]&0x20) || !(colour_buffer[c]&0xf))
-			) colour_buffer[c] = sprite_buffer[c];
-		}
+		composite_sprites(colour_buffer, sprite_buffer, start, end);
 
 		if(sprite_collision)
 			status_ |= StatusSpriteCollision;
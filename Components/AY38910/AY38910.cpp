@@ -6,6 +6,7 @@
 //  Copyright 2016 Thomas Harte. All rights reserved.
 //
 
+#include <algorithm>
 #include <cmath>
 
 #include "AY38910.hpp"
@@ -101,6 +102,45 @@ template <bool is_stereo> void AY38910<is_stereo>::set_output_mixing(float a_lef
 	c_right_ = uint8_t(c_right * 255.0f);
 }
 
+template <bool is_stereo> void AY38910<is_stereo>::advance_noise() {
+	noise_output_ ^= noise_shift_register_&1;
+	noise_shift_register_ |= ((noise_shift_register_ ^ (noise_shift_register_ >> 3))&1) << 17;
+	noise_shift_register_ >>= 1;
+}
+
+template <bool is_stereo> void AY38910<is_stereo>::tick() {
+#define step_channel(c) \
+	if(tone_counters_[c]) tone_counters_[c]--;\
+	else {\
+		tone_outputs_[c] ^= 1;\
+		tone_counters_[c] = tone_periods_[c] << 1;\
+	}
+
+	// Update the tone channels.
+	step_channel(0);
+	step_channel(1);
+	step_channel(2);
+
+#undef step_channel
+
+	// Update the noise generator. This recomputes the new bit repeatedly but harmlessly, only shifting
+	// it into the official 17 upon divider underflow.
+	if(noise_counter_) noise_counter_--;
+	else {
+		noise_counter_ = noise_period_ << 1;	// To cover the double resolution of envelopes.
+		advance_noise();
+	}
+
+	// Update the envelope generator. Table based for pattern lookup, with a 'refill' step: a way of
+	// implementing non-repeating patterns by locking them to the final table position.
+	if(envelope_divider_) envelope_divider_--;
+	else {
+		envelope_divider_ = envelope_period_;
+		envelope_position_ ++;
+		if(envelope_position_ == 64) envelope_position_ = envelope_overflow_masks_[output_registers_[13]];
+	}
+}
+
 template <bool is_stereo> void AY38910<is_stereo>::get_samples(std::size_t number_of_samples, int16_t *target) {
 	// Note on structure below: the real AY has a built-in divider of 8
 	// prior to applying its tone and noise dividers. But the YM fills the
@@ -123,39 +163,7 @@ template <bool is_stereo> void AY38910<is_stereo>::get_samples(std::size_t numbe
 	}
 
 	while(c < number_of_samples) {
-#define step_channel(c) \
-	if(tone_counters_[c]) tone_counters_[c]--;\
-	else {\
-		tone_outputs_[c] ^= 1;\
-		tone_counters_[c] = tone_periods_[c] << 1;\
-	}
-
-		// Update the tone channels.
-		step_channel(0);
-		step_channel(1);
-		step_channel(2);
-
-#undef step_channel
-
-		// Update the noise generator. This recomputes the new bit repeatedly but harmlessly, only shifting
-		// it into the official 17 upon divider underflow.
-		if(noise_counter_) noise_counter_--;
-		else {
-			noise_counter_ = noise_period_ << 1;	// To cover the double resolution of envelopes.
-			noise_output_ ^= noise_shift_register_&1;
-			noise_shift_register_ |= ((noise_shift_register_ ^ (noise_shift_register_ >> 3))&1) << 17;
-			noise_shift_register_ >>= 1;
-		}
-
-		// Update the envelope generator. Table based for pattern lookup, with a 'refill' step: a way of
-		// implementing non-repeating patterns by locking them to the final table position.
-		if(envelope_divider_) envelope_divider_--;
-		else {
-			envelope_divider_ = envelope_period_;
-			envelope_position_ ++;
-			if(envelope_position_ == 64) envelope_position_ = envelope_overflow_masks_[output_registers_[13]];
-		}
-
+		tick();
 		evaluate_output_volume();
 
 		for(int ic = 0; ic < 4 && c < number_of_samples; ic++) {
@@ -172,6 +180,121 @@ template <bool is_stereo> void AY38910<is_stereo>::get_samples(std::size_t numbe
 	master_divider_ &= 3;
 }
 
+template <bool is_stereo> typename AY38910<is_stereo>::Audibility AY38910<is_stereo>::audibility() const {
+	// A channel with a fixed volume of 0 contributes nothing.
+	Audibility audibility;
+	for(int c = 0; c < 3; c++) {
+		const int volume = output_registers_[8 + c];
+		if(!(volume & 0x1f)) continue;
+
+		audibility.envelope |= bool(volume & 0x10);
+		audibility.noise |= !(output_registers_[7] & (8 << c));
+		if(!(output_registers_[7] & (1 << c))) audibility.tones |= 1 << c;
+	}
+	return audibility;
+}
+
+template <bool is_stereo> void AY38910<is_stereo>::get_steps(std::size_t number_of_samples, Outputs::Speaker::StepTarget &target) {
+	// Catch up on any change in level since the last call, e.g. due to a register write.
+	post_level(0, target);
+	advance(number_of_samples, &target);
+}
+
+template <bool is_stereo> void AY38910<is_stereo>::skip_samples(std::size_t number_of_samples) {
+	advance(number_of_samples, nullptr);
+	evaluate_output_volume();
+}
+
+template <bool is_stereo> bool AY38910<is_stereo>::is_constant_level(std::size_t number_of_samples, std::int16_t *level) const {
+	// Output is constant if no audible part of the generator changes state before the
+	// last tick within the period; ticks occur as per get_samples.
+	const std::size_t offset = std::size_t((4 - master_divider_) & 3);
+	if(offset < number_of_samples) {
+		const int ticks = int((number_of_samples - offset + 3) >> 2);
+		const auto audible = audibility();
+		for(int c = 0; c < 3; c++) {
+			if((audible.tones & (1 << c)) && tone_counters_[c] < ticks) return false;
+		}
+		if(audible.noise && noise_counter_ < ticks) return false;
+		if(audible.envelope && envelope_divider_ < ticks) return false;
+	}
+
+	if constexpr (is_stereo) {
+		const int16_t *const output = reinterpret_cast<const int16_t *>(&output_volume_);
+		level[0] = output[0];
+		level[1] = output[1];
+	} else {
+		level[0] = int16_t(output_volume_);
+	}
+	return true;
+}
+
+template <bool is_stereo> void AY38910<is_stereo>::advance(std::size_t number_of_samples, Outputs::Speaker::StepTarget *target) {
+	// Determine which parts of the generator are currently audible; anything else
+	// can be advanced in bulk. If not posting steps then nothing is audible.
+	const Audibility audible = target ? audibility() : Audibility();
+
+	// Ticks occur as per get_samples, whenever the master divider reaches a multiple of four.
+	std::size_t offset = std::size_t((4 - master_divider_) & 3);
+	master_divider_ = int((std::size_t(master_divider_) + number_of_samples) & 3);
+
+	while(offset < number_of_samples) {
+		// Find the number of ticks that will pass before anything audible happens.
+		int quiet = int((number_of_samples - offset + 3) >> 2);
+		for(int c = 0; c < 3; c++) {
+			if(audible.tones & (1 << c)) quiet = std::min(quiet, tone_counters_[c]);
+		}
+		if(audible.noise) quiet = std::min(quiet, noise_counter_);
+		if(audible.envelope) quiet = std::min(quiet, envelope_divider_);
+
+		// Skip those, if any.
+		if(quiet) {
+			for(int c = 0; c < 3; c++) {
+				tone_outputs_[c] ^= Outputs::Speaker::advance_divider(tone_counters_[c], tone_periods_[c] << 1, quiet) & 1;
+			}
+
+			const int noise_steps = Outputs::Speaker::advance_divider(noise_counter_, noise_period_ << 1, quiet);
+			for(int c = 0; c < noise_steps; c++) advance_noise();
+
+			const int envelope_steps = Outputs::Speaker::advance_divider(envelope_divider_, envelope_period_, quiet);
+			if(envelope_steps) {
+				const int position = envelope_position_ + envelope_steps;
+				if(position < 64) {
+					envelope_position_ = position;
+				} else if(envelope_overflow_masks_[output_registers_[13]]) {
+					envelope_position_ = 0x3f;
+				} else {
+					envelope_position_ = position & 0x3f;
+				}
+			}
+
+			offset += std::size_t(quiet) << 2;
+			if(offset >= number_of_samples) break;
+		}
+
+		// Perform the next tick in full.
+		tick();
+		if(target) {
+			evaluate_output_volume();
+			post_level(offset, *target);
+		}
+		offset += 4;
+	}
+}
+
+template <bool is_stereo> void AY38910<is_stereo>::post_level(std::size_t offset, Outputs::Speaker::StepTarget &target) {
+	if(output_volume_ == reported_volume_) return;
+
+	if constexpr (is_stereo) {
+		const int16_t *const output = reinterpret_cast<const int16_t *>(&output_volume_);
+		const int16_t *const reported = reinterpret_cast<const int16_t *>(&reported_volume_);
+		target.add_step(offset, output[0] - reported[0], output[1] - reported[1]);
+	} else {
+		target.add_step(offset, int(output_volume_) - int(reported_volume_));
+	}
+	reported_volume_ = output_volume_;
+}
+
 template <bool is_stereo> void AY38910<is_stereo>::evaluate_output_volume() {
 	int envelope_volume = envelope_shapes_[output_registers_[13]][envelope_position_ | envelope_position_mask_];
 
@@ -249,47 +372,16 @@ template <bool is_stereo> void AY38910<is_stereo>::set_register_value(uint8_t va
 	// There are only 16 registers.
 	if(selected_register_ > 15) return;
 
-	// If this is a register that affects audio output, enqueue a mutation onto the
-	// audio generation thread.
+	// If this is a register that affects audio output, log it or enqueue a mutation
+	// onto the audio generation thread.
 	if(selected_register_ < 14) {
-		task_queue_.defer([this, selected_register = selected_register_, value] () {
-			// Perform any register-specific mutation to output generation.
-			uint8_t masked_value = value;
-			switch(selected_register) {
-				case 0: case 2: case 4:
-				case 1: case 3: case 5: {
-					int channel = selected_register >> 1;
-
-					if(selected_register & 1)
-						tone_periods_[channel] = (tone_periods_[channel] & 0xff) | uint16_t((value&0xf) << 8);
-					else
-						tone_periods_[channel] = (tone_periods_[channel] & ~0xff) | value;
-				}
-				break;
-
-				case 6:
-					noise_period_ = value & 0x1f;
-				break;
-
-				case 11:
-					envelope_period_ = (envelope_period_ & ~0xff) | value;
-				break;
-
-				case 12:
-					envelope_period_ = (envelope_period_ & 0xff) | int(value << 8);
-				break;
-
-				case 13:
-					masked_value &= 0xf;
-					envelope_position_ = 0;
-				break;
-			}
-
-			// Store a copy of the current register within the storage used by the audio generation
-			// thread, and apply any changes to output volume.
-			output_registers_[selected_register] = masked_value;
-			evaluate_output_volume();
-		});
+		if(log_input_) {
+			log_input_.post(uint16_t(selected_register_), value);
+		} else {
+			task_queue_.defer([this, selected_register = selected_register_, value] () {
+				apply_register_value(selected_register, value);
+			});
+		}
 	}
 
 	// Decide which outputs are going to need updating (if any).
@@ -314,6 +406,51 @@ template <bool is_stereo> void AY38910<is_stereo>::set_register_value(uint8_t va
 	if(update_port_a) set_port_output(false);
 }
 
+template <bool is_stereo> void AY38910<is_stereo>::apply_register_value(int selected_register, uint8_t value) {
+	// Perform any register-specific mutation to output generation.
+	uint8_t masked_value = value;
+	switch(selected_register) {
+		case 0: case 2: case 4:
+		case 1: case 3: case 5: {
+			int channel = selected_register >> 1;
+
+			if(selected_register & 1)
+				tone_periods_[channel] = (tone_periods_[channel] & 0xff) | uint16_t((value&0xf) << 8);
+			else
+				tone_periods_[channel] = (tone_periods_[channel] & ~0xff) | value;
+		}
+		break;
+
+		case 6:
+			noise_period_ = value & 0x1f;
+		break;
+
+		case 11:
+			envelope_period_ = (envelope_period_ & ~0xff) | value;
+		break;
+
+		case 12:
+			envelope_period_ = (envelope_period_ & 0xff) | int(value << 8);
+		break;
+
+		case 13:
+			masked_value &= 0xf;
+			envelope_position_ = 0;
+		break;
+	}
+
+	// Store a copy of the current register within the storage used by the audio generation
+	// thread, and apply any changes to output volume.
+	output_registers_[selected_register] = masked_value;
+	evaluate_output_volume();
+}
+
+template <bool is_stereo> void AY38910<is_stereo>::set_register_log(Outputs::Speaker::RegisterLog &log) {
+	log_input_ = log.add_input(this, [](void *ay, uint16_t address, uint8_t value) {
+		static_cast<AY38910 *>(ay)->apply_register_value(address, value);
+	});
+}
+
 template <bool is_stereo> uint8_t AY38910<is_stereo>::get_register_value() {
 	// This table ensures that bits that aren't defined within the AY are returned as 0s
 	// when read, conforming to CPC-sourced unit tests.
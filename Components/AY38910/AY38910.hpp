@@ -9,6 +9,7 @@
 #ifndef AY_3_8910_hpp
 #define AY_3_8910_hpp
 
+#include "../../Outputs/Speaker/Implementation/RegisterLog.hpp"
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
 
@@ -105,14 +106,26 @@ template <bool is_stereo> class AY38910: public ::Outputs::Speaker::SampleSource
 		*/
 		void set_output_mixing(float a_left, float b_left, float c_left, float a_right = 1.0, float b_right = 1.0, float c_right = 1.0);
 
+		/*!
+			Directs all future audio-affecting register writes to @c log rather than to the
+			queue supplied at construction.
+		*/
+		void set_register_log(Outputs::Speaker::RegisterLog &log);
+
 		// to satisfy ::Outputs::Speaker (included via ::Outputs::Filter.
 		void get_samples(std::size_t number_of_samples, int16_t *target);
+		void get_steps(std::size_t number_of_samples, Outputs::Speaker::StepTarget &target);
+		static constexpr bool get_supplies_steps() { return true; }
+		void skip_samples(std::size_t number_of_samples);
 		bool is_zero_level() const;
+		bool is_constant_level(std::size_t number_of_samples, std::int16_t *level) const;
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return is_stereo; }
 
 	private:
 		Concurrency::DeferringAsyncTaskQueue &task_queue_;
+		Outputs::Speaker::RegisterLog::Input log_input_;
+		void apply_register_value(int selected_register, uint8_t value);
 
 		int selected_register_ = 0;
 		uint8_t registers_[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
@@ -151,12 +164,26 @@ template <bool is_stereo> class AY38910: public ::Outputs::Speaker::SampleSource
 		uint8_t data_input_, data_output_;
 
 		uint32_t output_volume_;
+		uint32_t reported_volume_ = 0;
+		void post_level(std::size_t offset, Outputs::Speaker::StepTarget &target);
 
 		void update_bus();
 		PortHandler *port_handler_ = nullptr;
 		void set_port_output(bool port_b);
 
 		void evaluate_output_volume();
+		void tick();
+		void advance_noise();
+
+		/// Identifies those parts of the generator that can currently affect output.
+		struct Audibility {
+			int tones = 0;
+			bool noise = false, envelope = false;
+		};
+		Audibility audibility() const;
+
+		/// Advances by @c number_of_samples, posting any change in output to @c target if it is non-null.
+		void advance(std::size_t number_of_samples, Outputs::Speaker::StepTarget *target);
 
 		// Output mixing control.
 		uint8_t a_left_ = 255, a_right_ = 255;
@@ -19,20 +19,46 @@ void Toggle::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 }
 
+void Toggle::get_steps(std::size_t, Outputs::Speaker::StepTarget &target) {
+	// Level changes are applied only between calls, so can be posted only at the start of a period.
+	if(level_ != reported_level_) {
+		target.add_step(0, level_ - reported_level_);
+		reported_level_ = level_;
+	}
+}
+
 void Toggle::set_sample_volume_range(std::int16_t range) {
 	volume_ = range;
 }
 
 void Toggle::skip_samples(std::size_t) {}
 
+bool Toggle::is_constant_level(std::size_t, std::int16_t *level) const {
+	// As per get_steps, the level can change only between calls.
+	*level = level_;
+	return true;
+}
+
 void Toggle::set_output(bool enabled) {
 	if(is_enabled_ == enabled) return;
 	is_enabled_ = enabled;
+	if(log_input_) {
+		log_input_.post(0, enabled);
+		return;
+	}
+
 	audio_queue_.defer([this, enabled] {
 		level_ = enabled ? volume_ : 0;
 	});
 }
 
+void Toggle::set_register_log(Outputs::Speaker::RegisterLog &log) {
+	log_input_ = log.add_input(this, [](void *toggle, uint16_t, uint8_t enabled) {
+		auto &self = *static_cast<Toggle *>(toggle);
+		self.level_ = enabled ? self.volume_ : 0;
+	});
+}
+
 bool Toggle::get_output() const {
 	return is_enabled_;
 }
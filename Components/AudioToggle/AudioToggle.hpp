@@ -9,6 +9,7 @@
 #ifndef AudioToggle_hpp
 #define AudioToggle_hpp
 
+#include "../../Outputs/Speaker/Implementation/RegisterLog.hpp"
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
 
@@ -22,19 +23,27 @@ class Toggle: public Outputs::Speaker::SampleSource {
 		Toggle(Concurrency::DeferringAsyncTaskQueue &audio_queue);
 
 		void get_samples(std::size_t number_of_samples, std::int16_t *target);
+		void get_steps(std::size_t number_of_samples, Outputs::Speaker::StepTarget &target);
+		static constexpr bool get_supplies_steps() { return true; }
 		void set_sample_volume_range(std::int16_t range);
 		void skip_samples(const std::size_t number_of_samples);
+		bool is_constant_level(std::size_t number_of_samples, std::int16_t *level) const;
 
 		void set_output(bool enabled);
 		bool get_output() const;
 
+		/// Directs all future output changes to @c log rather than to the queue supplied at construction.
+		void set_register_log(Outputs::Speaker::RegisterLog &log);
+
 	private:
 		// Accessed on the calling thread.
 		bool is_enabled_ = false;
 		Concurrency::DeferringAsyncTaskQueue &audio_queue_;
+		Outputs::Speaker::RegisterLog::Input log_input_;
 
 		// Accessed on the audio thread.
 		int16_t level_ = 0, volume_ = 0;
+		int16_t reported_level_ = 0;
 };
 
 }
@@ -8,6 +8,7 @@
 
 #include "KonamiSCC.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace Konami;
@@ -33,14 +34,7 @@ void SCC::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 
 	while(c < number_of_samples) {
-		for(int channel = 0; channel < 5; ++channel) {
-			if(channels_[channel].tone_counter) channels_[channel].tone_counter--;
-			else {
-				channels_[channel].offset = (channels_[channel].offset + 1) & 0x1f;
-				channels_[channel].tone_counter = channels_[channel].period;
-			}
-		}
-
+		tick();
 		evaluate_output_volume();
 
 		for(int ic = 0; ic < 8 && c < number_of_samples; ++ic) {
@@ -51,40 +45,108 @@ void SCC::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 }
 
+void SCC::get_steps(std::size_t number_of_samples, Outputs::Speaker::StepTarget &target) {
+	// Catch up on any change in level since the last call, e.g. due to a register write.
+	if(transient_output_level_ != reported_output_level_) {
+		target.add_step(0, transient_output_level_ - reported_output_level_);
+		reported_output_level_ = transient_output_level_;
+	}
+
+	// As per get_samples, nothing advances while all channels are disabled.
+	if(is_zero_level()) return;
+
+	// Ticks occur as per get_samples, whenever the master divider reaches a multiple of eight.
+	std::size_t offset = std::size_t(8 - (master_divider_&7)) & 7;
+	master_divider_ = int((std::size_t(master_divider_) + number_of_samples) & 7);
+
+	while(offset < number_of_samples) {
+		// Find the number of ticks that will pass before an enabled channel moves to a new sample.
+		int quiet = int((number_of_samples - offset + 7) >> 3);
+		for(int channel = 0; channel < 5; ++channel) {
+			if(channel_enable_ & (1 << channel)) quiet = std::min(quiet, channels_[channel].tone_counter);
+		}
+
+		// Skip those, if any.
+		if(quiet) {
+			for(int channel = 0; channel < 5; ++channel) {
+				channels_[channel].offset =
+					(channels_[channel].offset + Outputs::Speaker::advance_divider(channels_[channel].tone_counter, channels_[channel].period, quiet)) & 0x1f;
+			}
+
+			offset += std::size_t(quiet) << 3;
+			if(offset >= number_of_samples) break;
+		}
+
+		// Perform the next tick in full.
+		tick();
+		evaluate_output_volume();
+		if(transient_output_level_ != reported_output_level_) {
+			target.add_step(offset, transient_output_level_ - reported_output_level_);
+			reported_output_level_ = transient_output_level_;
+		}
+		offset += 8;
+	}
+}
+
+void SCC::tick() {
+	for(int channel = 0; channel < 5; ++channel) {
+		if(channels_[channel].tone_counter) channels_[channel].tone_counter--;
+		else {
+			channels_[channel].offset = (channels_[channel].offset + 1) & 0x1f;
+			channels_[channel].tone_counter = channels_[channel].period;
+		}
+	}
+}
+
 void SCC::write(uint16_t address, uint8_t value) {
 	address &= 0xff;
 	if(address < 0x80) ram_[address] = value;
 
+	if(log_input_) {
+		log_input_.post(address, value);
+		return;
+	}
+
 	task_queue_.defer([this, address, value] {
-		// Check for a write into waveform memory.
-		if(address < 0x80) {
-			waves_[address >> 5].samples[address & 0x1f] = value;
-		} else switch(address) {
-			default: break;
-
-			case 0x80: case 0x82: case 0x84: case 0x86: case 0x88: {
-				int channel = (address - 0x80) >> 1;
-				channels_[channel].period = (channels_[channel].period & ~0xff) | value;
-			} break;
-
-			case 0x81: case 0x83: case 0x85: case 0x87: case 0x89: {
-				int channel = (address - 0x80) >> 1;
-				channels_[channel].period = (channels_[channel].period & 0xff) | ((value & 0xf) << 8);
-			} break;
-
-			case 0x8a: case 0x8b: case 0x8c: case 0x8d: case 0x8e:
-				channels_[address - 0x8a].amplitude = value & 0xf;
-			break;
-
-			case 0x8f:
-				channel_enable_ = value;
-			break;
-		}
+		apply_write(address, value);
+	});
+}
 
-		evaluate_output_volume();
+void SCC::set_register_log(Outputs::Speaker::RegisterLog &log) {
+	log_input_ = log.add_input(this, [](void *scc, uint16_t address, uint8_t value) {
+		static_cast<SCC *>(scc)->apply_write(address, value);
 	});
 }
 
+void SCC::apply_write(uint16_t address, uint8_t value) {
+	// Check for a write into waveform memory.
+	if(address < 0x80) {
+		waves_[address >> 5].samples[address & 0x1f] = value;
+	} else switch(address) {
+		default: break;
+
+		case 0x80: case 0x82: case 0x84: case 0x86: case 0x88: {
+			int channel = (address - 0x80) >> 1;
+			channels_[channel].period = (channels_[channel].period & ~0xff) | value;
+		} break;
+
+		case 0x81: case 0x83: case 0x85: case 0x87: case 0x89: {
+			int channel = (address - 0x80) >> 1;
+			channels_[channel].period = (channels_[channel].period & 0xff) | ((value & 0xf) << 8);
+		} break;
+
+		case 0x8a: case 0x8b: case 0x8c: case 0x8d: case 0x8e:
+			channels_[address - 0x8a].amplitude = value & 0xf;
+		break;
+
+		case 0x8f:
+			channel_enable_ = value;
+		break;
+	}
+
+	evaluate_output_volume();
+}
+
 void SCC::evaluate_output_volume() {
 	transient_output_level_ =
 		int16_t(
@@ -9,6 +9,7 @@
 #ifndef KonamiSCC_hpp
 #define KonamiSCC_hpp
 
+#include "../../Outputs/Speaker/Implementation/RegisterLog.hpp"
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
 
@@ -31,6 +32,10 @@ class SCC: public ::Outputs::Speaker::SampleSource {
 
 		/// As per ::SampleSource; provides audio output.
 		void get_samples(std::size_t number_of_samples, std::int16_t *target);
+
+		/// As per ::SampleSource; provides audio output as a series of steps.
+		void get_steps(std::size_t number_of_samples, Outputs::Speaker::StepTarget &target);
+		static constexpr bool get_supplies_steps() { return true; }
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return false; }
 
@@ -40,13 +45,19 @@ class SCC: public ::Outputs::Speaker::SampleSource {
 		/// Reads from the SCC.
 		uint8_t read(uint16_t address);
 
+		/// Directs all future writes to @c log rather than to the queue supplied at construction.
+		void set_register_log(Outputs::Speaker::RegisterLog &log);
+
 	private:
 		Concurrency::DeferringAsyncTaskQueue &task_queue_;
+		Outputs::Speaker::RegisterLog::Input log_input_;
+		void apply_write(uint16_t address, uint8_t value);
 
 		// State from here on down is accessed ony from the audio thread.
 		int master_divider_ = 0;
 		std::int16_t master_volume_ = 0;
 		int16_t transient_output_level_ = 0;
+		int16_t reported_output_level_ = 0;
 
 		struct Channel {
 			int period = 0;
@@ -63,6 +74,7 @@ class SCC: public ::Outputs::Speaker::SampleSource {
 		std::uint8_t channel_enable_ = 0;
 
 		void evaluate_output_volume();
+		void tick();
 
 		// This keeps a copy of wave memory that is accessed from the
 		// main emulation thread.
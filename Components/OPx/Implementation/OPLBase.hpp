@@ -9,6 +9,7 @@
 #ifndef OPLBase_h
 #define OPLBase_h
 
+#include "../../../Outputs/Speaker/Implementation/RegisterLog.hpp"
 #include "../../../Outputs/Speaker/Implementation/SampleSource.hpp"
 #include "../../../Concurrency/AsyncTaskQueue.hpp"
 
@@ -25,15 +25,19 @@ template <int phase_precision> class WaveformGenerator {
 			@returns The output of waveform @c form at [integral] phase @c phase.
 		*/
 		static constexpr LogSign wave(Waveform form, int phase) {
-			constexpr int waveforms[4][4] = {
-				{1023, 1023, 1023, 1023},	// Sine: don't mask in any quadrant.
-				{511, 511, 0, 0},			// Half sine: keep the first half intact, lock to 0 in the second half.
-				{511, 511, 511, 511},		// AbsSine: endlessly repeat the first half of the sine wave.
-				{255, 0, 255, 0},			// PulseSine: act as if the first quadrant is in the first and third; lock the other two to 0.
-			};
-			return negative_log_sin(phase & waveforms[int(form)][(phase >> 8) & 3]);
+			return negative_log_sin(phase & masks[int(form)][(phase >> 8) & 3]);
 		}
 
+		/*!
+			The masks applied to phase by each waveform, indexed by waveform and then by quadrant.
+		*/
+		static constexpr int masks[4][4] = {
+			{1023, 1023, 1023, 1023},	// Sine: don't mask in any quadrant.
+			{511, 511, 0, 0},			// Half sine: keep the first half intact, lock to 0 in the second half.
+			{511, 511, 511, 511},		// AbsSine: endlessly repeat the first half of the sine wave.
+			{255, 0, 255, 0},			// PulseSine: act as if the first quadrant is in the first and third; lock the other two to 0.
+		};
+
 		/*!
 			@returns The output of waveform @c form at [scaled] phase @c scaled_phase given the modulation input @c modulation.
 		*/
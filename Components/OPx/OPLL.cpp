@@ -8,6 +8,8 @@
 
 #include "OPLL.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 
 using namespace Yamaha::OPL;
@@ -24,13 +26,13 @@ OPLL::OPLL(Concurrency::DeferringAsyncTaskQueue &task_queue, int audio_divider,
 	rhythm_envelope_generators_[BassCarrier].set_should_damp([this] {
 		// Propagate attack mode to the modulator, and reset both phases.
 		rhythm_envelope_generators_[BassModulator].set_key_on(true);
-		phase_generators_[6 + 0].reset();
-		phase_generators_[6 + 9].reset();
+		phase_generators_.reset(6 + 0);
+		phase_generators_.reset(6 + 9);
 	});
 
 	// Set the other drums to damp, but only the TomTom to affect phase.
 	rhythm_envelope_generators_[TomTom].set_should_damp([this] {
-		phase_generators_[8 + 9].reset();
+		phase_generators_.reset(8 + 9);
 	});
 	rhythm_envelope_generators_[Snare].set_should_damp({});
 	rhythm_envelope_generators_[Cymbal].set_should_damp({});
@@ -58,8 +60,8 @@ OPLL::OPLL(Concurrency::DeferringAsyncTaskQueue &task_queue, int audio_divider,
 		envelope_generators_[c].set_should_damp([this, c] {
 			// Propagate attack mode to the modulator, and reset both phases.
 			envelope_generators_[c + 9].set_key_on(true);
-			phase_generators_[c + 0].reset();
-			phase_generators_[c + 9].reset();
+			phase_generators_.reset(c + 0);
+			phase_generators_.reset(c + 9);
 		});
 	}
 
@@ -73,108 +75,123 @@ OPLL::OPLL(Concurrency::DeferringAsyncTaskQueue &task_queue, int audio_divider,
 
 void OPLL::write_register(uint8_t address, uint8_t value) {
 	// The OPLL doesn't have timers or other non-audio functions, so all writes
-	// go to the audio queue.
+	// go to the audio queue, or to the register log if there is one.
+	if(log_input_) {
+		log_input_.post(address, value);
+		return;
+	}
+
 	task_queue_.defer([this, address, value] {
-		// The first 8 locations are used to define the custom instrument, and have
-		// exactly the same format as the patch set arrays at the head of this file.
-		if(address < 8) {
-			custom_instrument_[address] = value;
-
-			// Update all channels that refer to instrument 0.
-			for(int c = 0; c < 9; ++c) {
-				if(!channels_[c].instrument) {
-					install_instrument(c);
-				}
+		apply_register(address, value);
+	});
+}
+
+void OPLL::set_register_log(Outputs::Speaker::RegisterLog &log) {
+	log_input_ = log.add_input(this, [](void *opll, uint16_t address, uint8_t value) {
+		static_cast<OPLL *>(opll)->apply_register(uint8_t(address), value);
+	});
+}
+
+void OPLL::apply_register(uint8_t address, uint8_t value) {
+	// The first 8 locations are used to define the custom instrument, and have
+	// exactly the same format as the patch set arrays at the head of this file.
+	if(address < 8) {
+		custom_instrument_[address] = value;
+
+		// Update all channels that refer to instrument 0.
+		for(int c = 0; c < 9; ++c) {
+			if(!channels_[c].instrument) {
+				install_instrument(c);
 			}
+		}
+
+		return;
+	}
 
-			return;
+	// Register 0xe enables or disables rhythm mode and contains the
+	// percussion key-on bits.
+	if(address == 0xe) {
+		const bool old_rhythm_mode = rhythm_mode_enabled_;
+		rhythm_mode_enabled_ = value & 0x20;
+		if(old_rhythm_mode != rhythm_mode_enabled_) {
+			// Change the instlled instruments for channels 6, 7 and 8
+			// if this was a transition into or out of rhythm mode.
+			install_instrument(6);
+			install_instrument(7);
+			install_instrument(8);
 		}
+		rhythm_envelope_generators_[HighHat].set_key_on(value & 0x01);
+		rhythm_envelope_generators_[Cymbal].set_key_on(value & 0x02);
+		rhythm_envelope_generators_[TomTom].set_key_on(value & 0x04);
+		rhythm_envelope_generators_[Snare].set_key_on(value & 0x08);
+		if(value & 0x10) {
+			rhythm_envelope_generators_[BassCarrier].set_key_on(true);
+		} else {
+			rhythm_envelope_generators_[BassCarrier].set_key_on(false);
+			rhythm_envelope_generators_[BassModulator].set_key_on(false);
 
-		// Register 0xe enables or disables rhythm mode and contains the
-		// percussion key-on bits.
-		if(address == 0xe) {
-			const bool old_rhythm_mode = rhythm_mode_enabled_;
-			rhythm_mode_enabled_ = value & 0x20;
-			if(old_rhythm_mode != rhythm_mode_enabled_) {
-				// Change the instlled instruments for channels 6, 7 and 8
-				// if this was a transition into or out of rhythm mode.
-				install_instrument(6);
-				install_instrument(7);
-				install_instrument(8);
-			}
-			rhythm_envelope_generators_[HighHat].set_key_on(value & 0x01);
-			rhythm_envelope_generators_[Cymbal].set_key_on(value & 0x02);
-			rhythm_envelope_generators_[TomTom].set_key_on(value & 0x04);
-			rhythm_envelope_generators_[Snare].set_key_on(value & 0x08);
+		}
+		return;
+	}
+
+	// That leaves only per-channel selections, for which the addressing
+	// is completely orthogonal; check that a valid channel is being requested.
+	const auto index = address & 0xf;
+	if(index > 8) return;
+
+	switch(address & 0xf0) {
+		default: break;
+
+		// Address 1x sets the low 8 bits of the period for channel x.
+		case 0x10:
+			channels_[index].period = (channels_[index].period & ~0xff) | value;
+			set_channel_period(index);
+		return;
+
+		// Address 2x Sets the octave and a single bit of the frequency, as well
+		// as setting key on and sustain mode.
+		case 0x20:
+			channels_[index].period = (channels_[index].period & 0xff) | ((value & 1) << 8);
+			channels_[index].octave = (value >> 1) & 7;
+			set_channel_period(index);
+
+			// In this implementation the first 9 envelope generators are for
+			// channel carriers, and their will_attack callback is used to trigger
+			// key-on for modulators. But key-off needs to be set to both envelope
+			// generators now.
 			if(value & 0x10) {
-				rhythm_envelope_generators_[BassCarrier].set_key_on(true);
+				envelope_generators_[index].set_key_on(true);
 			} else {
-				rhythm_envelope_generators_[BassCarrier].set_key_on(false);
-				rhythm_envelope_generators_[BassModulator].set_key_on(false);
-
+				envelope_generators_[index + 0].set_key_on(false);
+				envelope_generators_[index + 9].set_key_on(false);
 			}
-			return;
-		}
 
-		// That leaves only per-channel selections, for which the addressing
-		// is completely orthogonal; check that a valid channel is being requested.
-		const auto index = address & 0xf;
-		if(index > 8) return;
-
-		switch(address & 0xf0) {
-			default: break;
-
-			// Address 1x sets the low 8 bits of the period for channel x.
-			case 0x10:
-				channels_[index].period = (channels_[index].period & ~0xff) | value;
-				set_channel_period(index);
-			return;
-
-			// Address 2x Sets the octave and a single bit of the frequency, as well
-			// as setting key on and sustain mode.
-			case 0x20:
-				channels_[index].period = (channels_[index].period & 0xff) | ((value & 1) << 8);
-				channels_[index].octave = (value >> 1) & 7;
-				set_channel_period(index);
-
-				// In this implementation the first 9 envelope generators are for
-				// channel carriers, and their will_attack callback is used to trigger
-				// key-on for modulators. But key-off needs to be set to both envelope
-				// generators now.
-				if(value & 0x10) {
-					envelope_generators_[index].set_key_on(true);
-				} else {
-					envelope_generators_[index + 0].set_key_on(false);
-					envelope_generators_[index + 9].set_key_on(false);
+			// Set sustain bit to both the relevant operators.
+			channels_[index].use_sustain = value & 0x20;
+			set_use_sustain(index);
+		return;
+
+		// Address 3x selects the instrument and attenuation for a channel;
+		// in rhythm mode some of the nibbles that ordinarily identify instruments
+		// instead nominate additional attenuations. This code reads those back
+		// from the stored instrument values.
+		case 0x30:
+			channels_[index].attenuation = value & 0xf;
+
+			// Install an instrument only if it's new.
+			if(channels_[index].instrument != value >> 4) {
+				channels_[index].instrument = value >> 4;
+				if(index < 6 || !rhythm_mode_enabled_) {
+					install_instrument(index);
 				}
-
-				// Set sustain bit to both the relevant operators.
-				channels_[index].use_sustain = value & 0x20;
-				set_use_sustain(index);
-			return;
-
-			// Address 3x selects the instrument and attenuation for a channel;
-			// in rhythm mode some of the nibbles that ordinarily identify instruments
-			// instead nominate additional attenuations. This code reads those back
-			// from the stored instrument values.
-			case 0x30:
-				channels_[index].attenuation = value & 0xf;
-
-				// Install an instrument only if it's new.
-				if(channels_[index].instrument != value >> 4) {
-					channels_[index].instrument = value >> 4;
-					if(index < 6 || !rhythm_mode_enabled_) {
-						install_instrument(index);
-					}
-				}
-			return;
-		}
-	});
+			}
+		return;
+	}
 }
 
 void OPLL::set_channel_period(int channel) {
-	phase_generators_[channel + 0].set_period(channels_[channel].period, channels_[channel].octave);
-	phase_generators_[channel + 9].set_period(channels_[channel].period, channels_[channel].octave);
+	phase_generators_.set_period(channel + 0, channels_[channel].period, channels_[channel].octave);
+	phase_generators_.set_period(channel + 9, channels_[channel].period, channels_[channel].octave);
 
 	envelope_generators_[channel + 0].set_period(channels_[channel].period, channels_[channel].octave);
 	envelope_generators_[channel + 9].set_period(channels_[channel].period, channels_[channel].octave);
@@ -199,11 +216,9 @@ const uint8_t *OPLL::instrument_definition(int instrument, int channel) {
 
 void OPLL::install_instrument(int channel) {
 	auto &carrier_envelope = envelope_generators_[channel + 0];
-	auto &carrier_phase = phase_generators_[channel + 0];
 	auto &carrier_scaler = key_level_scalers_[channel + 0];
 
 	auto &modulator_envelope = envelope_generators_[channel + 9];
-	auto &modulator_phase = phase_generators_[channel + 9];
 	auto &modulator_scaler = key_level_scalers_[channel + 9];
 
 	const uint8_t *const instrument = instrument_definition(channels_[channel].instrument, channel);
@@ -215,14 +230,14 @@ void OPLL::install_instrument(int channel) {
 	//	b5:		sustain-level enable;
 	//	b6:		vibrato enable;
 	//	b7:		tremolo enable.
-	modulator_phase.set_multiple(instrument[0] & 0xf);
+	phase_generators_.set_multiple(channel + 9, instrument[0] & 0xf);
 	channels_[channel].modulator_key_rate_scale_multiplier = (instrument[0] >> 4) & 1;
-	modulator_phase.set_vibrato_enabled(instrument[0] & 0x40);
+	phase_generators_.set_vibrato_enabled(channel + 9, instrument[0] & 0x40);
 	modulator_envelope.set_tremolo_enabled(instrument[0] & 0x80);
 
-	carrier_phase.set_multiple(instrument[1] & 0xf);
+	phase_generators_.set_multiple(channel + 0, instrument[1] & 0xf);
 	channels_[channel].carrier_key_rate_scale_multiplier = (instrument[1] >> 4) & 1;
-	carrier_phase.set_vibrato_enabled(instrument[1] & 0x40);
+	phase_generators_.set_vibrato_enabled(channel + 0, instrument[1] & 0x40);
 	carrier_envelope.set_tremolo_enabled(instrument[1] & 0x80);
 
 	// Pass off bit 5.
@@ -242,9 +257,9 @@ void OPLL::install_instrument(int channel) {
 	//	b4:		carrier waveform selection;
 	//	b5:		[unused]
 	//	b6–b7:	carrier key-scale level.
-	channels_[channel].modulator_feedback = instrument[3] & 7;
-	channels_[channel].modulator_waveform = Waveform((instrument[3] >> 3) & 1);
-	channels_[channel].carrier_waveform = Waveform((instrument[3] >> 4) & 1);
+	melodic_.modulator_feedback[channel] = instrument[3] & 7;
+	melodic_.modulator_waveform[channel] = int(Waveform((instrument[3] >> 3) & 1));
+	melodic_.carrier_waveform[channel] = int(Waveform((instrument[3] >> 4) & 1));
 	carrier_scaler.set_key_scaling_level(instrument[3] >> 6);
 
 	// Bytes 4 (modulator) and 5 (carrier):
@@ -278,6 +293,113 @@ void OPLL::set_sample_volume_range(std::int16_t range) {
 	total_volume_ = range;
 }
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define OPLL_USE_AVX2
+#endif
+
+#ifdef OPLL_USE_AVX2
+
+namespace {
+
+/*
+	Operator state is held as structure-of-arrays so that phase generators and melodic channels can be
+	processed eight at a time; table lookups become gathers. Each of the following is bit-for-bit
+	equivalent to the scalar code that it mirrors.
+*/
+
+/// The log-sin and exponential tables, widened to 32 bits for use with gathers.
+template <std::size_t size> constexpr std::array<int, size> widen(const int16_t (&table)[size]) {
+	std::array<int, size> result{};
+	for(std::size_t c = 0; c < size; c++) {
+		result[c] = table[c];
+	}
+	return result;
+}
+constexpr auto log_sin_32 = widen(log_sin);
+constexpr auto mapped_exp_32 = widen(mapped_exp);
+
+bool has_avx2() {
+	static const bool has_avx2 = __builtin_cpu_supports("avx2");
+	return has_avx2;
+}
+
+/// Updates all of @c generators; they are written to be vectorised by the compiler, so this just allows AVX2 to be used.
+template <typename PhaseGenerators> __attribute__((target("avx2"))) void update(PhaseGenerators &generators, const LowFrequencyOscillator &oscillator) {
+	generators.update(oscillator);
+}
+
+/// Performs an aligned load of eight values from @c source.
+__attribute__((target("avx2"))) inline __m256i load(const int *source) {
+	return _mm256_load_si256(reinterpret_cast<const __m256i *>(source));
+}
+
+/// As per LogSign::level, for eight lanes of logs and signs.
+template <int fractional> __attribute__((target("avx2"))) inline __m256i level(__m256i log, __m256i sign) {
+	const __m256i exp = _mm256_i32gather_epi32(mapped_exp_32.data(), _mm256_and_si256(log, _mm256_set1_epi32(0xff)), 4);
+
+	// A variable shift produces 0 for a shift of 32 or more, as does power_two.
+	const __m256i shifted = _mm256_srlv_epi32(_mm256_slli_epi32(exp, fractional), _mm256_srai_epi32(log, 8));
+	return _mm256_sign_epi32(shifted, sign);
+}
+
+/// As per WaveformGenerator::wave, for eight lanes of waveforms and phases.
+template <int precision> __attribute__((target("avx2"))) inline void wave(__m256i form, __m256i phase, __m256i &log, __m256i &sign) {
+	const __m256i quadrant = _mm256_and_si256(_mm256_srai_epi32(phase, 8), _mm256_set1_epi32(3));
+	const __m256i mask = _mm256_i32gather_epi32(&WaveformGenerator<precision>::masks[0][0], _mm256_add_epi32(_mm256_slli_epi32(form, 2), quadrant), 4);
+	const __m256i angle = _mm256_and_si256(phase, mask);
+
+	// As per negative_log_sin: mirror the second half of each half-cycle, and negate the second half-cycle.
+	const __m256i mirror = _mm256_and_si256(
+		_mm256_sub_epi32(_mm256_setzero_si256(), _mm256_and_si256(_mm256_srli_epi32(angle, 8), _mm256_set1_epi32(1))),
+		_mm256_set1_epi32(255));
+	log = _mm256_i32gather_epi32(log_sin_32.data(), _mm256_xor_si256(_mm256_and_si256(angle, _mm256_set1_epi32(255)), mirror), 4);
+	sign = _mm256_sub_epi32(_mm256_set1_epi32(1), _mm256_and_si256(_mm256_srli_epi32(angle, 8), _mm256_set1_epi32(2)));
+}
+
+/*!
+	Generates output for melodic channels 0–7 as per OPLL::melodic_output, for the first @c active of them; it is templated
+	on the type of @c channels only because that type is private to the OPLL. @c phases should be the 18 phases of the
+	OPLL's phase generators.
+*/
+template <int precision, typename MelodicChannels> __attribute__((target("avx2")))
+void melodic_output(int *phases, MelodicChannels &channels, int active, int *levels) {
+	const __m256i is_active = _mm256_cmpgt_epi32(_mm256_set1_epi32(active), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+	// The carrier is modulated by the modulator's previous output.
+	const __m256i previous_log = load(channels.modulator_log);
+	const __m256i previous_sign = load(channels.modulator_sign);
+	const __m256i previous_level = level<precision>(previous_log, previous_sign);
+
+	const __m256i carrier_phase = _mm256_srai_epi32(_mm256_add_epi32(_mm256_srai_epi32(load(phases), 1), previous_level), precision);
+	__m256i carrier_log, carrier_sign;
+	wave<precision>(load(channels.carrier_waveform), carrier_phase, carrier_log, carrier_sign);
+	carrier_log = _mm256_add_epi32(carrier_log, load(channels.carrier_attenuation));
+	_mm256_storeu_si256(reinterpret_cast<__m256i *>(levels), level<0>(carrier_log, carrier_sign));
+
+	// Get the modulator's new value.
+	__m256i *const modulator_phases = reinterpret_cast<__m256i *>(phases + 9);
+	const __m256i modulator_phase = _mm256_loadu_si256(modulator_phases);
+	__m256i modulator_log, modulator_sign;
+	wave<precision>(load(channels.modulator_waveform), _mm256_srai_epi32(modulator_phase, precision + 1), modulator_log, modulator_sign);
+	modulator_log = _mm256_add_epi32(modulator_log, load(channels.modulator_attenuation));
+
+	// Apply feedback, if any, and retain the modulator's output.
+	const __m256i feedback = load(channels.modulator_feedback);
+	__m256i delta = _mm256_srav_epi32(
+		_mm256_add_epi32(level<precision>(modulator_log, modulator_sign), previous_level),
+		_mm256_sub_epi32(_mm256_set1_epi32(8), feedback));
+	delta = _mm256_and_si256(delta, _mm256_and_si256(is_active, _mm256_cmpgt_epi32(feedback, _mm256_setzero_si256())));
+	_mm256_storeu_si256(modulator_phases, _mm256_add_epi32(modulator_phase, delta));
+
+	_mm256_store_si256(reinterpret_cast<__m256i *>(channels.modulator_log), _mm256_blendv_epi8(previous_log, modulator_log, is_active));
+	_mm256_store_si256(reinterpret_cast<__m256i *>(channels.modulator_sign), _mm256_blendv_epi8(previous_sign, modulator_sign, is_active));
+}
+
+}
+
+#endif
+
 void OPLL::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	// Both the OPLL and the OPL2 divide the input clock by 72 to get the base tick frequency;
 	// unlike the OPL2 the OPLL time-divides the output for 'mixing'.
@@ -285,13 +407,79 @@ void OPLL::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	const int update_period = 72 / audio_divider_;
 	const int channel_output_period = 4 / audio_divider_;
 
-	// TODO: the conditional below is terrible. Fix.
-	while(number_of_samples--) {
+	while(number_of_samples) {
 		if(!audio_offset_) update_all_channels();
 
-		*target = output_levels_[audio_offset_ / channel_output_period];
-		++target;
-		audio_offset_ = (audio_offset_ + 1) % update_period;
+		// Output the current slot's level for as long as it remains current.
+		const int slot = audio_offset_ / channel_output_period;
+		const int length = std::min(int(number_of_samples), (slot + 1) * channel_output_period - audio_offset_);
+		std::fill_n(target, length, output_levels_[slot]);
+
+		target += length;
+		number_of_samples -= std::size_t(length);
+		audio_offset_ += length;
+		if(audio_offset_ == update_period) audio_offset_ = 0;
+	}
+}
+
+void OPLL::skip_samples(std::size_t number_of_samples) {
+	const int update_period = 72 / audio_divider_;
+	if(!number_of_samples) return;
+
+	// Determine how many updates get_samples would have performed: one upon every sample
+	// at which audio_offset_ is zero.
+	const std::size_t until_update = std::size_t(audio_offset_ ? update_period - audio_offset_ : 0);
+	std::size_t updates = number_of_samples > until_update ? (number_of_samples - until_update - 1) / std::size_t(update_period) + 1 : 0;
+	audio_offset_ = int((std::size_t(audio_offset_) + number_of_samples) % std::size_t(update_period));
+
+	// If the skip ends mid-period then the final update's output levels will be needed, so
+	// perform that one in full.
+	const bool needs_output = updates && audio_offset_;
+	if(needs_output) --updates;
+
+	while(updates--) {
+		advance_all_channels();
+	}
+	if(needs_output) {
+		update_all_channels();
+	}
+}
+
+void OPLL::advance_all_channels() {
+	// As per update_all_channels, but omitting everything that contributes only to output.
+	oscillator_.update();
+
+#ifdef OPLL_USE_AVX2
+	if(has_avx2()) {
+		::update(phase_generators_, oscillator_);
+	} else {
+		phase_generators_.update(oscillator_);
+	}
+#else
+	phase_generators_.update(oscillator_);
+#endif
+
+	for(int c = 0; c < 6; ++c) {
+		envelope_generators_[c + 0].update(oscillator_);
+		envelope_generators_[c + 9].update(oscillator_);
+	}
+
+	if(rhythm_mode_enabled_) {
+		for(int c = 0; c < 6; ++c) {
+			rhythm_envelope_generators_[c].update(oscillator_);
+		}
+		advance_modulators(6);
+
+		// One LFSR step per rhythm slot.
+		for(int c = 0; c < 6; ++c) {
+			oscillator_.update_lfsr();
+		}
+	} else {
+		for(int c = 6; c < 9; ++c) {
+			envelope_generators_[c + 0].update(oscillator_);
+			envelope_generators_[c + 9].update(oscillator_);
+		}
+		advance_modulators(9);
 	}
 }
 
@@ -299,9 +487,15 @@ void OPLL::update_all_channels() {
 	oscillator_.update();
 
 	// Update all phase generators. That's guaranteed.
-	for(int c = 0; c < 18; ++c) {
-		phase_generators_[c].update(oscillator_);
+#ifdef OPLL_USE_AVX2
+	if(has_avx2()) {
+		::update(phase_generators_, oscillator_);
+	} else {
+		phase_generators_.update(oscillator_);
 	}
+#else
+	phase_generators_.update(oscillator_);
+#endif
 
 	// Update the ADSR envelopes that are guaranteed to be melodic.
 	for(int c = 0; c < 6; ++c) {
@@ -311,6 +505,7 @@ void OPLL::update_all_channels() {
 
 #define VOLUME(x)	int16_t(((x) * total_volume_) >> 12)
 
+	int melodic_levels[9];
 	if(rhythm_mode_enabled_) {
 		// Advance the rhythm envelope generators.
 		for(int c = 0; c < 6; ++c) {
@@ -318,13 +513,14 @@ void OPLL::update_all_channels() {
 		}
 
 		// Fill in the melodic channels.
-		output_levels_[3] = VOLUME(melodic_output(0));
-		output_levels_[4] = VOLUME(melodic_output(1));
-		output_levels_[5] = VOLUME(melodic_output(2));
+		melodic_output(6, melodic_levels);
+		output_levels_[3] = VOLUME(melodic_levels[0]);
+		output_levels_[4] = VOLUME(melodic_levels[1]);
+		output_levels_[5] = VOLUME(melodic_levels[2]);
 
-		output_levels_[9] = VOLUME(melodic_output(3));
-		output_levels_[10] = VOLUME(melodic_output(4));
-		output_levels_[11] = VOLUME(melodic_output(5));
+		output_levels_[9] = VOLUME(melodic_levels[3]);
+		output_levels_[10] = VOLUME(melodic_levels[4]);
+		output_levels_[11] = VOLUME(melodic_levels[5]);
 
 		// Bass drum, which is a regular FM effect.
 		output_levels_[2] = output_levels_[15] = VOLUME(bass_drum());
@@ -360,17 +556,18 @@ void OPLL::update_all_channels() {
 		output_levels_[6] = output_levels_[7] = output_levels_[8] =
 		output_levels_[12] = output_levels_[13] = output_levels_[14] = 0;
 
-		output_levels_[3] = VOLUME(melodic_output(0));
-		output_levels_[4] = VOLUME(melodic_output(1));
-		output_levels_[5] = VOLUME(melodic_output(2));
+		melodic_output(9, melodic_levels);
+		output_levels_[3] = VOLUME(melodic_levels[0]);
+		output_levels_[4] = VOLUME(melodic_levels[1]);
+		output_levels_[5] = VOLUME(melodic_levels[2]);
 
-		output_levels_[9] = VOLUME(melodic_output(3));
-		output_levels_[10] = VOLUME(melodic_output(4));
-		output_levels_[11] = VOLUME(melodic_output(5));
+		output_levels_[9] = VOLUME(melodic_levels[3]);
+		output_levels_[10] = VOLUME(melodic_levels[4]);
+		output_levels_[11] = VOLUME(melodic_levels[5]);
 
-		output_levels_[15] = VOLUME(melodic_output(6));
-		output_levels_[16] = VOLUME(melodic_output(7));
-		output_levels_[17] = VOLUME(melodic_output(8));
+		output_levels_[15] = VOLUME(melodic_levels[6]);
+		output_levels_[16] = VOLUME(melodic_levels[7]);
+		output_levels_[17] = VOLUME(melodic_levels[8]);
 	}
 
 #undef VOLUME
@@ -382,35 +579,78 @@ void OPLL::update_all_channels() {
 
 #define ATTENUATION(x)	((x) << 7)
 
+// MARK: - Melodic channels.
+
+void OPLL::melodic_output(int channels, int *levels) {
+	// Establish total attenuations.
+	for(int c = 0; c < channels; ++c) {
+		melodic_.carrier_attenuation[c] =
+			envelope_generators_[c].attenuation() + ATTENUATION(channels_[c].attenuation) + key_level_scalers_[c].attenuation();
+		melodic_.modulator_attenuation[c] =
+			envelope_generators_[c + 9].attenuation() + (channels_[c].modulator_attenuation << 5) + key_level_scalers_[c + 9].attenuation();
+	}
+
+	int c = 0;
+#ifdef OPLL_USE_AVX2
+	if(has_avx2()) {
+		::melodic_output<period_precision>(phase_generators_.phases(), melodic_, std::min(channels, 8), levels);
+		c = 8;
+	}
+#endif
+	for(; c < channels; ++c) {
+		levels[c] = melodic_output(c);
+	}
+}
+
+void OPLL::advance_modulators(int channels) {
+	// Modulators retain their most recent output and may feed it back into their own phase,
+	// so they advance even when no output is required; carriers have no such state.
+	for(int c = 0; c < channels; ++c) {
+		const LogSign modulator_output{melodic_.modulator_log[c], melodic_.modulator_sign[c]};
+
+		auto modulation = WaveformGenerator<period_precision>::wave(Waveform(melodic_.modulator_waveform[c]), phase_generators_.phase(c + 9));
+		modulation += envelope_generators_[c + 9].attenuation() + (channels_[c].modulator_attenuation << 5) + key_level_scalers_[c + 9].attenuation();
+
+		phase_generators_.apply_feedback(c + 9, modulator_output, modulation, melodic_.modulator_feedback[c]);
+		melodic_.modulator_log[c] = modulation.log;
+		melodic_.modulator_sign[c] = modulation.sign;
+	}
+}
+
 int OPLL::melodic_output(int channel) {
+	const LogSign modulator_output{melodic_.modulator_log[channel], melodic_.modulator_sign[channel]};
+
 	// The modulator always updates after the carrier, oddly enough. So calculate actual output first, based on the modulator's last value.
-	auto carrier = WaveformGenerator<period_precision>::wave(channels_[channel].carrier_waveform, phase_generators_[channel].scaled_phase(), channels_[channel].modulator_output);
-	carrier += envelope_generators_[channel].attenuation() + ATTENUATION(channels_[channel].attenuation) + key_level_scalers_[channel].attenuation();
+	auto carrier = WaveformGenerator<period_precision>::wave(Waveform(melodic_.carrier_waveform[channel]), phase_generators_.scaled_phase(channel), modulator_output);
+	carrier += melodic_.carrier_attenuation[channel];
 
 	// Get the modulator's new value.
-	auto modulation = WaveformGenerator<period_precision>::wave(channels_[channel].modulator_waveform, phase_generators_[channel + 9].phase());
-	modulation += envelope_generators_[channel + 9].attenuation() + (channels_[channel].modulator_attenuation << 5) + key_level_scalers_[channel + 9].attenuation();
+	auto modulation = WaveformGenerator<period_precision>::wave(Waveform(melodic_.modulator_waveform[channel]), phase_generators_.phase(channel + 9));
+	modulation += melodic_.modulator_attenuation[channel];
 
 	// Apply feedback, if any.
-	phase_generators_[channel + 9].apply_feedback(channels_[channel].modulator_output, modulation, channels_[channel].modulator_feedback);
-	channels_[channel].modulator_output = modulation;
+	phase_generators_.apply_feedback(channel + 9, modulator_output, modulation, melodic_.modulator_feedback[channel]);
+	melodic_.modulator_log[channel] = modulation.log;
+	melodic_.modulator_sign[channel] = modulation.sign;
 
 	return carrier.level();
 }
 
+// MARK: - Rhythm channels.
+
 int OPLL::bass_drum() {
 	// Use modulator 6 and carrier 6, attenuated as per the bass-specific envelope generators and the attenuation level for channel 6.
-	auto modulation = WaveformGenerator<period_precision>::wave(Waveform::Sine, phase_generators_[6 + 9].phase());
+	auto modulation = WaveformGenerator<period_precision>::wave(Waveform::Sine, phase_generators_.phase(6 + 9));
 	modulation += rhythm_envelope_generators_[RhythmIndices::BassModulator].attenuation();
 
-	auto carrier = WaveformGenerator<period_precision>::wave(Waveform::Sine, phase_generators_[6].scaled_phase(), modulation);
+	auto carrier = WaveformGenerator<period_precision>::wave(Waveform::Sine, phase_generators_.scaled_phase(6), modulation);
 	carrier += rhythm_envelope_generators_[RhythmIndices::BassCarrier].attenuation() + ATTENUATION(channels_[6].attenuation);
 	return carrier.level();
 }
 
 int OPLL::tom_tom() {
 	// Use modulator 8 and the 'instrument' selection for channel 8 as an attenuation.
-	auto tom_tom = WaveformGenerator<period_precision>::wave(Waveform::Sine, phase_generators_[8 + 9].phase());
+	auto tom_tom = WaveformGenerator<period_precision>::wave(Waveform::Sine, phase_generators_.phase(8 + 9));
 	tom_tom += rhythm_envelope_generators_[RhythmIndices::TomTom].attenuation();
 	tom_tom += ATTENUATION(channels_[8].instrument);
 	return tom_tom.level();
@@ -418,7 +658,7 @@ int OPLL::tom_tom() {
 
 int OPLL::snare_drum() {
 	// Use modulator 7 and the carrier attenuation level for channel 7.
-	LogSign snare = WaveformGenerator<period_precision>::snare(oscillator_, phase_generators_[7 + 9].phase());
+	LogSign snare = WaveformGenerator<period_precision>::snare(oscillator_, phase_generators_.phase(7 + 9));
 	snare += rhythm_envelope_generators_[RhythmIndices::Snare].attenuation();
 	snare += ATTENUATION(channels_[7].attenuation);
 	return snare.level();
@@ -426,7 +666,7 @@ int OPLL::snare_drum() {
 
 int OPLL::cymbal() {
 	// Use modulator 7, carrier 8 and the attenuation level for channel 8.
-	LogSign cymbal = WaveformGenerator<period_precision>::cymbal(phase_generators_[8].phase(), phase_generators_[7 + 9].phase());
+	LogSign cymbal = WaveformGenerator<period_precision>::cymbal(phase_generators_.phase(8), phase_generators_.phase(7 + 9));
 	cymbal += rhythm_envelope_generators_[RhythmIndices::Cymbal].attenuation();
 	cymbal += ATTENUATION(channels_[8].attenuation);
 	return cymbal.level();
@@ -434,7 +674,7 @@ int OPLL::cymbal() {
 
 int OPLL::high_hat() {
 	// Use modulator 7, carrier 8 a and the 'instrument' selection for channel 7 as an attenuation.
-	LogSign high_hat = WaveformGenerator<period_precision>::high_hat(oscillator_, phase_generators_[8].phase(), phase_generators_[7 + 9].phase());
+	LogSign high_hat = WaveformGenerator<period_precision>::high_hat(oscillator_, phase_generators_.phase(8), phase_generators_.phase(7 + 9));
 	high_hat += rhythm_envelope_generators_[RhythmIndices::HighHat].attenuation();
 	high_hat += ATTENUATION(channels_[7].instrument);
 	return high_hat.level();
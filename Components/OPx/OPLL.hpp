@@ -30,6 +30,13 @@ class OPLL: public OPLBase<OPLL> {
 		void get_samples(std::size_t number_of_samples, std::int16_t *target);
 		void set_sample_volume_range(std::int16_t range);
 
+		/// As per ::SampleSource; advances envelopes, phases and the noise source exactly as get_samples
+		/// would, but generates output only as required to resume mid-period.
+		void skip_samples(std::size_t number_of_samples);
+
+		// A muted OPLL — e.g. the Master System's, when not in use — can simply be skipped.
+		bool is_zero_level() const { return !total_volume_; }
+
 		// The OPLL is generally 'half' as loud as it's told to be. This won't strictly be true in
 		// rhythm mode, but it's correct for melodic output.
 		double get_average_output_peak() const { return 0.5; }
@@ -37,18 +44,26 @@ class OPLL: public OPLBase<OPLL> {
 		/// Reads from the OPL.
 		uint8_t read(uint16_t address);
 
+		/// Directs all future writes to @c log rather than to the queue supplied at construction.
+		void set_register_log(Outputs::Speaker::RegisterLog &log);
+
 	private:
 		friend OPLBase<OPLL>;
 		void write_register(uint8_t address, uint8_t value);
+		void apply_register(uint8_t address, uint8_t value);
+		Outputs::Speaker::RegisterLog::Input log_input_;
 
 		int audio_divider_ = 0;
 		int audio_offset_ = 0;
-		std::atomic<int> total_volume_;
+		std::atomic<int> total_volume_{0};
 
 		int16_t output_levels_[18];
 		void update_all_channels();
+		void advance_all_channels();
 
 		int melodic_output(int channel);
+		void melodic_output(int channels, int *levels);
+		void advance_modulators(int channels);
 		int bass_drum();
 		int tom_tom();
 		int snare_drum();
@@ -65,7 +80,7 @@ class OPLL: public OPLBase<OPLL> {
 		//		[x], 0 <= x < 9		= carrier for channel x;
 		//		[x+9]				= modulator for channel x.
 		//
-		PhaseGenerator<period_precision> phase_generators_[18];
+		PhaseGenerators<period_precision, 18> phase_generators_;
 		EnvelopeGenerator<envelope_precision, period_precision> envelope_generators_[18];
 		KeyLevelScaler<period_precision> key_level_scalers_[18];
 
@@ -89,18 +104,29 @@ class OPLL: public OPLBase<OPLL> {
 			int attenuation = 0;
 			int modulator_attenuation = 0;
 
-			Waveform carrier_waveform = Waveform::Sine;
-			Waveform modulator_waveform = Waveform::Sine;
-
 			int carrier_key_rate_scale_multiplier = 0;
 			int modulator_key_rate_scale_multiplier = 0;
 
-			LogSign modulator_output;
-			int modulator_feedback = 0;
-
 			bool use_sustain = false;
 		} channels_[9];
 
+		// Per-channel state for melodic output, as structure-of-arrays so that several
+		// channels can be generated at once.
+		struct MelodicChannels {
+			// Total attenuations, including envelope and key-level scaling; these are refreshed
+			// upon every update.
+			alignas(32) int carrier_attenuation[9]{};
+			alignas(32) int modulator_attenuation[9]{};
+
+			alignas(32) int carrier_waveform[9]{};
+			alignas(32) int modulator_waveform[9]{};
+			alignas(32) int modulator_feedback[9]{};
+
+			// The most recent modulator output, as a LogSign.
+			alignas(32) int modulator_log[9]{};
+			alignas(32) int modulator_sign[9]{};
+		} melodic_;
+
 		// The low-frequency oscillator.
 		LowFrequencyOscillator oscillator_;
 		bool rhythm_mode_enabled_ = false;
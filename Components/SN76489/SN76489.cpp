@@ -8,6 +8,7 @@
 
 #include "SN76489.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -49,41 +50,56 @@ void SN76489::set_sample_volume_range(std::int16_t range) {
 }
 
 void SN76489::write(uint8_t value) {
+	if(log_input_) {
+		log_input_.post(0, value);
+		return;
+	}
+
 	task_queue_.defer([value, this] () {
-		if(value & 0x80) {
-			active_register_ = value;
-		}
+		apply_write(value);
+	});
+}
 
-		const int channel = (active_register_ >> 5)&3;
-		if(active_register_ & 0x10) {
-			// latch for volume
-			channels_[channel].volume = value & 0xf;
-			evaluate_output_volume();
+void SN76489::set_register_log(Outputs::Speaker::RegisterLog &log) {
+	log_input_ = log.add_input(this, [](void *sn76489, uint16_t, uint8_t value) {
+		static_cast<SN76489 *>(sn76489)->apply_write(value);
+	});
+}
+
+void SN76489::apply_write(uint8_t value) {
+	if(value & 0x80) {
+		active_register_ = value;
+	}
+
+	const int channel = (active_register_ >> 5)&3;
+	if(active_register_ & 0x10) {
+		// latch for volume
+		channels_[channel].volume = value & 0xf;
+		evaluate_output_volume();
+	} else {
+		// latch for tone/data
+		if(channel < 3) {
+			if(value & 0x80) {
+				channels_[channel].divider = (channels_[channel].divider & ~0xf) | (value & 0xf);
+			} else {
+				channels_[channel].divider = uint16_t((channels_[channel].divider & 0xf) | ((value & 0x3f) << 4));
+			}
 		} else {
-			// latch for tone/data
-			if(channel < 3) {
-				if(value & 0x80) {
-					channels_[channel].divider = (channels_[channel].divider & ~0xf) | (value & 0xf);
-				} else {
-					channels_[channel].divider = uint16_t((channels_[channel].divider & 0xf) | ((value & 0x3f) << 4));
-				}
+			// writes to the noise register always reset the shifter
+			noise_shifter_ = shifter_is_16bit_ ? 0x8000 : 0x4000;
+
+			if(value & 4) {
+				noise_mode_ = shifter_is_16bit_ ? Noise16 : Noise15;
 			} else {
-				// writes to the noise register always reset the shifter
-				noise_shifter_ = shifter_is_16bit_ ? 0x8000 : 0x4000;
-
-				if(value & 4) {
-					noise_mode_ = shifter_is_16bit_ ? Noise16 : Noise15;
-				} else {
-					noise_mode_ = shifter_is_16bit_ ? Periodic16 : Periodic15;
-				}
-
-				channels_[3].divider = uint16_t(0x10 << (value & 3));
-				// Special case: if these bits are both set, the noise channel should track channel 2,
-				// which is marked with a divider of 0xffff.
-				if(channels_[3].divider == 0x80) channels_[3].divider = 0xffff;
+				noise_mode_ = shifter_is_16bit_ ? Periodic16 : Periodic15;
 			}
+
+			channels_[3].divider = uint16_t(0x10 << (value & 3));
+			// Special case: if these bits are both set, the noise channel should track channel 2,
+			// which is marked with a divider of 0xffff.
+			if(channels_[3].divider == 0x80) channels_[3].divider = 0xffff;
 		}
-	});
+	}
 }
 
 bool SN76489::is_zero_level() const {
@@ -99,6 +115,48 @@ void SN76489::evaluate_output_volume() {
 	);
 }
 
+void SN76489::tick() {
+	bool did_flip = false;
+
+#define step_channel(x, s) \
+	if(channels_[x].counter) channels_[x].counter--;\
+	else {\
+		channels_[x].level ^= 1;\
+		channels_[x].counter = channels_[x].divider;\
+		s;\
+	}
+
+	step_channel(0, /**/);
+	step_channel(1, /**/);
+	step_channel(2, did_flip = true);
+
+#undef step_channel
+
+	if(channels_[3].divider != 0xffff) {
+		if(channels_[3].counter) channels_[3].counter--;
+		else {
+			did_flip = true;
+			channels_[3].counter = channels_[3].divider;
+		}
+	}
+
+	if(did_flip) {
+		channels_[3].level = noise_shifter_ & 1;
+		int new_bit = channels_[3].level;
+		switch(noise_mode_) {
+			default: break;
+			case Noise15:
+				new_bit ^= (noise_shifter_ >> 1);
+			break;
+			case Noise16:
+				new_bit ^= (noise_shifter_ >> 3);
+			break;
+		}
+		noise_shifter_ >>= 1;
+		noise_shifter_ |= (new_bit & 1) << (shifter_is_16bit_ ? 15 : 14);
+	}
+}
+
 void SN76489::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	std::size_t c = 0;
 	while((master_divider_& (master_divider_period_ - 1)) && c < number_of_samples) {
@@ -108,54 +166,93 @@ void SN76489::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 
 	while(c < number_of_samples) {
-		bool did_flip = false;
+		tick();
+		evaluate_output_volume();
 
-#define step_channel(x, s) \
-		if(channels_[x].counter) channels_[x].counter--;\
-		else {\
-			channels_[x].level ^= 1;\
-			channels_[x].counter = channels_[x].divider;\
-			s;\
+		for(int ic = 0; ic < master_divider_period_ && c < number_of_samples; ++ic) {
+			target[c] = output_volume_;
+			c++;
+			master_divider_++;
 		}
+	}
 
-		step_channel(0, /**/);
-		step_channel(1, /**/);
-		step_channel(2, did_flip = true);
+	master_divider_ &= (master_divider_period_ - 1);
+}
 
-#undef step_channel
+void SN76489::get_steps(std::size_t number_of_samples, Outputs::Speaker::StepTarget &target) {
+	// Catch up on any change in level since the last call, e.g. due to a register write.
+	if(output_volume_ != reported_volume_) {
+		target.add_step(0, output_volume_ - reported_volume_);
+		reported_volume_ = output_volume_;
+	}
+	advance(number_of_samples, &target);
+}
 
-		if(channels_[3].divider != 0xffff) {
-			if(channels_[3].counter) channels_[3].counter--;
-			else {
-				did_flip = true;
-				channels_[3].counter = channels_[3].divider;
-			}
+void SN76489::skip_samples(std::size_t number_of_samples) {
+	advance(number_of_samples, nullptr);
+	evaluate_output_volume();
+}
+
+bool SN76489::is_constant_level(std::size_t number_of_samples, std::int16_t *level) const {
+	// Output is constant if no audible channel changes state before the last tick within
+	// the period; ticks occur as per get_samples. Channel 2 is audible via the noise
+	// generator if the latter is audible.
+	const std::size_t period = std::size_t(master_divider_period_);
+	const std::size_t offset = (period - std::size_t(master_divider_)) & (period - 1);
+	if(offset < number_of_samples) {
+		const int ticks = int((number_of_samples - offset + period - 1) / period);
+		const bool noise_is_audible = channels_[3].volume != 0xf;
+		for(int c = 0; c < 3; c++) {
+			const bool is_audible = channels_[c].volume != 0xf || (c == 2 && noise_is_audible);
+			if(is_audible && channels_[c].counter < ticks) return false;
 		}
+		if(noise_is_audible && channels_[3].divider != 0xffff && channels_[3].counter < ticks) return false;
+	}
 
-		if(did_flip) {
-			channels_[3].level = noise_shifter_ & 1;
-			int new_bit = channels_[3].level;
-			switch(noise_mode_) {
-				default: break;
-				case Noise15:
-					new_bit ^= (noise_shifter_ >> 1);
-				break;
-				case Noise16:
-					new_bit ^= (noise_shifter_ >> 3);
-				break;
-			}
-			noise_shifter_ >>= 1;
-			noise_shifter_ |= (new_bit & 1) << (shifter_is_16bit_ ? 15 : 14);
+	*level = output_volume_;
+	return true;
+}
+
+void SN76489::advance(std::size_t number_of_samples, Outputs::Speaker::StepTarget *target) {
+	// Tone channels 0 and 1 can be advanced in bulk while they're silent, or if not posting steps;
+	// channel 2 also clocks the noise generator, so is always advanced tick by tick.
+	const int silent_tones = target ? (channels_[0].volume == 0xf ? 1 : 0) | (channels_[1].volume == 0xf ? 2 : 0) : 3;
+
+	// Ticks occur as per get_samples, whenever the master divider reaches a multiple of its period.
+	const std::size_t period = std::size_t(master_divider_period_);
+	std::size_t offset = (period - std::size_t(master_divider_)) & (period - 1);
+	master_divider_ = int((std::size_t(master_divider_) + number_of_samples) & (period - 1));
+
+	while(offset < number_of_samples) {
+		// Find the number of ticks that will pass before anything audible happens.
+		int quiet = int((number_of_samples - offset + period - 1) / period);
+		for(int c = 0; c < 2; c++) {
+			if(!(silent_tones & (1 << c))) quiet = std::min(quiet, int(channels_[c].counter));
 		}
+		quiet = std::min(quiet, int(channels_[2].counter));
+		if(channels_[3].divider != 0xffff) quiet = std::min(quiet, int(channels_[3].counter));
 
-		evaluate_output_volume();
+		// Skip those, if any.
+		if(quiet) {
+			for(int c = 0; c < 2; c++) {
+				channels_[c].level ^= Outputs::Speaker::advance_divider(channels_[c].counter, channels_[c].divider, quiet) & 1;
+			}
+			channels_[2].counter = uint16_t(channels_[2].counter - quiet);
+			if(channels_[3].divider != 0xffff) channels_[3].counter = uint16_t(channels_[3].counter - quiet);
 
-		for(int ic = 0; ic < master_divider_period_ && c < number_of_samples; ++ic) {
-			target[c] = output_volume_;
-			c++;
-			master_divider_++;
+			offset += std::size_t(quiet) * period;
+			if(offset >= number_of_samples) break;
 		}
-	}
 
-	master_divider_ &= (master_divider_period_ - 1);
+		// Perform the next tick in full.
+		tick();
+		if(target) {
+			evaluate_output_volume();
+			if(output_volume_ != reported_volume_) {
+				target->add_step(offset, output_volume_ - reported_volume_);
+				reported_volume_ = output_volume_;
+			}
+		}
+		offset += period;
+	}
 }
@@ -9,6 +9,7 @@
 #ifndef SN76489_hpp
 #define SN76489_hpp
 
+#include "../../Outputs/Speaker/Implementation/RegisterLog.hpp"
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
 
@@ -28,9 +29,16 @@ class SN76489: public Outputs::Speaker::SampleSource {
 		/// Writes a new value to the SN76489.
 		void write(uint8_t value);
 
+		/// Directs all future writes to @c log rather than to the queue supplied at construction.
+		void set_register_log(Outputs::Speaker::RegisterLog &log);
+
 		// As per SampleSource.
 		void get_samples(std::size_t number_of_samples, std::int16_t *target);
+		void get_steps(std::size_t number_of_samples, Outputs::Speaker::StepTarget &target);
+		static constexpr bool get_supplies_steps() { return true; }
+		void skip_samples(std::size_t number_of_samples);
 		bool is_zero_level() const;
+		bool is_constant_level(std::size_t number_of_samples, std::int16_t *level) const;
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return false; }
 
@@ -38,10 +46,17 @@ class SN76489: public Outputs::Speaker::SampleSource {
 		int master_divider_ = 0;
 		int master_divider_period_ = 16;
 		int16_t output_volume_ = 0;
+		int16_t reported_volume_ = 0;
 		void evaluate_output_volume();
+		void tick();
 		int volumes_[16];
 
+		/// Advances by @c number_of_samples, posting any change in output to @c target if it is non-null.
+		void advance(std::size_t number_of_samples, Outputs::Speaker::StepTarget *target);
+
 		Concurrency::DeferringAsyncTaskQueue &task_queue_;
+		Outputs::Speaker::RegisterLog::Input log_input_;
+		void apply_write(uint8_t value);
 
 		struct ToneChannel {
 			// Programmatically-set state; updated by the processor.
@@ -0,0 +1,105 @@
+//
+//  RingBuffer.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef RingBuffer_hpp
+#define RingBuffer_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Concurrency {
+
+/*!
+	A fixed-capacity, lock-free ring buffer of trivially-copyable values for exactly one
+	producer thread and one consumer thread.
+
+	The producer may call only @c write; the consumer may call only @c read and @c discard.
+	Either may call @c size, which is exact for the caller's own purposes: the producer will
+	never see less space than is really available, and the consumer will never see less data.
+*/
+template <typename T> class RingBuffer {
+	public:
+		/// Constructs a ring buffer able to hold at least @c capacity values.
+		RingBuffer(std::size_t capacity) {
+			std::size_t size = 1;
+			while(size < capacity) size <<= 1;
+			buffer_.resize(size);
+		}
+
+		/*!
+			Appends up to @c count values from @c source, as many as there is space for.
+
+			@returns The number of values written.
+		*/
+		std::size_t write(const T *source, std::size_t count) {
+			const std::size_t write = write_.load(std::memory_order_relaxed);
+			const std::size_t read = read_.load(std::memory_order_acquire);
+			count = std::min(count, buffer_.size() - (write - read));
+
+			const std::size_t start = write & (buffer_.size() - 1);
+			const std::size_t first_run = std::min(count, buffer_.size() - start);
+			std::copy(source, source + first_run, &buffer_[start]);
+			std::copy(source + first_run, source + count, buffer_.data());
+			write_.store(write + count, std::memory_order_release);
+			return count;
+		}
+
+		/*!
+			Removes up to @c count values into @c target, as many as are available.
+
+			@returns The number of values read.
+		*/
+		std::size_t read(T *target, std::size_t count) {
+			const std::size_t read = read_.load(std::memory_order_relaxed);
+			const std::size_t write = write_.load(std::memory_order_acquire);
+			count = std::min(count, write - read);
+
+			const std::size_t start = read & (buffer_.size() - 1);
+			const std::size_t first_run = std::min(count, buffer_.size() - start);
+			std::copy(&buffer_[start], &buffer_[start] + first_run, target);
+			std::copy(buffer_.data(), buffer_.data() + (count - first_run), target + first_run);
+			read_.store(read + count, std::memory_order_release);
+			return count;
+		}
+
+		/*!
+			Removes up to @c count values without reading them.
+
+			@returns The number of values discarded.
+		*/
+		std::size_t discard(std::size_t count) {
+			const std::size_t read = read_.load(std::memory_order_relaxed);
+			count = std::min(count, write_.load(std::memory_order_acquire) - read);
+			read_.store(read + count, std::memory_order_release);
+			return count;
+		}
+
+		/// @returns The number of values currently buffered.
+		std::size_t size() const {
+			return write_.load(std::memory_order_acquire) - read_.load(std::memory_order_acquire);
+		}
+
+		/// @returns The maximum number of values that can be buffered.
+		std::size_t capacity() const {
+			return buffer_.size();
+		}
+
+	private:
+		std::vector<T> buffer_;
+
+		// Each is a count of all values ever written or read, modulo the range of size_t;
+		// the capacity is a power of two so these can be mapped into buffer_ with a mask.
+		alignas(64) std::atomic<std::size_t> write_{0};
+		alignas(64) std::atomic<std::size_t> read_{0};
+};
+
+}
+
+#endif /* RingBuffer_hpp */
@@ -9,6 +9,7 @@
 #include "AmstradCPC.hpp"
 
 #include "Keyboard.hpp"
+#include "PixelSerialiser.hpp"
 
 #include "../../Processors/Z80/Z80.hpp"
 
@@ -19,6 +20,7 @@
 
 #include "../Utility/MemoryFuzzer.hpp"
 #include "../Utility/Typer.hpp"
+#include "../Utility/WriteTracker.hpp"
 
 #include "../../Activity/Source.hpp"
 #include "../MachineTypes.hpp"
@@ -27,12 +29,15 @@
 
 #include "../../ClockReceiver/ForceInline.hpp"
 #include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../Outputs/Speaker/Implementation/RegisterLog.hpp"
 #include "../../Outputs/CRT/CRT.hpp"
 
 #include "../../Analyser/Static/AmstradCPC/Target.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <limits>
 #include <vector>
 
 namespace AmstradCPC {
@@ -116,15 +121,19 @@ class InterruptTimer {
 class AYDeferrer {
 	public:
 		/// Constructs a new AY instance and sets its clock rate.
-		AYDeferrer() : ay_(GI::AY38910::Personality::AY38910, audio_queue_), speaker_(ay_) {
+		AYDeferrer() : audio_log_(audio_queue_), ay_(GI::AY38910::Personality::AY38910, audio_queue_), speaker_(ay_) {
 			speaker_.set_input_rate(1000000);
 			// Per the CPC Wiki:
 			// "A is output to the right, channel C is output left, and channel B is output to both left and right".
 			ay_.set_output_mixing(0.0, 0.5, 1.0, 1.0, 0.5, 0.0);
+
+			// Log register writes, to be replayed on the audio thread.
+			ay_.set_register_log(audio_log_);
+			speaker_.set_register_log(audio_log_);
 		}
 
 		~AYDeferrer() {
-			audio_queue_.flush();
+			audio_log_.flush();
 		}
 
 		/// Adds @c half_cycles half cycles to the amount of time that has passed.
@@ -132,14 +141,14 @@ class AYDeferrer {
 			cycles_since_update_ += half_cycles;
 		}
 
-		/// Enqueues an update-to-now into the AY's deferred queue.
+		/// Logs an update-to-now, ahead of any register write.
 		inline void update() {
-			speaker_.run_for(audio_queue_, cycles_since_update_.divide_cycles(Cycles(4)));
+			audio_log_.run_for(cycles_since_update_.divide_cycles(Cycles(4)));
 		}
 
 		/// Issues a request to the AY to perform all processing up to the current time.
 		inline void flush() {
-			audio_queue_.perform();
+			audio_log_.perform();
 		}
 
 		/// @returns the speaker the AY is using for output.
@@ -154,6 +163,7 @@ class AYDeferrer {
 
 	private:
 		Concurrency::DeferringAsyncTaskQueue audio_queue_;
+		Outputs::Speaker::RegisterLog audio_log_;
 		GI::AY38910::AY38910<true> ay_;
 		Outputs::Speaker::LowpassSpeaker<GI::AY38910::AY38910<true>> speaker_;
 		HalfCycles cycles_since_update_;
@@ -170,8 +180,6 @@ class CRTCBusHandler {
 			crt_(1024, 1, Outputs::Display::Type::PAL50, Outputs::Display::InputDataType::Red2Green2Blue2),
 			ram_(ram),
 			interrupt_timer_(interrupt_timer) {
-				establish_palette_hits();
-				build_mode_table();
 				crt_.set_visible_area(Outputs::Display::Rect(0.1072f, 0.1f, 0.842105263157895f, 0.842105263157895f));
 				crt_.set_brightness(3.0f / 2.0f);	// As only the values 0, 1 and 2 will be used in each channel,
 													// whereas Red2Green2Blue2 defines a range of 0-3.
@@ -251,35 +259,14 @@ class CRTCBusHandler {
 							((state.refresh_address & 0x3000) << 2)
 						);
 
+					// Keep track of the range of memory on display.
+					fetched_low_ = std::min(fetched_low_, size_t(address));
+					fetched_high_ = std::max(fetched_high_, size_t(address + 2));
+
 					// Fetch two bytes and translate into pixels. Guaranteed: the mode can change only at
 					// hsync, so there's no risk of pixel_pointer_ overrunning 320 output pixels without
 					// exactly reaching 320 output pixels.
-					switch(mode_) {
-						case 0:
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[0] = mode0_output_[ram_[address]];
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[1] = mode0_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint16_t);
-						break;
-
-						case 1:
-							reinterpret_cast<uint32_t *>(pixel_pointer_)[0] = mode1_output_[ram_[address]];
-							reinterpret_cast<uint32_t *>(pixel_pointer_)[1] = mode1_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint32_t);
-						break;
-
-						case 2:
-							reinterpret_cast<uint64_t *>(pixel_pointer_)[0] = mode2_output_[ram_[address]];
-							reinterpret_cast<uint64_t *>(pixel_pointer_)[1] = mode2_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint64_t);
-						break;
-
-						case 3:
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[0] = mode3_output_[ram_[address]];
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[1] = mode3_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint16_t);
-						break;
-
-					}
+					pixel_pointer_ = serialiser_.output(pixel_pointer_, &ram_[address], 1);
 
 					// Flush the current buffer pixel if full; the CRTC allows many different display
 					// widths so it's not necessarily possible to predict the correct number in advance
@@ -316,13 +303,25 @@ class CRTCBusHandler {
 						case 1:		pixel_divider_ = 2;	break;
 						case 2:		pixel_divider_ = 1;	break;
 					}
-					build_mode_table();
+					serialiser_.set_mode(mode_);
 				}
 			}
 
 			// check for a leading vsync; that also needs to be communicated to the interrupt timer
 			if(!was_vsync_ && state.vsync) {
 				interrupt_timer_.signal_vsync();
+
+				// Update the range of memory on display, unless no fetches occurred because the
+				// frame was a repeat.
+				if(fetched_high_) {
+					write_tracker_.set_range(fetched_low_, fetched_high_);
+					fetched_low_ = std::numeric_limits<size_t>::max();
+					fetched_high_ = 0;
+				}
+
+				// If nothing changed during the frame just output, and nothing changes during
+				// the next, then the next will be identical.
+				crt_.set_is_repeating_frame(write_tracker_.begin_frame());
 			}
 
 			// update current state for edge detection next time around
@@ -330,6 +329,79 @@ class CRTCBusHandler {
 			was_hsync_ = state.hsync;
 		}
 
+		/*!
+			The CRTC entry function for a run of bus cycles in which only the refresh address changes;
+			there's no sync edge for phase 2 to observe, and the output mode can change only in the first
+			cycle, so everything after that is either a single extension of the current period or a
+			fetch of contiguous spans of memory.
+		*/
+		void perform_bus_cycles(const Motorola::CRTC::BusState &state, int count) {
+			perform_bus_cycle_phase1(state);
+
+			uint16_t refresh_address = (state.refresh_address + 1) & 0x3fff;
+			--count;
+
+			if(previous_output_mode_ != OutputMode::Pixels) {
+				cycles_ += count;
+				return;
+			}
+
+			while(count) {
+				if(!pixel_data_) {
+					pixel_pointer_ = pixel_data_ = crt_.begin_data(320, 8);
+				}
+				if(!pixel_pointer_) {
+					// As per the single-cycle path, lose this cycle's pixels but try again for the next.
+					++cycles_;
+					--count;
+					refresh_address = (refresh_address + 1) & 0x3fff;
+					continue;
+				}
+
+				// Proceed for as long as addresses are contiguous, and there's space in the buffer.
+				const int length = std::min({
+					count,
+					0x400 - (refresh_address & 0x3ff),
+					int(pixel_data_ + 320 - pixel_pointer_) / serialiser_.bytes_per_character()
+				});
+				const uint16_t address =
+					uint16_t(
+						((refresh_address & 0x3ff) << 1) |
+						((state.row_address & 0x7) << 11) |
+						((refresh_address & 0x3000) << 2)
+					);
+
+				fetched_low_ = std::min(fetched_low_, size_t(address));
+				fetched_high_ = std::max(fetched_high_, size_t(address + length * 2));
+
+				pixel_pointer_ = serialiser_.output(pixel_pointer_, &ram_[address], length);
+				cycles_ += length;
+				count -= length;
+				refresh_address = (refresh_address + length) & 0x3fff;
+
+				if(pixel_pointer_ == pixel_data_ + 320) {
+					crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
+					pixel_pointer_ = pixel_data_ = nullptr;
+					cycles_ = 0;
+				}
+			}
+		}
+
+		/// Notifies the handler of a write to @c address, an offset into RAM, allowing it to spot frames
+		/// that are repeats of the one before.
+		void did_write(size_t address) {
+			write_tracker_.did_write(address);
+			if(write_tracker_.has_changed()) {
+				crt_.set_is_repeating_frame(false);
+			}
+		}
+
+		/// Notifies the handler of a change to anything other than memory that would affect output.
+		void did_change() {
+			write_tracker_.did_change();
+			crt_.set_is_repeating_frame(false);
+		}
+
 		/// Sets the destination for output.
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) {
 			crt_.set_scan_target(scan_target);
@@ -355,6 +427,7 @@ class CRTCBusHandler {
 			not immediately. So next means "as of the end of this line".
 		*/
 		void set_next_mode(int mode) {
+			if(mode != next_mode_) did_change();
 			next_mode_ = mode;
 		}
 
@@ -365,6 +438,8 @@ class CRTCBusHandler {
 
 		/// Palette management: sets the colour of the selected pen.
 		void set_colour(uint8_t colour) {
+			if(mapped_palette_value(colour) != ((pen_ & 16) ? border_ : serialiser_.pen(pen_))) did_change();
+
 			if(pen_ & 16) {
 				// If border is[/was] currently being output, flush what should have been
 				// drawn in the old colour.
@@ -374,8 +449,7 @@ class CRTCBusHandler {
 				}
 				border_ = mapped_palette_value(colour);
 			} else {
-				palette_[pen_] = mapped_palette_value(colour);
-				patch_mode_table(size_t(pen_));
+				serialiser_.set_pen(pen_, mapped_palette_value(colour));
 			}
 		}
 
@@ -394,143 +468,6 @@ class CRTCBusHandler {
 			}
 		}
 
-#define Mode0Colour0(c) (((c & 0x80) >> 7) | ((c & 0x20) >> 3) | ((c & 0x08) >> 2) | ((c & 0x02) << 2))
-#define Mode0Colour1(c) (((c & 0x40) >> 6) | ((c & 0x10) >> 2) | ((c & 0x04) >> 1) | ((c & 0x01) << 3))
-
-#define Mode1Colour0(c) (((c & 0x80) >> 7) | ((c & 0x08) >> 2))
-#define Mode1Colour1(c) (((c & 0x40) >> 6) | ((c & 0x04) >> 1))
-#define Mode1Colour2(c) (((c & 0x20) >> 5) | ((c & 0x02) >> 0))
-#define Mode1Colour3(c) (((c & 0x10) >> 4) | ((c & 0x01) << 1))
-
-#define Mode3Colour0(c)	(((c & 0x80) >> 7) | ((c & 0x08) >> 2))
-#define Mode3Colour1(c) (((c & 0x40) >> 6) | ((c & 0x04) >> 1))
-
-		/*!
-			Creates a lookup table from palette entry to list of affected entries in the value -> pixels lookup tables.
-		*/
-		void establish_palette_hits() {
-			for(size_t c = 0; c < 256; c++) {
-				assert(Mode0Colour0(c) < mode0_palette_hits_.size());
-				assert(Mode0Colour1(c) < mode0_palette_hits_.size());
-				mode0_palette_hits_[Mode0Colour0(c)].push_back(uint8_t(c));
-				mode0_palette_hits_[Mode0Colour1(c)].push_back(uint8_t(c));
-
-				assert(Mode1Colour0(c) < mode1_palette_hits_.size());
-				assert(Mode1Colour1(c) < mode1_palette_hits_.size());
-				assert(Mode1Colour2(c) < mode1_palette_hits_.size());
-				assert(Mode1Colour3(c) < mode1_palette_hits_.size());
-				mode1_palette_hits_[Mode1Colour0(c)].push_back(uint8_t(c));
-				mode1_palette_hits_[Mode1Colour1(c)].push_back(uint8_t(c));
-				mode1_palette_hits_[Mode1Colour2(c)].push_back(uint8_t(c));
-				mode1_palette_hits_[Mode1Colour3(c)].push_back(uint8_t(c));
-
-				assert(Mode3Colour0(c) < mode3_palette_hits_.size());
-				assert(Mode3Colour1(c) < mode3_palette_hits_.size());
-				mode3_palette_hits_[Mode3Colour0(c)].push_back(uint8_t(c));
-				mode3_palette_hits_[Mode3Colour1(c)].push_back(uint8_t(c));
-			}
-		}
-
-		void build_mode_table() {
-			switch(mode_) {
-				case 0:
-					// Mode 0: abcdefgh -> [gcea] [hdfb]
-					for(size_t c = 0; c < 256; c++) {
-						// Prepare mode 0.
-						uint8_t *const mode0_pixels = reinterpret_cast<uint8_t *>(&mode0_output_[c]);
-						mode0_pixels[0] = palette_[Mode0Colour0(c)];
-						mode0_pixels[1] = palette_[Mode0Colour1(c)];
-					}
-				break;
-
-				case 1:
-					for(size_t c = 0; c < 256; c++) {
-						// Prepare mode 1.
-						uint8_t *const mode1_pixels = reinterpret_cast<uint8_t *>(&mode1_output_[c]);
-						mode1_pixels[0] = palette_[Mode1Colour0(c)];
-						mode1_pixels[1] = palette_[Mode1Colour1(c)];
-						mode1_pixels[2] = palette_[Mode1Colour2(c)];
-						mode1_pixels[3] = palette_[Mode1Colour3(c)];
-					}
-				break;
-
-				case 2:
-					for(size_t c = 0; c < 256; c++) {
-						// Prepare mode 2.
-						uint8_t *const mode2_pixels = reinterpret_cast<uint8_t *>(&mode2_output_[c]);
-						mode2_pixels[0] = palette_[((c & 0x80) >> 7)];
-						mode2_pixels[1] = palette_[((c & 0x40) >> 6)];
-						mode2_pixels[2] = palette_[((c & 0x20) >> 5)];
-						mode2_pixels[3] = palette_[((c & 0x10) >> 4)];
-						mode2_pixels[4] = palette_[((c & 0x08) >> 3)];
-						mode2_pixels[5] = palette_[((c & 0x04) >> 2)];
-						mode2_pixels[6] = palette_[((c & 0x03) >> 1)];
-						mode2_pixels[7] = palette_[((c & 0x01) >> 0)];
-					}
-				break;
-
-				case 3:
-					for(size_t c = 0; c < 256; c++) {
-						// Prepare mode 3.
-						uint8_t *const mode3_pixels = reinterpret_cast<uint8_t *>(&mode3_output_[c]);
-						mode3_pixels[0] = palette_[Mode3Colour0(c)];
-						mode3_pixels[1] = palette_[Mode3Colour1(c)];
-					}
-				break;
-			}
-		}
-
-		void patch_mode_table(size_t pen) {
-			switch(mode_) {
-				case 0: {
-					for(uint8_t c : mode0_palette_hits_[pen]) {
-						assert(c < mode0_output_.size());
-						uint8_t *const mode0_pixels = reinterpret_cast<uint8_t *>(&mode0_output_[c]);
-						mode0_pixels[0] = palette_[Mode0Colour0(c)];
-						mode0_pixels[1] = palette_[Mode0Colour1(c)];
-					}
-				} break;
-				case 1:
-					if(pen >= mode1_palette_hits_.size()) return;
-					for(uint8_t c : mode1_palette_hits_[pen]) {
-						assert(c < mode1_output_.size());
-						uint8_t *const mode1_pixels = reinterpret_cast<uint8_t *>(&mode1_output_[c]);
-						mode1_pixels[0] = palette_[Mode1Colour0(c)];
-						mode1_pixels[1] = palette_[Mode1Colour1(c)];
-						mode1_pixels[2] = palette_[Mode1Colour2(c)];
-						mode1_pixels[3] = palette_[Mode1Colour3(c)];
-					}
-				break;
-				case 2:
-					if(pen > 1) return;
-					// Whichever pen this is, there's only one table entry it doesn't touch, so just
-					// rebuild the whole thing.
-					build_mode_table();
-				break;
-				case 3:
-					if(pen >= mode3_palette_hits_.size()) return;
-					// Same argument applies here as to case 1, as the unused bits aren't masked out.
-					for(uint8_t c : mode3_palette_hits_[pen]) {
-						assert(c < mode3_output_.size());
-						uint8_t *const mode3_pixels = reinterpret_cast<uint8_t *>(&mode3_output_[c]);
-						mode3_pixels[0] = palette_[Mode3Colour0(c)];
-						mode3_pixels[1] = palette_[Mode3Colour1(c)];
-					}
-				break;
-			}
-		}
-
-#undef Mode0Colour0
-#undef Mode0Colour1
-
-#undef Mode1Colour0
-#undef Mode1Colour1
-#undef Mode1Colour2
-#undef Mode1Colour3
-
-#undef Mode3Colour0
-#undef Mode3Colour1
-
 		uint8_t mapped_palette_value(uint8_t colour) {
 #define COL(r, g, b) (r << 4) | (g << 2) | b
 			constexpr uint8_t mapping[32] = {
@@ -562,22 +499,17 @@ class CRTCBusHandler {
 		Outputs::CRT::CRT crt_;
 		uint8_t *pixel_data_ = nullptr, *pixel_pointer_ = nullptr;
 
+		Memory::WriteTracker write_tracker_;
+		size_t fetched_low_ = std::numeric_limits<size_t>::max(), fetched_high_ = 0;
+
 		const uint8_t *const ram_ = nullptr;
 
 		int next_mode_ = 2, mode_ = 2;
 
 		int pixel_divider_ = 1;
-		std::array<uint16_t, 256> mode0_output_;
-		std::array<uint32_t, 256> mode1_output_;
-		std::array<uint64_t, 256> mode2_output_;
-		std::array<uint16_t, 256> mode3_output_;
-
-		std::array<std::vector<uint8_t>, 16> mode0_palette_hits_;
-		std::array<std::vector<uint8_t>, 4> mode1_palette_hits_;
-		std::array<std::vector<uint8_t>, 4> mode3_palette_hits_;
+		PixelSerialiser serialiser_;
 
 		int pen_ = 0;
-		uint8_t palette_[16];
 		uint8_t border_ = 0;
 
 		InterruptTimer &interrupt_timer_;
@@ -885,10 +817,17 @@ template <bool has_fdc> class ConcreteMachine:
 			// Update the CRTC once every eight half cycles; aiming for half-cycle 4 as
 			// per the initial seed to the crtc_counter_, but any time in the final four
 			// will do as it's safe to conclude that nobody else has touched video RAM
-			// during that whole window
+			// during that whole window.
+			//
+			// Cycles are accumulated until the CRTC is about to produce a change in sync,
+			// or until something else needs it to be up to date, so that it can spot and
+			// batch runs of cycles in which only the refresh address changes.
 			crtc_counter_ += cycle.length;
 			const Cycles crtc_cycles = crtc_counter_.divide_cycles(Cycles(4));
-			if(crtc_cycles > Cycles(0)) crtc_.run_for(crtc_cycles);
+			if(crtc_cycles > Cycles(0)) {
+				time_since_crtc_update_ += crtc_cycles;
+				if(time_since_crtc_update_ > cycles_until_crtc_event_) flush_crtc();
+			}
 
 			// Check whether that prompted a change in the interrupt line. If so then date
 			// it to whenever the cycle was triggered.
@@ -920,10 +859,14 @@ template <bool has_fdc> class ConcreteMachine:
 				break;
 
 				case CPU::Z80::PartialMachineCycle::Write:
+					flush_crtc();
 					write_pointers_[address >> 14][address & 16383] = *cycle.value;
+					crtc_bus_handler_.did_write(size_t(&write_pointers_[address >> 14][address & 16383] - ram_));
 				break;
 
 				case CPU::Z80::PartialMachineCycle::Output:
+					flush_crtc();
+
 					// Check for a gate array access.
 					if((address & 0xc000) == 0x4000) {
 						write_to_gate_array(*cycle.value);
@@ -941,7 +884,11 @@ template <bool has_fdc> class ConcreteMachine:
 					if(!(address & 0x4000)) {
 						switch((address >> 8) & 3) {
 							case 0:	crtc_.select_register(*cycle.value);	break;
-							case 1:	crtc_.set_register(*cycle.value);		break;
+							case 1:
+								crtc_.set_register(*cycle.value);
+								crtc_bus_handler_.did_change();
+								cycles_until_crtc_event_ = crtc_.get_next_sequence_point();
+							break;
 							default: break;
 						}
 					}
@@ -966,6 +913,8 @@ template <bool has_fdc> class ConcreteMachine:
 					}
 				break;
 				case CPU::Z80::PartialMachineCycle::Input:
+					flush_crtc();
+
 					// Default to nothing answering
 					*cycle.value = 0xff;
 
@@ -987,7 +936,11 @@ template <bool has_fdc> class ConcreteMachine:
 					if(!(address & 0x4000)) {
 						switch((address >> 8) & 3) {
 							case 0:	crtc_.select_register(*cycle.value);	break;
-							case 1:	crtc_.set_register(*cycle.value);		break;
+							case 1:
+								crtc_.set_register(*cycle.value);
+								crtc_bus_handler_.did_change();
+								cycles_until_crtc_event_ = crtc_.get_next_sequence_point();
+							break;
 							case 2: *cycle.value &= crtc_.get_status();		break;
 							case 3:	*cycle.value &= crtc_.get_register();	break;
 						}
@@ -1026,6 +979,7 @@ template <bool has_fdc> class ConcreteMachine:
 			ay_.update();
 			ay_.flush();
 			flush_fdc();
+			flush_crtc();
 		}
 
 		/// A CRTMachine function; sets the destination for video.
@@ -1061,7 +1015,7 @@ template <bool has_fdc> class ConcreteMachine:
 		bool insert_media(const Analyser::Static::Media &media) final {
 			// If there are any tapes supplied, use the first of them.
 			if(!media.tapes.empty()) {
-				tape_player_.set_tape(media.tapes.front());
+				tape_player_.set_tape(media.tapes.front(), true);
 			}
 
 			// Insert up to four disks.
@@ -1120,12 +1074,15 @@ template <bool has_fdc> class ConcreteMachine:
 		std::unique_ptr<Reflection::Struct> get_options() final {
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->output = get_video_signal_configurable();
+			options->quickload = allow_fast_disk_reading_;
 			return options;
 		}
 
 		void set_options(const std::unique_ptr<Reflection::Struct> &str) {
 			const auto options = dynamic_cast<Options *>(str.get());
 			set_video_signal_configurable(options->output);
+			allow_fast_disk_reading_ = options->quickload;
+			if constexpr (has_fdc) fdc_.set_allows_direct_reading(allow_fast_disk_reading_);
 		}
 
 		// MARK: - Joysticks
@@ -1183,12 +1140,22 @@ template <bool has_fdc> class ConcreteMachine:
 
 		CRTCBusHandler crtc_bus_handler_;
 		Motorola::CRTC::CRTC6845<CRTCBusHandler> crtc_;
+		Cycles time_since_crtc_update_;
+		Cycles cycles_until_crtc_event_;
+		void flush_crtc() {
+			if(time_since_crtc_update_ > Cycles(0)) {
+				crtc_.run_for(time_since_crtc_update_);
+				time_since_crtc_update_ = Cycles(0);
+			}
+			cycles_until_crtc_event_ = crtc_.get_next_sequence_point();
+		}
 
 		AYDeferrer ay_;
 		i8255PortHandler i8255_port_handler_;
 		Intel::i8255::i8255<i8255PortHandler> i8255_;
 
 		FDC fdc_;
+		bool allow_fast_disk_reading_ = false;
 		HalfCycles time_since_fdc_update_;
 		void flush_fdc() {
 			if constexpr (has_fdc) {
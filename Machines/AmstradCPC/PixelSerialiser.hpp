@@ -0,0 +1,113 @@
+//
+//  PixelSerialiser.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef AmstradCPC_PixelSerialiser_hpp
+#define AmstradCPC_PixelSerialiser_hpp
+
+#include "../../Outputs/PaletteExpansionCache.hpp"
+
+#include <cstdint>
+
+namespace AmstradCPC {
+
+/*!
+	Converts the bytes fetched by the gate array into Red2Green2Blue2 pixels, in any of the CPC's
+	four video modes.
+
+	Conversion is via a table per mode, from byte to all of the pixels that it produces. Changes of
+	mode or palette only mark the tables as stale; each is brought up to date upon its next use,
+	so that any number of palette changes while pixels aren't being output cost nothing.
+
+	Each character is two bytes, producing 4 bytes of output in modes 0 and 3, 8 in mode 1 and 16 in mode 2.
+*/
+class PixelSerialiser {
+	public:
+		/// Sets the mode, 0–3, that will be used for subsequent output.
+		void set_mode(int mode) {
+			mode_ = mode;
+		}
+
+		/// Sets the colour of @c pen, 0–15, to @c colour, a Red2Green2Blue2 value.
+		void set_pen(int pen, uint8_t colour) {
+			palette_[pen] = colour;
+			mode0_output_.invalidate(pen);
+			mode1_output_.invalidate(pen);
+			mode2_output_.invalidate(pen);
+			mode3_output_.invalidate(pen);
+		}
+
+		/// @returns The current colour of @c pen.
+		uint8_t pen(int pen) const {
+			return palette_[pen];
+		}
+
+		/// @returns The number of bytes of output that each character produces in the current mode.
+		int bytes_per_character() const {
+			constexpr int sizes[] = {4, 8, 16, 4};
+			return sizes[mode_];
+		}
+
+		/*!
+			Converts the @c count characters, i.e. the 2 * @c count bytes, at @c source to pixels at @c target,
+			which should be suitably aligned for a @c uint64_t.
+
+			@returns A pointer to the byte after the final one written.
+		*/
+		uint8_t *output(uint8_t *target, const uint8_t *source, int count) {
+			const int bytes = count * 2;
+			switch(mode_) {
+				default:
+				case 0:	serialise(reinterpret_cast<uint16_t *>(target), mode0_output_.get(palette_), source, bytes);	break;
+				case 1:	serialise(reinterpret_cast<uint32_t *>(target), mode1_output_.get(palette_), source, bytes);	break;
+				case 2:	serialise(reinterpret_cast<uint64_t *>(target), mode2_output_.get(palette_), source, bytes);	break;
+				case 3:	serialise(reinterpret_cast<uint16_t *>(target), mode3_output_.get(palette_), source, bytes);	break;
+			}
+
+			return target + count * bytes_per_character();
+		}
+
+	private:
+		template <typename EntryT> static void serialise(EntryT *target, const EntryT *table, const uint8_t *source, int bytes) {
+			for(int c = 0; c < bytes; c++) target[c] = table[source[c]];
+		}
+
+		// Byte to pen mappings for each mode.
+		//
+		// Mode 0: abcdefgh -> [gcea] [hdfb]
+		struct Mode0Indexer {
+			static constexpr int index(uint8_t byte, int pixel) {
+				const int shifted = byte << pixel;
+				return ((shifted & 0x80) >> 7) | ((shifted & 0x20) >> 3) | ((shifted & 0x08) >> 2) | ((shifted & 0x02) << 2);
+			}
+		};
+		// Modes 1 and 3: abcdefgh -> [ea] [fb] [gc] [hd]; mode 3 uses only the first two.
+		struct Mode1Indexer {
+			static constexpr int index(uint8_t byte, int pixel) {
+				const int shifted = byte << pixel;
+				return ((shifted & 0x80) >> 7) | ((shifted & 0x08) >> 2);
+			}
+		};
+		// Mode 2: abcdefgh -> [a] [b] [c] [d] [e] [f] [g] [h]
+		struct Mode2Indexer {
+			static constexpr int index(uint8_t byte, int pixel) {
+				return ((byte << pixel) & 0x80) >> 7;
+			}
+		};
+
+		int mode_ = 2;
+		uint8_t palette_[16]{};
+
+		Outputs::Display::PaletteExpansionCache<uint16_t, Mode0Indexer> mode0_output_;
+		Outputs::Display::PaletteExpansionCache<uint32_t, Mode1Indexer> mode1_output_;
+		Outputs::Display::PaletteExpansionCache<uint64_t, Mode2Indexer> mode2_output_;
+		Outputs::Display::PaletteExpansionCache<uint16_t, Mode1Indexer> mode3_output_;
+};
+
+}
+
+#endif /* AmstradCPC_PixelSerialiser_hpp */
@@ -65,6 +65,7 @@ Outputs::Display::DisplayType VideoBase::get_display_type() const {
 void VideoBase::set_alternative_character_set(bool alternative_character_set) {
 	set_alternative_character_set_ = alternative_character_set;
 	deferrer_.defer(Cycles(2), [this, alternative_character_set] {
+		output_pending_columns();
 		alternative_character_set_ = alternative_character_set;
 		if(alternative_character_set) {
 			character_zones[1].address_mask = 0xff;
@@ -83,6 +84,7 @@ bool VideoBase::get_alternative_character_set() {
 void VideoBase::set_80_columns(bool columns_80) {
 	set_columns_80_ = columns_80;
 	deferrer_.defer(Cycles(2), [this, columns_80] {
+		output_pending_columns();
 		columns_80_ = columns_80;
 	});
 }
@@ -110,6 +112,7 @@ bool VideoBase::get_page2() {
 void VideoBase::set_text(bool text) {
 	set_text_ = text;
 	deferrer_.defer(Cycles(2), [this, text] {
+		output_pending_columns();
 		text_ = text;
 	});
 }
@@ -121,6 +124,7 @@ bool VideoBase::get_text() {
 void VideoBase::set_mixed(bool mixed) {
 	set_mixed_ = mixed;
 	deferrer_.defer(Cycles(2), [this, mixed] {
+		output_pending_columns();
 		mixed_ = mixed;
 	});
 }
@@ -132,6 +136,7 @@ bool VideoBase::get_mixed() {
 void VideoBase::set_high_resolution(bool high_resolution) {
 	set_high_resolution_ = high_resolution;
 	deferrer_.defer(Cycles(2), [this, high_resolution] {
+		output_pending_columns();
 		high_resolution_ = high_resolution;
 	});
 }
@@ -143,6 +148,7 @@ bool VideoBase::get_high_resolution() {
 void VideoBase::set_annunciator_3(bool annunciator_3) {
 	set_annunciator_3_ = annunciator_3;
 	deferrer_.defer(Cycles(2), [this, annunciator_3] {
+		output_pending_columns();
 		annunciator_3_ = annunciator_3;
 		high_resolution_mask_ = annunciator_3_ ? 0x7f : 0xff;
 	});
@@ -170,6 +176,81 @@ void VideoBase::set_character_rom(const std::vector<uint8_t> &character_rom) {
 	}
 }
 
+// MARK: - Lazy rendering.
+
+bool VideoBase::RenderState::operator ==(const RenderState &rhs) const {
+	if(mode != rhs.mode || high_resolution_mask != rhs.high_resolution_mask) return false;
+	for(int c = 0; c < 4; c++) {
+		if(
+			character_zones[c].address_mask != rhs.character_zones[c].address_mask ||
+			character_zones[c].xor_mask != rhs.character_zones[c].xor_mask
+		) return false;
+	}
+	return true;
+}
+
+VideoBase::RenderState VideoBase::render_state(GraphicsMode mode) const {
+	// Capture only that which is relevant to the mode, so that e.g. flashing
+	// doesn't prevent graphics lines from being reused.
+	RenderState state;
+	state.mode = mode;
+	if(mode == GraphicsMode::Text || mode == GraphicsMode::DoubleText) {
+		std::copy(std::begin(character_zones), std::end(character_zones), std::begin(state.character_zones));
+	}
+	if(mode == GraphicsMode::HighRes) {
+		state.high_resolution_mask = high_resolution_mask_;
+	}
+	return state;
+}
+
+void VideoBase::output_pending_columns() {
+	if(rendered_column_ == fetched_column_) return;
+
+	uint8_t *const target = line_cache_[size_t(pending_row_)].pixels.data();
+	const int start = rendered_column_;
+	const size_t length = size_t(fetched_column_ - rendered_column_);
+	const int pixel_row = pending_row_ & 7;
+	rendered_column_ = fetched_column_;
+
+	const bool is_double = is_double_mode(pending_mode_);
+	if(!is_double && was_double_) {
+		std::fill(&target[start*14], &target[start*14 + 7], 0);
+	}
+	was_double_ = is_double;
+
+	switch(pending_mode_) {
+		case GraphicsMode::Text:
+			output_text(&target[start * 14 + 7], &base_stream_[size_t(start)], length, size_t(pixel_row));
+		break;
+
+		case GraphicsMode::DoubleText:
+			output_double_text(&target[start * 14], &base_stream_[size_t(start)], &auxiliary_stream_[size_t(start)], length, size_t(pixel_row));
+		break;
+
+		case GraphicsMode::LowRes:
+			output_low_resolution(&target[start * 14 + 7], &base_stream_[size_t(start)], length, start, pixel_row);
+		break;
+
+		case GraphicsMode::FatLowRes:
+			output_fat_low_resolution(&target[start * 14 + 7], &base_stream_[size_t(start)], length, start, pixel_row);
+		break;
+
+		case GraphicsMode::DoubleLowRes:
+			output_double_low_resolution(&target[start * 14], &base_stream_[size_t(start)], &auxiliary_stream_[size_t(start)], length, start, pixel_row);
+		break;
+
+		case GraphicsMode::HighRes:
+			output_high_resolution(&target[start * 14 + 7], &base_stream_[size_t(start)], length);
+		break;
+
+		case GraphicsMode::DoubleHighRes:
+			output_double_high_resolution(&target[start * 14], &base_stream_[size_t(start)], &auxiliary_stream_[size_t(start)], length);
+		break;
+	}
+}
+
+// MARK: - Pixel generation.
+
 void VideoBase::output_text(uint8_t *target, const uint8_t *const source, size_t length, size_t pixel_row) const {
 	for(size_t c = 0; c < length; ++c) {
 		const int character = source[c] & character_zones[source[c] >> 6].address_mask;
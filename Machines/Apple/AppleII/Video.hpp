@@ -13,6 +13,7 @@
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 #include "../../../ClockReceiver/DeferredQueue.hpp"
 
+#include <algorithm>
 #include <array>
 #include <vector>
 
@@ -257,6 +258,39 @@ class VideoBase {
 		*/
 		void output_fat_low_resolution(uint8_t *target, const uint8_t *source, size_t length, int column, int row) const;
 
+		// Pixels are generated only once a line has been fetched in full, or when a mode switch
+		// is about to take effect partway through it. Each line's output is retained, along with
+		// everything that affected it, so that a line that is unchanged since the last frame
+		// can be copied rather than regenerated.
+		struct RenderState {
+			GraphicsMode mode = GraphicsMode::Text;
+			CharacterMapping character_zones[4]{};
+			uint8_t high_resolution_mask = 0;
+
+			bool operator ==(const RenderState &rhs) const;
+		};
+		RenderState render_state(GraphicsMode mode) const;
+
+		struct CachedLine {
+			std::array<uint8_t, 568> pixels;
+			std::array<uint8_t, 40> base_stream;
+			std::array<uint8_t, 40> auxiliary_stream;
+			RenderState state;
+			bool is_valid = false;
+		};
+		std::vector<CachedLine> line_cache_ = std::vector<CachedLine>(192);
+
+		// Columns [rendered_column_, fetched_column_) of row pending_row_ have been fetched but not yet rendered.
+		GraphicsMode pending_mode_ = GraphicsMode::Text;
+		int pending_row_ = 0;
+		int rendered_column_ = 0, fetched_column_ = 0;
+
+		/*!
+			Renders all fetched columns of the current line into its cached pixels; this should be called
+			before anything that affects rendering is changed.
+		*/
+		void output_pending_columns();
+
 		// Maintain a DeferredQueue for delayed mode switches.
 		DeferredQueuePerformer<Cycles> deferrer_;
 };
@@ -415,102 +449,54 @@ template <class BusHandler, bool is_iie> class Video: public VideoBase {
 							pixel_pointer_ = crt_.begin_data(568);
 							graphics_carry_ = 0;
 							was_double_ = true;
+							rendered_column_ = fetched_column_ = 0;
 						}
 
 						if(column_ < 40) {
-							const int pixel_start = std::max(0, column_);
+							// Pixels are rendered lazily; just note what has been fetched.
 							const int pixel_end = std::min(40, ending_column);
-							const int pixel_row = row_ & 7;
-
-							const bool is_double = Video::is_double_mode(line_mode);
-							if(!is_double && was_double_ && pixel_pointer_) {
-								pixel_pointer_[pixel_start*14 + 0] =
-								pixel_pointer_[pixel_start*14 + 1] =
-								pixel_pointer_[pixel_start*14 + 2] =
-								pixel_pointer_[pixel_start*14 + 3] =
-								pixel_pointer_[pixel_start*14 + 4] =
-								pixel_pointer_[pixel_start*14 + 5] =
-								pixel_pointer_[pixel_start*14 + 6] = 0;
-							}
-							was_double_ = is_double;
-
-							if(pixel_pointer_) {
-								switch(line_mode) {
-									case GraphicsMode::Text:
-										output_text(
-											&pixel_pointer_[pixel_start * 14 + 7],
-											&base_stream_[size_t(pixel_start)],
-											size_t(pixel_end - pixel_start),
-											size_t(pixel_row));
-									break;
-
-									case GraphicsMode::DoubleText:
-										output_double_text(
-											&pixel_pointer_[pixel_start * 14],
-											&base_stream_[size_t(pixel_start)],
-											&auxiliary_stream_[size_t(pixel_start)],
-											size_t(pixel_end - pixel_start),
-											size_t(pixel_row));
-									break;
-
-									case GraphicsMode::LowRes:
-										output_low_resolution(
-											&pixel_pointer_[pixel_start * 14 + 7],
-											&base_stream_[size_t(pixel_start)],
-											size_t(pixel_end - pixel_start),
-											pixel_start,
-											pixel_row);
-									break;
-
-									case GraphicsMode::FatLowRes:
-										output_fat_low_resolution(
-											&pixel_pointer_[pixel_start * 14 + 7],
-											&base_stream_[size_t(pixel_start)],
-											size_t(pixel_end - pixel_start),
-											pixel_start,
-											pixel_row);
-									break;
-
-									case GraphicsMode::DoubleLowRes:
-										output_double_low_resolution(
-											&pixel_pointer_[pixel_start * 14],
-											&base_stream_[size_t(pixel_start)],
-											&auxiliary_stream_[size_t(pixel_start)],
-											size_t(pixel_end - pixel_start),
-											pixel_start,
-											pixel_row);
-									break;
-
-									case GraphicsMode::HighRes:
-										output_high_resolution(
-											&pixel_pointer_[pixel_start * 14 + 7],
-											&base_stream_[size_t(pixel_start)],
-											size_t(pixel_end - pixel_start));
-									break;
-
-									case GraphicsMode::DoubleHighRes:
-										output_double_high_resolution(
-											&pixel_pointer_[pixel_start * 14],
-											&base_stream_[size_t(pixel_start)],
-											&auxiliary_stream_[size_t(pixel_start)],
-											size_t(pixel_end - pixel_start));
-									break;
-
-									default: break;
-								}
-							}
+							pending_mode_ = line_mode;
+							pending_row_ = row_;
+							fetched_column_ = pixel_end;
 
 							if(pixel_end == 40) {
-								if(pixel_pointer_) {
+								CachedLine &line = line_cache_[size_t(row_)];
+								const RenderState state = render_state(line_mode);
+
+								// Reuse the previous output for this line if nothing has changed, either in
+								// what was fetched or in how that is interpreted. Only lines that had a
+								// single mode throughout are eligible.
+								if(
+									!rendered_column_ &&
+									line.is_valid &&
+									line.state == state &&
+									line.base_stream == base_stream_ &&
+									(!Video::is_double_mode(line_mode) || line.auxiliary_stream == auxiliary_stream_)
+								) {
+									rendered_column_ = fetched_column_;
+								} else {
+									line.is_valid = !rendered_column_;
+									output_pending_columns();
+
 									if(was_double_) {
-										pixel_pointer_[560] = pixel_pointer_[561] = pixel_pointer_[562] = pixel_pointer_[563] =
-										pixel_pointer_[564] = pixel_pointer_[565] = pixel_pointer_[566] = pixel_pointer_[567] = 0;
+										line.pixels[560] = line.pixels[561] = line.pixels[562] = line.pixels[563] =
+										line.pixels[564] = line.pixels[565] = line.pixels[566] = line.pixels[567] = 0;
 									} else {
 										if(line_mode == GraphicsMode::HighRes && base_stream_[39]&0x80)
-											pixel_pointer_[567] = graphics_carry_;
+											line.pixels[567] = graphics_carry_;
 										else
-											pixel_pointer_[567] = 0;
+											line.pixels[567] = 0;
 									}
+
+									if(line.is_valid) {
+										line.state = state;
+										line.base_stream = base_stream_;
+										line.auxiliary_stream = auxiliary_stream_;
+									}
+								}
+
+								if(pixel_pointer_) {
+									std::copy(line.pixels.begin(), line.pixels.end(), pixel_pointer_);
 								}
 
 								crt_.output_data(568, 568);
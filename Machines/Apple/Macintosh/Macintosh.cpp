@@ -334,8 +334,12 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 					// It embodies knowledge of the fact that video (and audio) will always
 					// be fetched from the final $d900 bytes of memory.
 					// (And that ram_mask_ = ram size - 1).
-					if(address > ram_mask_ - 0xd900)
+					if(address > ram_mask_ - 0xd900) {
 						update_video();
+						if(!(cycle.operation & Microcycle::Read)) {
+							video_.did_write(address & ram_mask_);
+						}
+					}
 
 					memory_base = ram_.data();
 					address &= ram_mask_;
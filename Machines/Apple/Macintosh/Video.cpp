@@ -26,7 +26,7 @@ using namespace Apple::Macintosh;
 Video::Video(DeferredAudio &audio, DriveSpeedAccumulator &drive_speed_accumulator) :
 	audio_(audio),
 	drive_speed_accumulator_(drive_speed_accumulator),
- 	crt_(704, 1, 370, 6, Outputs::Display::InputDataType::Luminance1) {
+ 	crt_(704, 1, 370, 6, Outputs::Display::InputDataType::PackedLuminance1) {
 
  	crt_.set_display_type(Outputs::Display::DisplayType::RGB);
 
@@ -56,6 +56,11 @@ void Video::run_for(HalfCycles duration) {
 	const size_t video_base = (use_alternate_screen_buffer_ ? (0xffff2700 >> 1) : (0xffffa700 >> 1)) & ram_mask_;
 	const size_t audio_base = (use_alternate_audio_buffer_ ? (0xffffa100 >> 1) : (0xfffffd00 >> 1)) & ram_mask_;
 
+	// Any change to the frame buffer since the current frame began means that it won't be a repeat.
+	if(write_tracker_.has_changed()) {
+		crt_.set_is_repeating_frame(false);
+	}
+
 	// The number of HalfCycles is literally the number of pixel clocks to move through,
 	// since pixel output occurs at twice the processor clock. So divide by 16 to get
 	// the number of fetches.
@@ -86,41 +91,26 @@ void Video::run_for(HalfCycles duration) {
 					const int final_pixel_word = std::min(final_word, 32);
 
 					if(!first_word) {
-						pixel_buffer_ = crt_.begin_data(512);
+						pixel_buffer_ = crt_.begin_data(64);
 					}
 
 					if(pixel_buffer_) {
+						// Pixels are passed on as packed bits, so each word becomes two bytes
+						// in display order. The Mac's 1s are black, so invert.
 						for(int c = first_word; c < final_pixel_word; ++c) {
-							uint16_t pixels = ram_[video_base + video_address_] ^ 0xffff;
+							const uint16_t pixels = ram_[video_base + video_address_] ^ 0xffff;
 							++video_address_;
 
-							pixel_buffer_[15] = pixels & 0x01;
-							pixel_buffer_[14] = pixels & 0x02;
-							pixel_buffer_[13] = pixels & 0x04;
-							pixel_buffer_[12] = pixels & 0x08;
-							pixel_buffer_[11] = pixels & 0x10;
-							pixel_buffer_[10] = pixels & 0x20;
-							pixel_buffer_[9] = pixels & 0x40;
-							pixel_buffer_[8] = pixels & 0x80;
-
-							pixels >>= 8;
-							pixel_buffer_[7] = pixels & 0x01;
-							pixel_buffer_[6] = pixels & 0x02;
-							pixel_buffer_[5] = pixels & 0x04;
-							pixel_buffer_[4] = pixels & 0x08;
-							pixel_buffer_[3] = pixels & 0x10;
-							pixel_buffer_[2] = pixels & 0x20;
-							pixel_buffer_[1] = pixels & 0x40;
-							pixel_buffer_[0] = pixels & 0x80;
-
-							pixel_buffer_ += 16;
+							pixel_buffer_[0] = uint8_t(pixels >> 8);
+							pixel_buffer_[1] = uint8_t(pixels);
+							pixel_buffer_ += 2;
 						}
 					} else {
 						video_address_ += size_t(final_pixel_word - first_word);
 					}
 
 					if(final_pixel_word == 32) {
-						crt_.output_data(512);
+						crt_.output_data(512, 64);
 						pixel_buffer_ = nullptr;
 					}
 				}
@@ -155,6 +145,10 @@ void Video::run_for(HalfCycles duration) {
 		frame_position_ = frame_position_ + cycles_left_in_line;
 		if(frame_position_ == frame_length) {
 			frame_position_ = HalfCycles(0);
+
+			// If nothing changed during the frame just output, and nothing changes during
+			// the next, then the next will be identical.
+			crt_.set_is_repeating_frame(write_tracker_.begin_frame());
 			/*
 				Video: $1A700 and the alternate buffer starts at $12700; for a 512K Macintosh, add $60000 to these numbers.
 			*/
@@ -193,9 +187,17 @@ HalfCycles Video::get_next_sequence_point() {
 void Video::set_use_alternate_buffers(bool use_alternate_screen_buffer, bool use_alternate_audio_buffer) {
 	use_alternate_screen_buffer_ = use_alternate_screen_buffer;
 	use_alternate_audio_buffer_ = use_alternate_audio_buffer;
+	update_tracked_range();
 }
 
 void Video::set_ram(uint16_t *ram, uint32_t mask) {
 	ram_ = ram;
 	ram_mask_ = mask;
+	update_tracked_range();
+}
+
+void Video::update_tracked_range() {
+	// The tracker deals in bytes; 342 lines of 64 bytes are displayed.
+	const size_t video_base = ((use_alternate_screen_buffer_ ? (0xffff2700 >> 1) : (0xffffa700 >> 1)) & ram_mask_) << 1;
+	write_tracker_.set_range(video_base, video_base + 342*64);
 }
@@ -10,6 +10,7 @@
 #define Video_hpp
 
 #include "../../../Outputs/CRT/CRT.hpp"
+#include "../../Utility/WriteTracker.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 #include "DeferredAudio.hpp"
 #include "DriveSpeedAccumulator.hpp"
@@ -61,6 +62,14 @@ class Video {
 		*/
 		void set_ram(uint16_t *ram, uint32_t mask);
 
+		/*!
+			Notifies the video of a write to @c address, a byte offset into RAM, allowing it to
+			spot frames that are repeats of the one before.
+		*/
+		void did_write(size_t address) {
+			write_tracker_.did_write(address);
+		}
+
 		/*!
 			@returns @c true if the video is currently outputting a vertical sync, @c false otherwise.
 		*/
@@ -100,6 +109,9 @@ class Video {
 
 		bool use_alternate_screen_buffer_ = false;
 		bool use_alternate_audio_buffer_ = false;
+
+		Memory::WriteTracker write_tracker_;
+		void update_tracked_range();
 };
 
 }
@@ -20,6 +20,10 @@ namespace {
 	constexpr int blank_flag = 0x2;
 
 	uint8_t reverse_table[256];
+
+	// map from a byte to the same byte with each bit repeated two or four times, bit 0 first
+	uint16_t doubled_table[256];
+	uint32_t quadrupled_table[256];
 }
 
 TIA::TIA():
@@ -32,6 +36,14 @@ TIA::TIA():
 			((c & 0x01) << 7) | ((c & 0x02) << 5) | ((c & 0x04) << 3) | ((c & 0x08) << 1) |
 			((c & 0x10) >> 1) | ((c & 0x20) >> 3) | ((c & 0x40) >> 5) | ((c & 0x80) >> 7)
 		);
+
+		doubled_table[c] = quadrupled_table[c] = 0;
+		for(int bit = 0; bit < 8; bit++) {
+			if(c & (1 << bit)) {
+				doubled_table[c] |= 0x3 << (bit * 2);
+				quadrupled_table[c] |= 0xfu << (bit * 4);
+			}
+		}
 	}
 
 	for(int c = 0; c < 64; c++) {
@@ -529,8 +541,21 @@ void TIA::output_pixels(int start, int end) {
 void TIA::output_line() {
 	switch(output_mode_) {
 		default:
-			// TODO: optimise special case
-			output_for_cycles(cycles_per_line);
+			// Motion, missile locking and pixels queued from a previous line all act part way
+			// through the line, so are left to the incremental path. Otherwise nothing can
+			// change during a whole line.
+			if(
+				horizontal_blank_extend_ ||
+				player_[0].has_queued_pixels() || player_[1].has_queued_pixels() ||
+				player_[0].is_moving || player_[1].is_moving ||
+				missile_[0].is_moving || missile_[1].is_moving ||
+				ball_.is_moving ||
+				missile_[0].locked_to_player || missile_[1].locked_to_player
+			) {
+				output_for_cycles(cycles_per_line);
+			} else {
+				output_line_from_masks();
+			}
 		break;
 		case sync_flag:
 		case sync_flag | blank_flag:
@@ -549,6 +574,99 @@ void TIA::output_line() {
 	}
 }
 
+void TIA::output_line_from_masks() {
+	// This is output_for_cycles(cycles_per_line) for a line on which no object is moving, with
+	// each object drawn to a bit mask rather than to the collision buffer.
+	ball_.motion_time %= 228;
+	player_[0].motion_time %= 228;
+	player_[1].motion_time %= 228;
+	missile_[0].motion_time %= 228;
+	missile_[1].motion_time %= 228;
+
+	// These are in CollisionType order.
+	LineMask masks[6];
+	LineMask &playfield = masks[0], &ball = masks[1];
+	LineMask &player0 = masks[2], &player1 = masks[3];
+	LineMask &missile0 = masks[4], &missile1 = masks[5];
+
+	for(int half = 0; half < 2; half++) {
+		const uint32_t background = background_[half & background_half_mask_];
+		playfield.set_bits(half * 80, uint64_t(quadrupled_table[background & 0xff]) | (uint64_t(quadrupled_table[(background >> 8) & 0xff]) << 32));
+		playfield.set_bits(half * 80 + 64, quadrupled_table[background >> 16]);
+	}
+	draw_object_line<Player>(player_[0], player0);
+	draw_object_line<Player>(player_[1], player1);
+	draw_object_line<Missile>(missile_[0], missile0);
+	draw_object_line<Missile>(missile_[1], missile1);
+	draw_object_line<Ball>(ball_, ball);
+
+	// A pair of objects has collided if their masks intersect anywhere.
+	for(int c = 0; c < 6; c++) {
+		for(int d = c+1; d < 6; d++) {
+			if(masks[c].intersects(masks[d])) {
+				collision_flags_ |= collision_flags_by_buffer_vaules_[(1 << c) | (1 << d)];
+			}
+		}
+	}
+
+	// Convert to television signals.
+	crt_.output_blank(32);
+	crt_.output_sync(32);
+	crt_.output_default_colour_burst(32);
+	crt_.output_blank(40);
+
+	uint16_t *const pixels = reinterpret_cast<uint16_t *>(crt_.begin_data(160));
+	if(pixels) {
+		// Resolve priorities a word at a time, to a two-bit ColourIndex per pixel.
+		constexpr uint64_t score_left_half[3] = {~uint64_t(0), 0xffff, 0};
+		uint64_t colour_low[3], colour_high[3];
+		for(int word = 0; word < 3; word++) {
+			const uint64_t player_missile0 = player0.bits[word] | missile0.bits[word];
+			const uint64_t player_missile1 = player1.bits[word] | missile1.bits[word];
+			uint64_t chooses_player_missile0, chooses_player_missile1, chooses_playfield_ball;
+
+			switch(playfield_priority_) {
+				case PlayfieldPriority::Standard:
+					chooses_player_missile0 = player_missile0;
+					chooses_player_missile1 = player_missile1 & ~chooses_player_missile0;
+					chooses_playfield_ball = (playfield.bits[word] | ball.bits[word]) & ~(chooses_player_missile0 | chooses_player_missile1);
+				break;
+				case PlayfieldPriority::Score:
+					chooses_player_missile0 = player_missile0 | (playfield.bits[word] & score_left_half[word]);
+					chooses_player_missile1 = (player_missile1 | (playfield.bits[word] & ~score_left_half[word])) & ~chooses_player_missile0;
+					chooses_playfield_ball = ball.bits[word] & ~(chooses_player_missile0 | chooses_player_missile1);
+				break;
+				default:
+					chooses_playfield_ball = playfield.bits[word] | ball.bits[word];
+					chooses_player_missile0 = player_missile0 & ~chooses_playfield_ball;
+					chooses_player_missile1 = player_missile1 & ~(chooses_playfield_ball | chooses_player_missile0);
+				break;
+			}
+
+			colour_low[word] = chooses_playfield_ball | chooses_player_missile1;
+			colour_high[word] = chooses_player_missile0 | chooses_player_missile1;
+		}
+
+		// Output two pixels at a time, indexing by two bits from each of colour_low and colour_high.
+		uint16_t pairs[16][2];
+		for(int c = 0; c < 16; c++) {
+			pairs[c][0] = colour_palette_[(c & 1) | ((c >> 1) & 2)].luminance_phase;
+			pairs[c][1] = colour_palette_[((c >> 1) & 1) | ((c >> 2) & 2)].luminance_phase;
+		}
+		uint16_t *target = pixels;
+		for(int word = 0; word < 3; word++) {
+			uint64_t low = colour_low[word], high = colour_high[word];
+			for(int c = 0; c < (word < 2 ? 32 : 16); c++) {
+				memcpy(target, pairs[(low & 3) | ((high & 3) << 2)], sizeof(pairs[0]));
+				target += 2;
+				low >>= 2;
+				high >>= 2;
+			}
+		}
+	}
+	crt_.output_data(320, 160);
+}
+
 // MARK: - Playfield output
 
 void TIA::draw_playfield(int start, int end) {
@@ -677,6 +795,66 @@ template<class T> void TIA::draw_object_visible(T &object, const uint8_t collisi
 	}
 }
 
+template<class T> void TIA::draw_object_line(T &object, LineMask &target) {
+	// This is draw_object_visible for an entire line of a stationary object, with nothing to enqueue.
+	int start = 0;
+	while(start < 160) {
+		int next_copy = 160;
+		int next_copy_id = 0;
+		if(object.copy_flags) {
+			if(object.position < 16 && object.copy_flags&1) {
+				next_copy = 16;
+				next_copy_id = 1;
+			} else if(object.position < 32 && object.copy_flags&2) {
+				next_copy = 32;
+				next_copy_id = 2;
+			} else if(object.position < 64 && object.copy_flags&4) {
+				next_copy = 64;
+				next_copy_id = 3;
+			}
+		}
+
+		const int next_copy_time = start + next_copy - object.position;
+		const int next_event_time = std::min(next_copy_time, 160);
+		const int length = next_event_time - start;
+
+		object.output_pixels(target, start, length, start + first_pixel_cycle - 4);
+
+		object.position = (object.position + length) % 160;
+		start = next_event_time;
+		if(start == next_copy_time) {
+			object.reset_pixels(next_copy_id);
+		}
+	}
+}
+
+void TIA::Player::output_pixels(LineMask &target, const int start, const int count, int from_horizontal_counter) {
+	const uint8_t pixels = graphic[graphic_index];
+	if(pixel_position != 32 && pixels) {
+		if(!(pixel_position & (adder - 1))) {
+			// Use a prebuilt pattern for the whole copy, minus any pixels already output.
+			const uint8_t ordered_pixels = reverse_mask ? reverse_table[pixels] : pixels;
+			uint64_t pattern;
+			switch(adder) {
+				default:	pattern = ordered_pixels;						break;
+				case 2:		pattern = doubled_table[ordered_pixels];		break;
+				case 1:		pattern = quadrupled_table[ordered_pixels];	break;
+			}
+			pattern >>= pixel_position / adder;
+			if(count < 32) pattern &= (uint64_t(1) << count) - 1;
+			target.set_bits(start, pattern);
+		} else {
+			int output_pixel_position = pixel_position;
+			for(int x = start; output_pixel_position < 32 && x < start + count; x++) {
+				const int shift = (output_pixel_position >> 2) ^ reverse_mask;
+				if((pixels >> shift)&1) target.set(x, x + 1);
+				output_pixel_position += adder;
+			}
+		}
+	}
+	skip_pixels(count, from_horizontal_counter);
+}
+
 // MARK: - Missile drawing
 
 void TIA::draw_missile(Missile &missile, Player &player, const uint8_t collision_identity, int start, int end) {
@@ -139,6 +139,31 @@ class TIA {
 				// background_[1] on the right; otherwise background_[0] will be
 				// output twice.
 
+		// a bit per pixel across the 160 pixels of a line, with the leftmost pixel in bit 0 of bits[0];
+		// used to compose whole lines at once, when nothing changes part way through
+		struct LineMask {
+			uint64_t bits[3] = {0, 0, 0};
+
+			inline void set(int start, int end) {
+				while(start < end) {
+					const int shift = start & 63;
+					const int length = std::min(end - start, 64 - shift);
+					bits[start >> 6] |= (~uint64_t(0) >> (64 - length)) << shift;
+					start += length;
+				}
+			}
+
+			inline void set_bits(int start, uint64_t pattern) {
+				const int shift = start & 63;
+				bits[start >> 6] |= pattern << shift;
+				if(shift && start < 128) bits[(start >> 6) + 1] |= pattern >> (64 - shift);
+			}
+
+			inline bool intersects(const LineMask &rhs) const {
+				return (bits[0] & rhs.bits[0]) | (bits[1] & rhs.bits[1]) | (bits[2] & rhs.bits[2]);
+			}
+		};
+
 		// objects
 		template<class T> struct Object {
 			// the two programmer-set values
@@ -184,6 +209,8 @@ class TIA {
 				skip_pixels(count, from_horizontal_counter);
 			}
 
+			void output_pixels(LineMask &target, const int start, const int count, int from_horizontal_counter);
+
 			void dequeue_pixels(uint8_t *const target, const uint8_t collision_identity, const int time_now) {
 				while(queue_read_pointer_ != queue_write_pointer_) {
 					uint8_t *const start_ptr = &target[queue_[queue_read_pointer_].start];
@@ -200,6 +227,10 @@ class TIA {
 				}
 			}
 
+			bool has_queued_pixels() const {
+				return queue_read_pointer_ != queue_write_pointer_;
+			}
+
 			void enqueue_pixels(const int start, const int end, int from_horizontal_counter) {
 				queue_[queue_write_pointer_].start = start;
 				queue_[queue_write_pointer_].end = end;
@@ -257,6 +288,12 @@ class TIA {
 				}
 			}
 
+			inline void output_pixels(LineMask &target, const int start, const int count, [[maybe_unused]] int from_horizontal_counter) {
+				const int length = std::min(pixel_position, count);
+				target.set(start, start + length);
+				pixel_position -= length;
+			}
+
 			void dequeue_pixels([[maybe_unused]] uint8_t *const target, [[maybe_unused]] uint8_t collision_identity, [[maybe_unused]] int time_now) {}
 			void enqueue_pixels([[maybe_unused]] int start, [[maybe_unused]] int end, [[maybe_unused]] int from_horizontal_counter) {}
 		};
@@ -275,6 +312,15 @@ class TIA {
 					skip_pixels(count, from_horizontal_counter);
 				}
 			}
+
+			inline void output_pixels(LineMask &target, const int start, const int count, int from_horizontal_counter) {
+				if(!pixel_position) return;
+				if(enabled && !locked_to_player) {
+					HorizontalRun::output_pixels(target, start, count, from_horizontal_counter);
+				} else {
+					skip_pixels(count, from_horizontal_counter);
+				}
+			}
 		} missile_[2];
 
 		// ball state
@@ -291,6 +337,15 @@ class TIA {
 					skip_pixels(count, from_horizontal_counter);
 				}
 			}
+
+			inline void output_pixels(LineMask &target, const int start, const int count, int from_horizontal_counter) {
+				if(!pixel_position) return;
+				if(enabled[enabled_index]) {
+					HorizontalRun::output_pixels(target, start, count, from_horizontal_counter);
+				} else {
+					skip_pixels(count, from_horizontal_counter);
+				}
+			}
 		} ball_;
 
 		// motion
@@ -304,6 +359,10 @@ class TIA {
 		template<class T> void draw_object_visible(T &, const uint8_t collision_identity, int start, int end, int time_now);
 		inline void draw_playfield(int start, int end);
 
+		// whole-line drawing, for lines with no motion and no missile locked to its player
+		template<class T> void draw_object_line(T &, LineMask &);
+		inline void output_line_from_masks();
+
 		inline void output_for_cycles(int number_of_cycles);
 		inline void output_line();
 
@@ -410,12 +410,12 @@ class ConcreteMachine:
 				break;
 				case Microcycle::SelectWord:
 					if(address >= video_range_.low_address && address < video_range_.high_address)
-						video_.flush();
+						video_->did_write(address);
 					*reinterpret_cast<uint16_t *>(&memory[address]) = cycle.value->full;
 				break;
 				case Microcycle::SelectByte:
 					if(address >= video_range_.low_address && address < video_range_.high_address)
-						video_.flush();
+						video_->did_write(address);
 					memory[address] = cycle.value->halves.low;
 				break;
 			}
@@ -499,6 +499,7 @@ class ConcreteMachine:
 		HalfCycles cycles_since_audio_update_;
 
 		JustInTimeActor<DMAController> dma_;
+		bool allow_fast_disk_reading_ = false;
 
 		HalfCycles cycles_since_ikbd_update_;
 		IntelligentKeyboard ikbd_;
@@ -552,6 +553,8 @@ class ConcreteMachine:
 			// that's implemented, just offers magical zero-cost DMA insertion and
 			// extrication.
 			if(dma_->get_bus_request_line()) {
+				// DMA writes to RAM directly, so might change anything that's on display.
+				video_->did_write(video_range_.low_address);
 				dma_->bus_grant(reinterpret_cast<uint16_t *>(ram_.data()), ram_.size() >> 1);
 			}
 		}
@@ -678,12 +681,15 @@ class ConcreteMachine:
 		std::unique_ptr<Reflection::Struct> get_options() final {
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->output = get_video_signal_configurable();
+			options->quickload = allow_fast_disk_reading_;
 			return options;
 		}
 
 		void set_options(const std::unique_ptr<Reflection::Struct> &str) final {
 			const auto options = dynamic_cast<Options *>(str.get());
 			set_video_signal_configurable(options->output);
+			allow_fast_disk_reading_ = options->quickload;
+			dma_->set_allows_direct_reading(allow_fast_disk_reading_);
 		}
 };
 
@@ -258,3 +258,7 @@ ClockingHint::Preference DMAController::preferred_clocking() const {
 void DMAController::set_activity_observer(Activity::Observer *observer) {
 	fdc_.set_activity_observer(observer);
 }
+
+void DMAController::set_allows_direct_reading(bool allows_direct_reading) {
+	fdc_.set_allows_direct_reading(allows_direct_reading);
+}
@@ -49,6 +49,9 @@ class DMAController: public WD::WD1770::Delegate, public ClockingHint::Source, p
 
 		void set_activity_observer(Activity::Observer *observer);
 
+		/// Enables or disables reading of sector-image tracks directly; see WD::WD1770::set_allows_direct_reading.
+		void set_allows_direct_reading(bool);
+
 		// ClockingHint::Source.
 		ClockingHint::Preference preferred_clocking() const final;
 
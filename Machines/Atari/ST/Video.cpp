@@ -11,8 +11,17 @@
 #include "../../../Outputs/Log.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ST_USE_SSSE3
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define ST_USE_NEON
+#endif
+
 #define CYCLE(x)	((x) * 2)
 
 using namespace Atari::ST;
@@ -114,6 +123,8 @@ const int vsync_delay_period = hsync_delay_period;	// Signal vsync with the same
 
 const int load_delay_period = CYCLE(4);		// Amount of time after DE that observed DE changes. NB: HACK HERE. This currently incorporates the MFP recognition delay. MUST FIX.
 
+const int shifter_duration = 32;			// Amount of output time that a single load of the shifter lasts, in any bpp.
+
 // "VSYNC starts 104 cycles after the start of the previous line's HSYNC, so that's 4 cycles before DE would be activated. ";
 // that's an inconsistent statement since it would imply VSYNC at +54, which is 2 cycles before DE in 60Hz mode and 6 before
 // in 50Hz mode. I've gone with 56, to be four cycles ahead of DE in 50Hz mode.
@@ -132,6 +143,7 @@ Video::Video() :
 
 void Video::set_ram(uint16_t *ram, size_t) {
 	ram_ = ram;
+	write_tracker_.set_range(size_t(previous_base_address_), size_t(get_memory_access_range().high_address));
 }
 
 void Video::set_scan_target(Outputs::Display::ScanTarget *scan_target) {
@@ -154,6 +166,11 @@ void Video::run_for(HalfCycles duration) {
 	int integer_duration = int(duration.as_integral());
 	assert(integer_duration >= 0);
 
+	// Any change since the current frame began means that it won't be a repeat.
+	if(write_tracker_.has_changed()) {
+		crt_.set_is_repeating_frame(false);
+	}
+
 	while(integer_duration) {
 		const auto horizontal_timings = horizontal_parameters(field_frequency_);
 		const auto vertical_timings = vertical_parameters(field_frequency_);
@@ -318,6 +335,12 @@ void Video::run_for(HalfCycles duration) {
 			x_ = 0;
 			vertical_ = next_vertical_;
 			y_ = next_y_;
+
+			// If nothing changed during the frame just output, and nothing changes during
+			// the next, then the next will be identical.
+			if(!y_) {
+				crt_.set_is_repeating_frame(write_tracker_.begin_frame());
+			}
 		}
 
 		// The address is reloaded during the entire period of vertical sync.
@@ -331,6 +354,9 @@ void Video::run_for(HalfCycles duration) {
 				if(range_observer_) {
 					range_observer_->video_did_change_access_range(this);
 				}
+
+				const auto range = get_memory_access_range();
+				write_tracker_.set_range(range.low_address, range.high_address);
 			}
 		}
 
@@ -489,12 +515,17 @@ void Video::write(int address, uint16_t value) {
 		// Sync mode and pixel mode.
 		case 0x05:
 			// Writes to sync mode have a one-cycle delay in effect.
+			//
+			// Writes that don't change anything are common, e.g. as part of a regular
+			// interrupt handler, so don't prevent repetition of the current frame.
+			if(value != sync_mode_) write_tracker_.did_change();
 			deferrer_.defer(HalfCycles(2), [this, value] {
 				sync_mode_ = value;
 				update_output_mode();
 			});
 		break;
 		case 0x30:
+			if(value != video_mode_) write_tracker_.did_change();
 			video_mode_ = value;
 			update_output_mode();
 		break;
@@ -504,6 +535,8 @@ void Video::write(int address, uint16_t value) {
 		case 0x24:	case 0x25:	case 0x26:	case 0x27:
 		case 0x28:	case 0x29:	case 0x2a:	case 0x2b:
 		case 0x2c:	case 0x2d:	case 0x2e:	case 0x2f: {
+			if(value != raw_palette_[address - 0x20]) write_tracker_.did_change();
+			video_stream_.will_change_palette();
 			if(address == 0x20) video_stream_.will_change_border_colour();
 
 			raw_palette_[address - 0x20] = value;
@@ -593,8 +626,9 @@ void Video::VideoStream::generate(int duration, OutputMode mode, bool is_termina
 		return;
 	}
 
-	// If the shifter is empty, accumulate in duration_ a promise to draw border later.
-	if(!output_shifter_) {
+	// If the shifter is empty, and not merely awaiting the output of pixels already
+	// accepted, accumulate in duration_ a promise to draw border later.
+	if(!output_shifter_ && !pending_pixel_duration_) {
 		if(pixel_pointer_) {
 			flush_pixels();
 		}
@@ -614,8 +648,12 @@ void Video::VideoStream::generate(int duration, OutputMode mode, bool is_termina
 		flush_border();
 	}
 
-	// Time to do some pixels!
-	output_pixels(duration);
+	// Time to do some pixels! Defer them until the shifter has run out, so that its entire
+	// contents can be converted together, unless this is the end of the run.
+	pending_pixel_duration_ += duration;
+	if(pending_pixel_duration_ >= shifter_duration || is_terminal) {
+		flush_pending_pixels();
+	}
 
 	// If was terminal, make sure any transient storage is output.
 	if(is_terminal) {
@@ -623,6 +661,17 @@ void Video::VideoStream::generate(int duration, OutputMode mode, bool is_termina
 	}
 }
 
+void Video::VideoStream::flush_pending_pixels() {
+	if(pending_pixel_duration_) {
+		output_pixels(pending_pixel_duration_);
+		pending_pixel_duration_ = 0;
+	}
+}
+
+void Video::VideoStream::will_change_palette() {
+	flush_pending_pixels();
+}
+
 void Video::VideoStream::will_change_border_colour() {
 	// Flush the accumulated border if it'd be adversely affected.
 	if(duration_ && output_mode_ == OutputMode::Pixels) {
@@ -640,11 +689,156 @@ void Video::VideoStream::flush_border() {
 }
 
 namespace {
-#if TARGET_RT_BIG_ENDIAN
-	constexpr int upper = 0;
-#else
-	constexpr int upper = 1;
+
+/*!
+	The shifter can be thought of as four 16-bit planes, each supplying one bit of each pixel's
+	palette index with the leftmost pixel in the most-significant bit.
+
+	In 4bpp mode each plane is one word of the shifter, and each shifts independently.
+	In 2bpp mode there are two 32-bit planes, each formed of alternate words.
+
+	Either way, pixels are converted sixteen at a time from planes to palette indices, and then to colours.
+*/
+
+/// @returns The bits of @c planes, a pair of 32-bit 2bpp planes as loaded into the shifter, shifted left by @c count.
+constexpr uint64_t shift_two_planes(uint64_t planes, int count) {
+	if(count >= 32) return 0;
+
+	// Reassemble each 32-bit plane from alternate words.
+	const uint32_t plane0 = uint32_t(((planes >> 32) & 0xffff0000) | ((planes >> 16) & 0xffff)) << count;
+	const uint32_t plane1 = uint32_t(((planes >> 16) & 0xffff0000) | (planes & 0xffff)) << count;
+
+	return
+		(uint64_t(plane0 & 0xffff0000) << 32) | (uint64_t(plane1 & 0xffff0000) << 16) |
+		(uint64_t(plane0 & 0xffff) << 16) | uint64_t(plane1 & 0xffff);
+}
+
+/// @returns The bits of @c planes, four 16-bit 4bpp planes, with each shifted left by @c count.
+constexpr uint64_t shift_four_planes(uint64_t planes, int count) {
+	if(count >= 16) return 0;
+	return (planes << count) & ((0xffffull << count) & 0xffff) * 0x0001'0001'0001'0001;
+}
+
+/// Maps from a byte to eight 4-bit nibbles, each of which is 0 or 1, with the byte's most significant
+/// bit mapping to the most significant nibble.
+constexpr std::array<uint32_t, 256> nibble_spread = [] {
+	std::array<uint32_t, 256> table{};
+	for(int byte = 0; byte < 256; byte++) {
+		for(int bit = 0; bit < 8; bit++) {
+			table[size_t(byte)] |= uint32_t((byte >> bit) & 1) << (bit * 4);
+		}
+	}
+	return table;
+}();
+
+void planes_to_colours_scalar(uint64_t planes, const uint16_t *palette, uint16_t *target) {
+	const auto spread = [](uint64_t plane) {
+		return (uint64_t(nibble_spread[(plane >> 8) & 0xff]) << 32) | nibble_spread[plane & 0xff];
+	};
+	const uint64_t indices =
+		spread(planes >> 48) | (spread(planes >> 32) << 1) | (spread(planes >> 16) << 2) | (spread(planes) << 3);
+
+	for(int c = 0; c < 16; c++) {
+		target[c] = palette[(indices >> (60 - c*4)) & 15];
+	}
+}
+
+#ifdef ST_USE_SSSE3
+
+/// @returns 0xff in each byte that corresponds to a set bit of @c plane, ordered as pixels.
+__attribute__((target("ssse3"))) inline __m128i expand_plane(uint64_t plane) {
+	const __m128i bits = _mm_setr_epi8(
+		char(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+		char(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+	const __m128i bytes = _mm_unpacklo_epi64(_mm_set1_epi8(char(plane >> 8)), _mm_set1_epi8(char(plane)));
+	return _mm_cmpeq_epi8(_mm_and_si128(bytes, bits), bits);
+}
+
+__attribute__((target("ssse3"))) void planes_to_colours_ssse3(uint64_t planes, const uint16_t *palette, uint16_t *target) {
+	// Form a palette index in each byte.
+	const __m128i indices = _mm_or_si128(
+		_mm_or_si128(
+			_mm_and_si128(expand_plane(planes >> 48), _mm_set1_epi8(1)),
+			_mm_and_si128(expand_plane(planes >> 32), _mm_set1_epi8(2))
+		),
+		_mm_or_si128(
+			_mm_and_si128(expand_plane(planes >> 16), _mm_set1_epi8(4)),
+			_mm_and_si128(expand_plane(planes), _mm_set1_epi8(8))
+		)
+	);
+
+	// Split the palette into low and high bytes, look up each and reinterleave.
+	const __m128i low_bytes = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i high_bytes = _mm_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i palette0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(palette));
+	const __m128i palette1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(palette + 8));
+
+	const __m128i lows = _mm_shuffle_epi8(
+		_mm_unpacklo_epi64(_mm_shuffle_epi8(palette0, low_bytes), _mm_shuffle_epi8(palette1, low_bytes)),
+		indices);
+	const __m128i highs = _mm_shuffle_epi8(
+		_mm_unpacklo_epi64(_mm_shuffle_epi8(palette0, high_bytes), _mm_shuffle_epi8(palette1, high_bytes)),
+		indices);
+
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(target), _mm_unpacklo_epi8(lows, highs));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(target + 8), _mm_unpackhi_epi8(lows, highs));
+}
+
+bool has_ssse3() {
+	static const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+	return has_ssse3;
+}
+
+#endif
+
+#ifdef ST_USE_NEON
+
+/// @returns 0xff in each byte that corresponds to a set bit of @c plane, ordered as pixels.
+inline uint8x16_t expand_plane(uint64_t plane) {
+	static constexpr uint8_t bits[] = {
+		0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+		0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+	const uint8x16_t bytes = vcombine_u8(vdup_n_u8(uint8_t(plane >> 8)), vdup_n_u8(uint8_t(plane)));
+	return vtstq_u8(bytes, vld1q_u8(bits));
+}
+
+void planes_to_colours_neon(uint64_t planes, const uint16_t *palette, uint16_t *target) {
+	// Form a palette index in each byte.
+	const uint8x16_t indices = vorrq_u8(
+		vorrq_u8(
+			vandq_u8(expand_plane(planes >> 48), vdupq_n_u8(1)),
+			vandq_u8(expand_plane(planes >> 32), vdupq_n_u8(2))
+		),
+		vorrq_u8(
+			vandq_u8(expand_plane(planes >> 16), vdupq_n_u8(4)),
+			vandq_u8(expand_plane(planes), vdupq_n_u8(8))
+		)
+	);
+
+	// Load the palette as separate low and high bytes, look up each and store reinterleaved.
+	const uint8x16x2_t colours = vld2q_u8(reinterpret_cast<const uint8_t *>(palette));
+	uint8x16x2_t output;
+	output.val[0] = vqtbl1q_u8(colours.val[0], indices);
+	output.val[1] = vqtbl1q_u8(colours.val[1], indices);
+	vst2q_u8(reinterpret_cast<uint8_t *>(target), output);
+}
+
+#endif
+
+/// Writes to @c target the sixteen colours described by @c planes, four 16-bit planes in which the most significant provides bit 0 of each palette index.
+void planes_to_colours(uint64_t planes, const uint16_t *palette, uint16_t *target) {
+#if defined(ST_USE_SSSE3)
+	if(has_ssse3()) {
+		planes_to_colours_ssse3(planes, palette, target);
+		return;
+	}
+#elif defined(ST_USE_NEON)
+	planes_to_colours_neon(planes, palette, target);
+	return;
 #endif
+	planes_to_colours_scalar(planes, palette, target);
+}
+
 }
 
 void Video::VideoStream::shift(int duration) {
@@ -653,22 +847,14 @@ void Video::VideoStream::shift(int duration) {
 			output_shifter_ <<= (duration << 1);
 		break;
 		case OutputBpp::Two:
-			while(duration--) {
-				shifter_halves_[upper] = (shifter_halves_[upper] << 1) & 0xfffefffe;
-				shifter_halves_[upper] |= (shifter_halves_[upper^1] & 0x80008000) >> 15;
-				shifter_halves_[upper^1] = (shifter_halves_[upper^1] << 1) & 0xfffefffe;
-			}
+			output_shifter_ = shift_two_planes(output_shifter_, duration);
 		break;
 		case OutputBpp::Four:
-			while(duration) {
-				output_shifter_ = (output_shifter_ << 1) & 0xfffefffefffefffe;
-				duration -= 2;
-			}
+			output_shifter_ = shift_four_planes(output_shifter_, (duration + 1) >> 1);
 		break;
 	}
 }
 
-// TODO: turn this into a template on current BPP, perhaps? Would avoid reevaluation of the conditional.
 void Video::VideoStream::output_pixels(int duration) {
 	constexpr int allocation_size = 352;	// i.e. 320 plus a spare 32.
 
@@ -703,33 +889,29 @@ void Video::VideoStream::output_pixels(int duration) {
 			break;
 
 			case OutputBpp::Two:
-				while(pixels_to_draw--) {
-					pixel_buffer_[pixel_pointer_] = palette_[
-						((output_shifter_ >> 63) & 1) |
-						((output_shifter_ >> 46) & 2)
-					];
-					// This ensures that the top two words shift one to the left;
-					// their least significant bits are fed from the most significant bits
-					// of the bottom two words, respectively.
-					shifter_halves_[upper] = (shifter_halves_[upper] << 1) & 0xfffefffe;
-					shifter_halves_[upper] |= (shifter_halves_[upper^1] & 0x80008000) >> 15;
-					shifter_halves_[upper^1] = (shifter_halves_[upper^1] << 1) & 0xfffefffe;
-
-					++pixel_pointer_;
-				}
-			break;
-
 			case OutputBpp::Four:
-				while(pixels_to_draw--) {
-					pixel_buffer_[pixel_pointer_] = palette_[
-						((output_shifter_ >> 63) & 1) |
-						((output_shifter_ >> 46) & 2) |
-						((output_shifter_ >> 29) & 4) |
-						((output_shifter_ >> 12) & 8)
-					];
-					output_shifter_ = (output_shifter_ << 1) & 0xfffefffefffefffe;
-
-					++pixel_pointer_;
+				while(pixels_to_draw) {
+					// Convert sixteen pixels at a time. In 2bpp mode the top word of each plane is
+					// the upper word of each 32-bit half, and the other two planes are empty.
+					const uint64_t planes =
+						(bpp_ == OutputBpp::Four) ? output_shifter_ : (output_shifter_ & 0xffff'ffff'0000'0000);
+					const int count = std::min(pixels_to_draw, 16);
+
+					// Usually there's enough room to write all sixteen pixels directly, as a flush
+					// happens when fewer than 32 remain; if not then go via a local buffer.
+					if(pixel_pointer_ + 16 <= allocation_size) {
+						planes_to_colours(planes, palette_, &pixel_buffer_[pixel_pointer_]);
+					} else {
+						uint16_t colours[16];
+						planes_to_colours(planes, palette_, colours);
+						std::copy(colours, colours + count, &pixel_buffer_[pixel_pointer_]);
+					}
+
+					output_shifter_ = (bpp_ == OutputBpp::Four) ?
+						shift_four_planes(output_shifter_, count) :
+						shift_two_planes(output_shifter_, count);
+					pixel_pointer_ += count;
+					pixels_to_draw -= count;
 				}
 			break;
 		}
@@ -770,6 +952,7 @@ void Video::VideoStream::flush_pixels() {
 
 void Video::VideoStream::set_bpp(OutputBpp bpp) {
 	// Terminate the allocated block of memory (if any).
+	flush_pending_pixels();
 	flush_pixels();
 
 	// Reset the shifter.
@@ -781,6 +964,9 @@ void Video::VideoStream::set_bpp(OutputBpp bpp) {
 }
 
 void Video::VideoStream::load(uint64_t value) {
+	// Output whatever is pending from the current contents of the shifter.
+	flush_pending_pixels();
+
 	// In 1bpp mode, a 0 bit is white and a 1 bit is black.
 	// Invert the input so that the 'just output the border colour
 	// when the shifter is empty' optimisation works.
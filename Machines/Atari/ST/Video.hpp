@@ -12,6 +12,7 @@
 #include "../../../Outputs/CRT/CRT.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 #include "../../../ClockReceiver/DeferredQueue.hpp"
+#include "../../Utility/WriteTracker.hpp"
 
 #include <vector>
 
@@ -125,6 +126,14 @@ class Video {
 		*/
 		Range get_memory_access_range();
 
+		/*!
+			Notifies the video of a write to @c address, allowing it to spot frames that are repeats
+			of the one before. The caller should ensure that the video is up to date first.
+		*/
+		void did_write(uint32_t address) {
+			write_tracker_.did_write(address);
+		}
+
 	private:
 		DeferredQueue<HalfCycles> deferrer_;
 
@@ -137,6 +146,8 @@ class Video {
 		int previous_base_address_ = 0;
 		int current_address_ = 0;
 
+		Memory::WriteTracker write_tracker_;
+
 		uint16_t *ram_ = nullptr;
 
 		int x_ = 0, y_ = 0, next_y_ = 0;
@@ -206,6 +217,10 @@ class Video {
 				/// is used to help elide border-regio output.
 				void will_change_border_colour();
 
+				/// Warns the video stream that some part of the palette will change momentarily, so that any
+				/// pixels that it has deferred are output using the old colours.
+				void will_change_palette();
+
 				/// Loads 64 bits into the Shifter. The shifter shifts continuously. If you also declare
 				/// a pixels region then whatever is being shifted will reach the display, in a form that
 				/// depends on the current output BPP.
@@ -223,19 +238,21 @@ class Video {
 				void flush_pixels();
 				void shift(int duration);
 				void output_pixels(int duration);
+				void flush_pending_pixels();
 
 				// Internal state that is a function of output intent.
 				int duration_ = 0;
 				OutputMode output_mode_ = OutputMode::Sync;
 				OutputBpp bpp_ = OutputBpp::Four;
-				union {
-					uint64_t output_shifter_;
-					uint32_t shifter_halves_[2];
-				};
+				uint64_t output_shifter_ = 0;
 
 				// Internal state for handling output serialisation.
 				uint16_t *pixel_buffer_ = nullptr;
 				int pixel_pointer_ = 0;
+
+				// Pixel time that has been accepted but not yet converted from the shifter; this
+				// allows whole loads of the shifter to be converted at once.
+				int pending_pixel_duration_ = 0;
 		} video_stream_;
 
 		/// Contains copies of the various observeable fields, after the relevant propagation delay.
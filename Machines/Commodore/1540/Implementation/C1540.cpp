@@ -8,6 +8,7 @@
 
 #include "../C1540.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <string>
@@ -148,6 +149,31 @@ void MachineBase::process_input_bit(int value) {
 	else m6502_.set_overflow_line(false);
 }
 
+void MachineBase::process_input_bits(int value, int count) {
+	if(value || !count) {
+		Storage::Disk::Controller::process_input_bits(value, count);
+		return;
+	}
+
+	// A zero can't complete a sync, so proceed directly from one byte boundary to the next.
+	drive_VIA_port_handler_.set_sync_detected(false);
+	while(count) {
+		const int step = std::min(count, 8 - bit_window_offset_);
+		shift_register_ <<= step;
+		bit_window_offset_ += step;
+		count -= step;
+
+		if(bit_window_offset_ == 8) {
+			drive_VIA_port_handler_.set_data_input(uint8_t(shift_register_));
+			bit_window_offset_ = 0;
+			if(drive_VIA_port_handler_.get_should_set_overflow()) {
+				m6502_.set_overflow_line(true);
+			}
+		}
+		else m6502_.set_overflow_line(false);
+	}
+}
+
 // the 1540 does not recognise index holes
 void MachineBase::process_index_hole()	{}
 
@@ -155,8 +155,9 @@ class MachineBase:
 		MOS::MOS6522::MOS6522<DriveVIA> drive_VIA_;
 		MOS::MOS6522::MOS6522<SerialPortVIA> serial_port_VIA_;
 
-		int shift_register_ = 0, bit_window_offset_;
+		int shift_register_ = 0, bit_window_offset_ = 0;
 		virtual void process_input_bit(int value);
+		virtual void process_input_bits(int value, int count);
 		virtual void process_index_hole();
 };
 
@@ -150,7 +150,7 @@ class ConcreteMachine:
 
 		bool insert_media(const Analyser::Static::Media &media) final {
 			if(!media.tapes.empty()) {
-				tape_.set_tape(media.tapes.front());
+				tape_.set_tape(media.tapes.front(), true);
 			}
 			set_use_fast_tape_hack();
 
@@ -0,0 +1,59 @@
+//
+//  PaletteTables.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Machines_Electron_PaletteTables_hpp
+#define Machines_Electron_PaletteTables_hpp
+
+#include "../../Outputs/PaletteExpansionCache.hpp"
+
+#include <cstdint>
+
+namespace Electron {
+
+// Byte to pixel mappings for each of the possible bit depths; pixel n of each byte
+// is formed from its top bits after shifting left by n.
+struct OneBitIndexer {
+	static constexpr int index(uint8_t byte, int pixel) {
+		return ((byte << pixel) & 0x80) >> 4;
+	}
+};
+struct TwoBitIndexer {
+	static constexpr int index(uint8_t byte, int pixel) {
+		const int shifted = byte << pixel;
+		return ((shifted & 0x80) >> 4) | ((shifted & 0x08) >> 2);
+	}
+};
+struct FourBitIndexer {
+	static constexpr int index(uint8_t byte, int pixel) {
+		const int shifted = byte << pixel;
+		return ((shifted & 0x80) >> 4) | ((shifted & 0x20) >> 3) | ((shifted & 0x08) >> 2) | ((shifted & 0x02) >> 1);
+	}
+};
+
+/// The byte to pixels tables for each of the possible combinations of bit depth and column count.
+/// Each is regenerated only upon first use after a palette change.
+struct PaletteTables {
+	Outputs::Display::PaletteExpansionCache<uint32_t, OneBitIndexer> forty1bpp;
+	Outputs::Display::PaletteExpansionCache<uint16_t, TwoBitIndexer> forty2bpp;
+	Outputs::Display::PaletteExpansionCache<uint64_t, OneBitIndexer> eighty1bpp;
+	Outputs::Display::PaletteExpansionCache<uint32_t, TwoBitIndexer> eighty2bpp;
+	Outputs::Display::PaletteExpansionCache<uint16_t, FourBitIndexer> eighty4bpp;
+
+	/// Marks all tables as requiring regeneration.
+	void invalidate() {
+		forty1bpp.invalidate();
+		forty2bpp.invalidate();
+		eighty1bpp.invalidate();
+		eighty2bpp.invalidate();
+		eighty4bpp.invalidate();
+	}
+};
+
+}
+
+#endif /* Machines_Electron_PaletteTables_hpp */
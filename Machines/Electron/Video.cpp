@@ -134,9 +134,10 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 		switch(screen_mode_) {
 			case 0: case 3:
 				if(initial_output_target_) {
+					const uint64_t *const table = palette_tables_.eighty1bpp.get(palette_);
 					while(number_of_cycles--) {
 						get_pixel();
-						*reinterpret_cast<uint64_t *>(current_output_target_) = palette_tables_.eighty1bpp[last_pixel_byte_];
+						*reinterpret_cast<uint64_t *>(current_output_target_) = table[last_pixel_byte_];
 						current_output_target_ += 8;
 						current_pixel_column_++;
 					}
@@ -145,9 +146,10 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 
 			case 1:
 				if(initial_output_target_) {
+					const uint32_t *const table = palette_tables_.eighty2bpp.get(palette_);
 					while(number_of_cycles--) {
 						get_pixel();
-						*reinterpret_cast<uint32_t *>(current_output_target_) = palette_tables_.eighty2bpp[last_pixel_byte_];
+						*reinterpret_cast<uint32_t *>(current_output_target_) = table[last_pixel_byte_];
 						current_output_target_ += 4;
 						current_pixel_column_++;
 					}
@@ -156,9 +158,10 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 
 			case 2:
 				if(initial_output_target_) {
+					const uint16_t *const table = palette_tables_.eighty4bpp.get(palette_);
 					while(number_of_cycles--) {
 						get_pixel();
-						*reinterpret_cast<uint16_t *>(current_output_target_) = palette_tables_.eighty4bpp[last_pixel_byte_];
+						*reinterpret_cast<uint16_t *>(current_output_target_) = table[last_pixel_byte_];
 						current_output_target_ += 2;
 						current_pixel_column_++;
 					}
@@ -167,9 +170,10 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 
 			case 4: case 6:
 				if(initial_output_target_) {
+					const uint32_t *const table = palette_tables_.forty1bpp.get(palette_);
 					if(current_pixel_column_&1) {
 						last_pixel_byte_ <<= 4;
-						*reinterpret_cast<uint32_t *>(current_output_target_) = palette_tables_.forty1bpp[last_pixel_byte_];
+						*reinterpret_cast<uint32_t *>(current_output_target_) = table[last_pixel_byte_];
 						current_output_target_ += 4;
 
 						number_of_cycles--;
@@ -177,11 +181,11 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 					}
 					while(number_of_cycles > 1) {
 						get_pixel();
-						*reinterpret_cast<uint32_t *>(current_output_target_) = palette_tables_.forty1bpp[last_pixel_byte_];
+						*reinterpret_cast<uint32_t *>(current_output_target_) = table[last_pixel_byte_];
 						current_output_target_ += 4;
 
 						last_pixel_byte_ <<= 4;
-						*reinterpret_cast<uint32_t *>(current_output_target_) = palette_tables_.forty1bpp[last_pixel_byte_];
+						*reinterpret_cast<uint32_t *>(current_output_target_) = table[last_pixel_byte_];
 						current_output_target_ += 4;
 
 						number_of_cycles -= 2;
@@ -189,7 +193,7 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 					}
 					if(number_of_cycles) {
 						get_pixel();
-						*reinterpret_cast<uint32_t *>(current_output_target_) = palette_tables_.forty1bpp[last_pixel_byte_];
+						*reinterpret_cast<uint32_t *>(current_output_target_) = table[last_pixel_byte_];
 						current_output_target_ += 4;
 						current_pixel_column_++;
 					}
@@ -198,9 +202,10 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 
 			case 5:
 				if(initial_output_target_) {
+					const uint16_t *const table = palette_tables_.forty2bpp.get(palette_);
 					if(current_pixel_column_&1) {
 						last_pixel_byte_ <<= 2;
-						*reinterpret_cast<uint16_t *>(current_output_target_) = palette_tables_.forty2bpp[last_pixel_byte_];
+						*reinterpret_cast<uint16_t *>(current_output_target_) = table[last_pixel_byte_];
 						current_output_target_ += 2;
 
 						number_of_cycles--;
@@ -208,11 +213,11 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 					}
 					while(number_of_cycles > 1) {
 						get_pixel();
-						*reinterpret_cast<uint16_t *>(current_output_target_) = palette_tables_.forty2bpp[last_pixel_byte_];
+						*reinterpret_cast<uint16_t *>(current_output_target_) = table[last_pixel_byte_];
 						current_output_target_ += 2;
 
 						last_pixel_byte_ <<= 2;
-						*reinterpret_cast<uint16_t *>(current_output_target_) = palette_tables_.forty2bpp[last_pixel_byte_];
+						*reinterpret_cast<uint16_t *>(current_output_target_) = table[last_pixel_byte_];
 						current_output_target_ += 2;
 
 						number_of_cycles -= 2;
@@ -220,7 +225,7 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 					}
 					if(number_of_cycles) {
 						get_pixel();
-						*reinterpret_cast<uint16_t *>(current_output_target_) = palette_tables_.forty2bpp[last_pixel_byte_];
+						*reinterpret_cast<uint16_t *>(current_output_target_) = table[last_pixel_byte_];
 						current_output_target_ += 2;
 						current_pixel_column_++;
 					}
@@ -306,38 +311,7 @@ void VideoOutput::write(int address, uint8_t value) {
 				palette_[registers[index][1]]	= (palette_[registers[index][1]]&5)	| ((colour >> 1)&2);
 			}
 
-			// regenerate all palette tables for now
-			for(int byte = 0; byte < 256; byte++) {
-				uint8_t *target = reinterpret_cast<uint8_t *>(&palette_tables_.forty1bpp[byte]);
-				target[0] = palette_[(byte&0x80) >> 4];
-				target[1] = palette_[(byte&0x40) >> 3];
-				target[2] = palette_[(byte&0x20) >> 2];
-				target[3] = palette_[(byte&0x10) >> 1];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty2bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
-				target[2] = palette_[((byte&0x20) >> 2) | ((byte&0x02) >> 0)];
-				target[3] = palette_[((byte&0x10) >> 1) | ((byte&0x01) << 1)];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty1bpp[byte]);
-				target[0] = palette_[(byte&0x80) >> 4];
-				target[1] = palette_[(byte&0x40) >> 3];
-				target[2] = palette_[(byte&0x20) >> 2];
-				target[3] = palette_[(byte&0x10) >> 1];
-				target[4] = palette_[(byte&0x08) >> 0];
-				target[5] = palette_[(byte&0x04) << 1];
-				target[6] = palette_[(byte&0x02) << 2];
-				target[7] = palette_[(byte&0x01) << 3];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.forty2bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty4bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x20) >> 3) | ((byte&0x08) >> 2) | ((byte&0x02) >> 1)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x10) >> 2) | ((byte&0x04) >> 1) | ((byte&0x01) >> 0)];
-			}
+			palette_tables_.invalidate();
 		}
 		break;
 	}
@@ -12,6 +12,7 @@
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "Interrupts.hpp"
+#include "PaletteTables.hpp"
 
 #include <vector>
 
@@ -100,13 +101,8 @@ class VideoOutput {
 		uint16_t start_screen_address_ = 0;
 
 		uint8_t *ram_;
-		struct {
-			uint32_t forty1bpp[256];
-			uint16_t forty2bpp[256];
-			uint64_t eighty1bpp[256];
-			uint32_t eighty2bpp[256];
-			uint16_t eighty4bpp[256];
-		} palette_tables_;
+
+		PaletteTables palette_tables_;
 
 		// Display generation.
 		uint16_t start_line_address_ = 0;
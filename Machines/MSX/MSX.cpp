@@ -39,6 +39,7 @@
 #include "../../Outputs/Log.hpp"
 #include "../../Outputs/Speaker/Implementation/CompoundSource.hpp"
 #include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../Outputs/Speaker/Implementation/RegisterLog.hpp"
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
 
 #include "../../Configurable/StandardOptions.hpp"
@@ -148,6 +149,7 @@ class ConcreteMachine:
 			z80_(*this),
 			vdp_(TI::TMS::TMS9918A),
 			i8255_(i8255_port_handler_),
+			audio_log_(audio_queue_),
 			ay_(GI::AY38910::Personality::AY38910, audio_queue_),
 			audio_toggle_(audio_queue_),
 			scc_(audio_queue_),
@@ -162,6 +164,12 @@ class ConcreteMachine:
 
 			ay_.set_port_handler(&ay_port_handler_);
 			speaker_.set_input_rate(3579545.0f / 2.0f);
+
+			// Log all sound chip writes, to be replayed on the audio thread.
+			ay_.set_register_log(audio_log_);
+			audio_toggle_.set_register_log(audio_log_);
+			scc_.set_register_log(audio_log_);
+			speaker_.set_register_log(audio_log_);
 			tape_player_.set_clocking_hint_observer(this);
 
 			// Set the AY to 50% of available volume, the toggle to 10% and leave 40% for an SCC.
@@ -269,7 +277,7 @@ class ConcreteMachine:
 		}
 
 		~ConcreteMachine() {
-			audio_queue_.flush();
+			audio_log_.flush();
 		}
 
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
@@ -338,7 +346,7 @@ class ConcreteMachine:
 			}
 
 			if(!media.tapes.empty()) {
-				tape_player_.set_tape(media.tapes.front());
+				tape_player_.set_tape(media.tapes.front(), true);
 			}
 
 			if(!media.disks.empty()) {
@@ -622,7 +630,7 @@ class ConcreteMachine:
 		void flush() {
 			vdp_.flush();
 			update_audio();
-			audio_queue_.perform();
+			audio_log_.perform();
 		}
 
 		void set_keyboard_line(int line) {
@@ -688,7 +696,7 @@ class ConcreteMachine:
 			return dynamic_cast<DiskROM *>(memory_slots_[2].handler.get());
 		}
 		void update_audio() {
-			speaker_.run_for(audio_queue_, time_since_ay_update_.divide_cycles(Cycles(2)));
+			audio_log_.run_for(time_since_ay_update_.divide_cycles(Cycles(2)));
 		}
 
 		class i8255PortHandler: public Intel::i8255::PortHandler {
@@ -749,6 +757,7 @@ class ConcreteMachine:
 		Intel::i8255::i8255<i8255PortHandler> i8255_;
 
 		Concurrency::DeferringAsyncTaskQueue audio_queue_;
+		Outputs::Speaker::RegisterLog audio_log_;
 		GI::AY38910::AY38910<false> ay_;
 		Audio::Toggle audio_toggle_;
 		Konami::SCC scc_;
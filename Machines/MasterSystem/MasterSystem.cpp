@@ -22,6 +22,7 @@
 
 #include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
 #include "../../Outputs/Speaker/Implementation/CompoundSource.hpp"
+#include "../../Outputs/Speaker/Implementation/RegisterLog.hpp"
 
 #define LOG_PREFIX "[SMS] "
 #include "../../Outputs/Log.hpp"
@@ -95,6 +96,7 @@ class ConcreteMachine:
 			paging_scheme_(target.paging_scheme),
 			z80_(*this),
 			vdp_(tms_personality_for_model(target.model)),
+			audio_log_(audio_queue_),
 			sn76489_(
 				(target.model == Target::Model::SG1000) ? TI::SN76489::Personality::SN76489 : TI::SN76489::Personality::SMS,
 				audio_queue_,
@@ -174,6 +176,14 @@ class ConcreteMachine:
 			// TODO: this is disabled for now since it isn't applicable for the FM chip, I think.
 //			speaker_.set_high_frequency_cutoff(8000);
 
+			// Log all sound chip and mixer writes, to be replayed on the audio thread.
+			sn76489_.set_register_log(audio_log_);
+			opll_.set_register_log(audio_log_);
+			speaker_.set_register_log(audio_log_);
+			mixer_input_ = audio_log_.add_input(this, [](void *machine, uint16_t, uint8_t mode) {
+				static_cast<ConcreteMachine *>(machine)->apply_mixer_levels(mode);
+			});
+
 			// Set default mixer levels: FM off, SN full-throttle.
 			set_mixer_levels(0);
 
@@ -181,7 +191,7 @@ class ConcreteMachine:
 		}
 
 		~ConcreteMachine() {
-			audio_queue_.flush();
+			audio_log_.flush();
 		}
 
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
@@ -395,7 +405,7 @@ class ConcreteMachine:
 		void flush() {
 			vdp_.flush();
 			update_audio();
-			audio_queue_.perform();
+			audio_log_.perform();
 		}
 
 		const std::vector<std::unique_ptr<Inputs::Joystick>> &get_joysticks() final {
@@ -458,32 +468,34 @@ class ConcreteMachine:
 		}
 
 		inline void update_audio() {
-			speaker_.run_for(audio_queue_, time_since_sn76489_update_.divide_cycles(Cycles(audio_divider)));
+			audio_log_.run_for(time_since_sn76489_update_.divide_cycles(Cycles(audio_divider)));
 		}
 
 		void set_mixer_levels(uint8_t mode) {
 			// This is as per the audio control register;
 			// see https://www.smspower.org/Development/AudioControlPort
 			update_audio();
-			audio_queue_.defer([this, mode] {
-				switch(mode & 3) {
-					case 0:	// SN76489 only; the default.
-						mixer_.set_relative_volumes({1.0f, 0.0f});
-					break;
+			mixer_input_.post(0, mode);
+		}
 
-					case 1: // FM only.
-						mixer_.set_relative_volumes({0.0f, 1.0f});
-					break;
+		void apply_mixer_levels(uint8_t mode) {
+			switch(mode & 3) {
+				case 0:	// SN76489 only; the default.
+					mixer_.set_relative_volumes({1.0f, 0.0f});
+				break;
 
-					case 2: // No audio.
-						mixer_.set_relative_volumes({0.0f, 0.0f});
-					break;
+				case 1: // FM only.
+					mixer_.set_relative_volumes({0.0f, 1.0f});
+				break;
 
-					case 3: // Both FM and SN76489.
-						mixer_.set_relative_volumes({0.5f, 0.5f});
-					break;
-				}
-			});
+				case 2: // No audio.
+					mixer_.set_relative_volumes({0.0f, 0.0f});
+				break;
+
+				case 3: // Both FM and SN76489.
+					mixer_.set_relative_volumes({0.5f, 0.5f});
+				break;
+			}
 		}
 
 		using Target = Analyser::Static::Sega::Target;
@@ -494,6 +506,8 @@ class ConcreteMachine:
 		JustInTimeActor<TI::TMS::TMS9918> vdp_;
 
 		Concurrency::DeferringAsyncTaskQueue audio_queue_;
+		Outputs::Speaker::RegisterLog audio_log_;
+		Outputs::Speaker::RegisterLog::Input mixer_input_;
 		TI::SN76489 sn76489_;
 		Yamaha::OPL::OPLL opll_;
 		Outputs::Speaker::CompoundSource<decltype(sn76489_), decltype(opll_)> mixer_;
@@ -485,7 +485,10 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 					if(isReadOperation(operation))
 						*value = ram_[address];
 					else {
-						if(address >= 0x9800 && address <= 0xc000) update_video();
+						if(address >= 0x9800 && address <= 0xc000) {
+							update_video();
+							video_output_.did_write(address);
+						}
 						ram_[address] = *value;
 					}
 				}
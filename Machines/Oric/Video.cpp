@@ -34,6 +34,9 @@ VideoOutput::VideoOutput(uint8_t *memory) :
 	crt_.set_input_data_type(data_type_);
 	crt_.set_delegate(&frequency_mismatch_warner_);
 	update_crt_frequency();
+
+	// Text, character sets and the HIRES bitmap all lie within this range.
+	write_tracker_.set_range(0x9800, 0xc001);
 }
 
 void VideoOutput::register_crt_frequency_mismatch() {
@@ -117,6 +120,11 @@ void VideoOutput::run_for(const Cycles cycles) {
 #define clamp(action)	\
 	if(cycles_run_for <= number_of_cycles) { action; } else cycles_run_for = number_of_cycles;
 
+	// Any change since the current frame began means that it won't be a repeat.
+	if(write_tracker_.has_changed()) {
+		crt_.set_is_repeating_frame(false);
+	}
+
 	int number_of_cycles = int(cycles.as_integral());
 	while(number_of_cycles) {
 		int h_counter = counter_ & 63;
@@ -146,6 +154,11 @@ void VideoOutput::run_for(const Cycles cycles) {
 					v_sync_start_position_ = next_frame_is_sixty_hertz_ ? PAL60VSyncStartPosition : PAL50VSyncStartPosition;
 					v_sync_end_position_ = next_frame_is_sixty_hertz_ ? PAL60VSyncEndPosition : PAL50VSyncEndPosition;
 					counter_period_ = next_frame_is_sixty_hertz_ ? PAL60Period : PAL50Period;
+
+					// If nothing changed during the frame just output, and nothing changes during
+					// the next, then the next will be identical — unless it's the one on which
+					// blinking text changes phase.
+					crt_.set_is_repeating_frame(write_tracker_.begin_frame() && ((frame_counter_ + 1) & 31));
 				}
 			}
 
@@ -11,6 +11,7 @@
 
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../Utility/WriteTracker.hpp"
 
 #include <cstdint>
 #include <memory>
@@ -32,8 +33,15 @@ class VideoOutput {
 
 		void register_crt_frequency_mismatch();
 
+		/// Notifies the video of a write to @c address, allowing it to spot frames that are repeats of the one before.
+		/// The caller should ensure that the video is up to date first.
+		void did_write(uint16_t address) {
+			write_tracker_.did_write(address);
+		}
+
 	private:
 		uint8_t *ram_;
+		Memory::WriteTracker write_tracker_;
 		Outputs::CRT::CRT crt_;
 		Outputs::CRT::CRTFrequencyMismatchWarner<VideoOutput> frequency_mismatch_warner_;
 		bool crt_is_60Hz_ = false;
@@ -0,0 +1,68 @@
+//
+//  WriteTracker.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef WriteTracker_hpp
+#define WriteTracker_hpp
+
+#include <cstddef>
+
+namespace Memory {
+
+/*!
+	Records whether anything has been written to a nominated range of memory, to allow a video
+	generator that displays that range to spot frames that will be identical to their predecessors.
+
+	It is optional for a machine to use this: its bus should call @c did_write for every write to
+	memory that might be displayed. Its video generator should nominate the range it is displaying
+	via @c set_range and call @c did_change for any other change that affects output, such as to
+	the palette or mode.
+
+	If @c begin_frame returns @c true then nothing has changed since its previous call, so if
+	@c has_changed remains @c false then the new frame will be identical to the last.
+*/
+class WriteTracker {
+	public:
+		/// Sets the range of addresses, [@c begin, @c end), that is currently being displayed.
+		void set_range(std::size_t begin, std::size_t end) {
+			if(begin == begin_ && end - begin == length_) return;
+			begin_ = begin;
+			length_ = end - begin;
+			did_change();
+		}
+
+		/// Records a write to @c address.
+		void did_write(std::size_t address) {
+			// Unsigned arithmetic means that an address below begin_ will appear to be far beyond length_.
+			is_dirty_ |= (address - begin_) < length_;
+		}
+
+		/// Records a change to anything other than memory that would affect output.
+		void did_change() {
+			is_dirty_ = true;
+		}
+
+		/// @returns @c true if anything has changed since the most recent call to @c begin_frame; @c false otherwise.
+		bool has_changed() const {
+			return is_dirty_;
+		}
+
+		/// @returns @c true if nothing has changed since the previous call to @c begin_frame; @c false otherwise.
+		bool begin_frame() {
+			const bool is_unchanged = !is_dirty_;
+			is_dirty_ = false;
+			return is_unchanged;
+		}
+
+	private:
+		std::size_t begin_ = 0, length_ = 0;
+		bool is_dirty_ = true;
+};
+
+}
+
+#endif /* WriteTracker_hpp */
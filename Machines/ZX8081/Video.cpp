@@ -16,14 +16,14 @@ namespace {
 
 /*!
 	The number of bytes of PCM data to allocate at once; if/when more are required,
-	the class will simply allocate another batch.
+	the class will simply allocate another batch. Each byte holds eight pixels.
 */
-const std::size_t StandardAllocationSize = 320;
+const std::size_t StandardAllocationSize = 40;
 
 }
 
 Video::Video() :
-	crt_(207 * 2, 1, Outputs::Display::Type::PAL50, Outputs::Display::InputDataType::Luminance1) {
+	crt_(207 * 2, 1, Outputs::Display::Type::PAL50, Outputs::Display::InputDataType::PackedLuminance1) {
 
 	// Show only the centre 80% of the TV frame.
 	crt_.set_display_type(Outputs::Display::DisplayType::CompositeMonochrome);
@@ -49,10 +49,33 @@ void Video::flush(bool next_sync) {
 		if(line_data_) {
 			// If there is output data queued, output it either if it's being interrupted by
 			// sync, or if we're past its end anyway. Otherwise let it be.
-			int data_length = int(line_data_pointer_ - line_data_);
+			int data_length = int(line_data_pointer_ - line_data_) * 8;
 			if(data_length < int(time_since_update_.as_integral()) || next_sync) {
-				auto output_length = std::min(data_length, int(time_since_update_.as_integral()));
-				crt_.output_data(output_length);
+				const auto output_length = std::min(data_length, int(time_since_update_.as_integral()));
+				const auto whole_bytes = output_length >> 3;
+				uint8_t partial_byte = (output_length & 7) ? line_data_[whole_bytes] : 0;
+
+				if(whole_bytes) {
+					crt_.output_data(whole_bytes * 8, size_t(whole_bytes));
+				}
+
+				// Pixels are packed eight to a byte, so if sync cuts a byte short then output
+				// the pixels that remain as runs of solid colour.
+				int pixels = output_length & 7;
+				while(pixels) {
+					const uint8_t level = (partial_byte & 0x80) ? 0xff : 0x00;
+					int run = 0;
+					while(run < pixels && ((partial_byte & 0x80) ? 0xff : 0x00) == level) {
+						partial_byte <<= 1;
+						++run;
+					}
+
+					uint8_t *const level_pointer = crt_.begin_data(1);
+					if(level_pointer) *level_pointer = level;
+					crt_.output_data(run, 1);
+					pixels -= run;
+				}
+
 				line_data_pointer_ = line_data_ = nullptr;
 				time_since_update_ -= HalfCycles(output_length);
 			} else return;
@@ -90,19 +113,15 @@ void Video::output_byte(uint8_t byte) {
 	if(line_data_) {
 		// If the buffer is full, output it now and obtain a new one
 		if(line_data_pointer_ - line_data_ == StandardAllocationSize) {
-			crt_.output_data(StandardAllocationSize, StandardAllocationSize);
-			time_since_update_ -= StandardAllocationSize;
+			crt_.output_data(StandardAllocationSize * 8, StandardAllocationSize);
+			time_since_update_ -= StandardAllocationSize * 8;
 			line_data_pointer_ = line_data_ = crt_.begin_data(StandardAllocationSize);
 			if(!line_data_) return;
 		}
 
-		// Convert to one-byte-per-pixel where any non-zero value will act as white.
-		uint8_t mask = 0x80;
-		for(int c = 0; c < 8; c++) {
-			line_data_pointer_[c] = byte & mask;
-			mask >>= 1;
-		}
-		line_data_pointer_ += 8;
+		// Pixels are passed on as packed bits; a set bit is white.
+		*line_data_pointer_ = byte;
+		++line_data_pointer_;
 	}
 }
 
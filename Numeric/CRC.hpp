@@ -9,11 +9,73 @@
 #ifndef CRC_hpp
 #define CRC_hpp
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define CRC_USE_PCLMULQDQ
+#endif
+
 namespace CRC {
 
+#ifdef CRC_USE_PCLMULQDQ
+/*!
+	Multiplies the low quadword of @c accumulator by the low quadword of @c constants and the high by the high,
+	returning the exclusive OR of the two.
+*/
+__attribute__((target("pclmul,sse4.1"))) inline __m128i fold_128(__m128i accumulator, __m128i constants) {
+	return _mm_xor_si128(
+		_mm_clmulepi64_si128(accumulator, constants, 0x00),
+		_mm_clmulepi64_si128(accumulator, constants, 0x11)
+	);
+}
+
+/// Performs an unaligned load of 16 bytes from @c data.
+__attribute__((target("sse2"))) inline __m128i load_128(const uint8_t *data) {
+	return _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+}
+
+/*!
+	Folds as many whole 16-byte blocks as possible from @c data, which should be at least 64 bytes long,
+	into a single 16-byte remainder that has the same residue modulo the reflected 32-bit polynomial from
+	which @c constants were derived. @c initial_value is the current CRC register in reflected form.
+
+	@returns The number of bytes consumed.
+*/
+__attribute__((target("pclmul,sse4.1"))) inline size_t fold_reflected_32(const uint8_t *data, size_t length, uint32_t initial_value, const uint64_t *constants, uint8_t *remainder) {
+	// The low quadword of each accumulator holds the coefficients of highest degree, so is
+	// multiplied by the constant for the greater distance; the high quadword by the lesser.
+	const __m128i fold_4 = _mm_set_epi64x(int64_t(constants[1]), int64_t(constants[0]));
+	const __m128i fold_1 = _mm_set_epi64x(int64_t(constants[3]), int64_t(constants[2]));
+
+	// Fold four blocks at a time across a distance of 512 bits.
+	__m128i accumulators[4] = {
+		_mm_xor_si128(load_128(&data[0]), _mm_cvtsi32_si128(int(initial_value))),
+		load_128(&data[16]), load_128(&data[32]), load_128(&data[48])
+	};
+	size_t offset = 64;
+	for(; offset + 64 <= length; offset += 64) {
+		for(int c = 0; c < 4; c++) {
+			accumulators[c] = _mm_xor_si128(fold_128(accumulators[c], fold_4), load_128(&data[offset + size_t(c) * 16]));
+		}
+	}
+
+	// Reduce to a single accumulator, then fold in any remaining whole blocks.
+	__m128i accumulator = accumulators[0];
+	for(int c = 1; c < 4; c++) {
+		accumulator = _mm_xor_si128(fold_128(accumulator, fold_1), accumulators[c]);
+	}
+	for(; offset + 16 <= length; offset += 16) {
+		accumulator = _mm_xor_si128(fold_128(accumulator, fold_1), load_128(&data[offset]));
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(remainder), accumulator);
+	return offset;
+}
+#endif
+
 /*! Provides a class capable of generating a CRC from source data. */
 template <typename IntType, IntType reset_value, IntType output_xor, bool reflect_input, bool reflect_output> class Generator {
 	public:
@@ -31,6 +93,40 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 				}
 				xor_table[c] = shift_value;
 			}
+
+			// Build tables for slice-by-8 processing: table k describes the effect of a byte
+			// followed by k zero bytes. Indices are pre-reflected if input is reflected.
+			for(int c = 0; c < 256; c++) {
+				slice_tables_[0][c] = xor_table[reflect_input ? reverse_byte(uint8_t(c)) : c];
+			}
+			for(int k = 1; k < 8; k++) {
+				for(int c = 0; c < 256; c++) {
+					const IntType previous = slice_tables_[k-1][c];
+					slice_tables_[k][c] = IntType((previous << 8) ^ xor_table[previous >> multibyte_shift]);
+				}
+			}
+
+#ifdef CRC_USE_PCLMULQDQ
+			// Carry-less multiplication is used only for reflected 32-bit CRCs; in that case
+			// derive folding constants x^n mod polynomial for the distances used by fold_reflected_32.
+			if constexpr (sizeof(IntType) == 4 && reflect_input) {
+				const int distances[] = {575, 511, 191, 127};
+				for(int c = 0; c < 4; c++) {
+					// Compute x^n mod polynomial, in normal form.
+					uint32_t residue = 1;
+					for(int n = 0; n < distances[c]; n++) {
+						residue = uint32_t(residue << 1) ^ ((residue & 0x80000000) ? uint32_t(polynomial) : 0);
+					}
+
+					// Store reflected, such that the coefficient of x^d is at bit 63 - d.
+					uint64_t constant = 0;
+					for(int d = 0; d < 32; d++) {
+						if(residue & (1u << d)) constant |= uint64_t(1) << (63 - d);
+					}
+					fold_constants_[c] = constant;
+				}
+			}
+#endif
 		}
 
 		/// Resets the CRC to the reset value.
@@ -42,6 +138,25 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 			value_ = IntType((value_ << 8) ^ xor_table[(value_ >> multibyte_shift) ^ byte]);
 		}
 
+		/// Updates the CRC to include the @c length bytes at @c data.
+		void add(const uint8_t *data, std::size_t length) {
+#ifdef CRC_USE_PCLMULQDQ
+			if constexpr (sizeof(IntType) == 4 && reflect_input) {
+				if(length >= 64 && has_pclmulqdq()) {
+					// Fold down to 16 bytes with a residue equivalent to everything consumed, then
+					// obtain the CRC of those from a zero starting value.
+					uint8_t remainder[16];
+					const size_t consumed = fold_reflected_32(data, length, reflect(value_), fold_constants_, remainder);
+					value_ = 0;
+					add_slices(remainder, 16);
+					data += consumed;
+					length -= consumed;
+				}
+			}
+#endif
+			add_slices(data, length);
+		}
+
 		/// @returns The current value of the CRC.
 		inline IntType get_value() const {
 			IntType result = value_ ^ output_xor;
@@ -70,6 +185,30 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 			return compute_crc(data.begin(), data.end());
 		}
 
+		/*!
+			A compound for:
+
+				reset()
+				[add all data from @c data]
+				get_value()
+		*/
+		IntType compute_crc(const std::vector<uint8_t> &data) {
+			return compute_crc(data.data(), data.size());
+		}
+
+		/*!
+			A compound for:
+
+				reset()
+				[add @c length bytes from @c data]
+				get_value()
+		*/
+		IntType compute_crc(const uint8_t *data, std::size_t length) {
+			reset();
+			add(data, length);
+			return get_value();
+		}
+
 		/*!
 			A compound for:
 
@@ -87,11 +226,60 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 		}
 
 	private:
+		static_assert(sizeof(IntType) <= 8, "Slice-by-8 processing assumes a CRC no wider than 64 bits");
 		static constexpr int multibyte_shift = (sizeof(IntType) * 8) - 8;
 		IntType xor_table[256];
+		IntType slice_tables_[8][256];
 		IntType value_;
 
-		constexpr uint8_t reverse_byte(uint8_t byte) const {
+		void add_slices(const uint8_t *data, std::size_t length) {
+			while(length >= 8) {
+				uint8_t bytes[8];
+				for(int c = 0; c < 8; c++) bytes[c] = data[c];
+
+				// Combine the current value into the leading bytes; all of its bits are then
+				// accounted for by the tables.
+				for(std::size_t c = 0; c < sizeof(IntType); c++) {
+					const uint8_t value_byte = uint8_t(value_ >> (multibyte_shift - 8*c));
+					bytes[c] ^= reflect_input ? reverse_byte(value_byte) : value_byte;
+				}
+
+				value_ = IntType(
+					slice_tables_[7][bytes[0]] ^ slice_tables_[6][bytes[1]] ^
+					slice_tables_[5][bytes[2]] ^ slice_tables_[4][bytes[3]] ^
+					slice_tables_[3][bytes[4]] ^ slice_tables_[2][bytes[5]] ^
+					slice_tables_[1][bytes[6]] ^ slice_tables_[0][bytes[7]]
+				);
+
+				data += 8;
+				length -= 8;
+			}
+
+			while(length--) {
+				add(*data);
+				++data;
+			}
+		}
+
+#ifdef CRC_USE_PCLMULQDQ
+		uint64_t fold_constants_[4]{};
+
+		static bool has_pclmulqdq() {
+			static const bool has_pclmulqdq = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+			return has_pclmulqdq;
+		}
+
+		/// @returns @c value in the reflected form used by fold_reflected_32.
+		static constexpr uint32_t reflect(IntType value) {
+			uint32_t result = 0;
+			for(int c = 0; c < 32; c++) {
+				if(value & (IntType(1) << c)) result |= 1u << (31 - c);
+			}
+			return result;
+		}
+#endif
+
+		static constexpr uint8_t reverse_byte(uint8_t byte) {
 			return
 				((byte & 0x80) ? 0x01 : 0x00) |
 				((byte & 0x40) ? 0x02 : 0x00) |
@@ -680,10 +680,11 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 		/// Fragment shader that outputs directly as RGB, with gamma correction.
 		NSString *const directRGBWithGamma;
 	};
-	const FragmentSamplerDictionary samplerDictionary[8] = {
+	const FragmentSamplerDictionary samplerDictionary[9] = {
 		// Composite formats.
 		{@"compositeSampleLuminance1", 				nil,	@"sampleLuminance1",				@"sampleLuminance1",						@"sampleLuminance1",				@"sampleLuminance1"},
 		{@"compositeSampleLuminance8", 				nil,	@"sampleLuminance8", 				@"sampleLuminance8WithGamma",				@"sampleLuminance8", 				@"sampleLuminance8WithGamma"},
+		{@"compositeSamplePackedLuminance1", 		nil,	@"samplePackedLuminance1",			@"samplePackedLuminance1",					@"samplePackedLuminance1",			@"samplePackedLuminance1"},
 		{@"compositeSamplePhaseLinkedLuminance8", 	nil,	@"samplePhaseLinkedLuminance8",		@"samplePhaseLinkedLuminance8WithGamma",	@"samplePhaseLinkedLuminance8",		@"samplePhaseLinkedLuminance8WithGamma"},
 
 		// S-Video formats.
@@ -698,7 +699,7 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 
 #ifndef NDEBUG
 	// Do a quick check that all the shaders named above are defined in the Metal code. I don't think this is possible at compile time.
-	for(int c = 0; c < 8; ++c) {
+	for(int c = 0; c < 9; ++c) {
 #define Test(x)	if(samplerDictionary[c].x)	assert([library newFunctionWithName:samplerDictionary[c].x]);
 		Test(compositionComposite);
 		Test(compositionSVideo);
@@ -258,6 +258,13 @@ half convertLuminance8(SourceInterpolator vert [[stage_in]], texture2d<half> tex
 	return texture.sample(standardSampler, vert.textureCoordinates).r;
 }
 
+half convertPackedLuminance1(SourceInterpolator vert [[stage_in]], texture2d<ushort> texture [[texture(0)]]) {
+	// Each texel holds eight pixels; pick a bit based on the fractional part of the texel position.
+	const auto sample = texture.sample(standardSampler, vert.textureCoordinates).r;
+	const int bit = 7 - int(fract(vert.textureCoordinates.x) * 8.0f);
+	return half((sample >> bit) & 1);
+}
+
 half convertPhaseLinkedLuminance8(SourceInterpolator vert [[stage_in]], texture2d<half> texture [[texture(0)]]) {
 	const int offset = int(vert.unitColourPhase * 4.0f) & 3;
 	auto sample = texture.sample(standardSampler, vert.textureCoordinates);
@@ -283,6 +290,7 @@ half convertPhaseLinkedLuminance8(SourceInterpolator vert [[stage_in]], texture2
 
 CompositeSet(Luminance1, ushort);
 CompositeSet(Luminance8, half);
+CompositeSet(PackedLuminance1, ushort);
 CompositeSet(PhaseLinkedLuminance8, half);
 
 #undef CompositeSet
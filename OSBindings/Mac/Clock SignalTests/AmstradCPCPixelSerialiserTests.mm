@@ -0,0 +1,174 @@
+//
+//  AmstradCPCPixelSerialiserTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/AmstradCPC/PixelSerialiser.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// @returns The pen selected by the bits of @c byte at @c positions, which are listed from least significant to most.
+template <size_t n> int pen(uint8_t byte, const int (&positions)[n]) {
+	int result = 0;
+	for(size_t c = 0; c < n; c++) {
+		result |= ((byte >> positions[c]) & 1) << c;
+	}
+	return result;
+}
+
+/// Appends to @c target the pixels that @c byte should produce in @c mode given @c palette, decoding bit by bit.
+void append_reference_pixels(std::vector<uint8_t> &target, int mode, const uint8_t *palette, uint8_t byte) {
+	switch(mode) {
+		case 0:
+			target.push_back(palette[pen(byte, {7, 3, 5, 1})]);
+			target.push_back(palette[pen(byte, {6, 2, 4, 0})]);
+		break;
+		case 1:
+			for(int c = 0; c < 4; c++) {
+				target.push_back(palette[pen(byte, {7 - c, 3 - c})]);
+			}
+		break;
+		case 2:
+			for(int c = 0; c < 8; c++) {
+				target.push_back(palette[pen(byte, {7 - c})]);
+			}
+		break;
+		case 3:
+			target.push_back(palette[pen(byte, {7, 3})]);
+			target.push_back(palette[pen(byte, {6, 2})]);
+		break;
+	}
+}
+
+}
+
+@interface AmstradCPCPixelSerialiserTests : XCTestCase
+@end
+
+@implementation AmstradCPCPixelSerialiserTests {
+	std::vector<uint8_t> _ram;
+}
+
+- (void)setUp {
+	// 16kb of pseudo-random video RAM.
+	std::minstd_rand generator{0xc9c};
+	_ram.resize(16384);
+	for(auto &byte: _ram) {
+		byte = uint8_t(generator());
+	}
+}
+
+- (void)testMode2 {
+	AmstradCPC::PixelSerialiser serialiser;
+	serialiser.set_mode(2);
+	serialiser.set_pen(0, 0x00);
+	serialiser.set_pen(1, 0x3f);
+
+	const uint8_t source[2] = {0xa5, 0x0f};
+	alignas(uint64_t) uint8_t target[16];
+	XCTAssertEqual(serialiser.output(target, source, 1), target + 16);
+
+	const uint8_t expected[16] = {
+		0x3f, 0x00, 0x3f, 0x00, 0x00, 0x3f, 0x00, 0x3f,
+		0x00, 0x00, 0x00, 0x00, 0x3f, 0x3f, 0x3f, 0x3f,
+	};
+	for(int c = 0; c < 16; c++) {
+		XCTAssertEqual(target[c], expected[c], @"Pixel %d differs", c);
+	}
+}
+
+/// Checks that serialising @c _ram in a single call matches a per-character reference decoding, given @c palette.
+- (void)checkSerialiser:(AmstradCPC::PixelSerialiser &)serialiser mode:(int)mode palette:(const uint8_t *)palette stage:(NSString *)stage {
+	constexpr int characters = 512;
+	const uint8_t *const source = &_ram[size_t(mode) * 1024];
+
+	std::vector<uint8_t> expected;
+	for(int c = 0; c < characters * 2; c++) {
+		append_reference_pixels(expected, mode, palette, source[c]);
+	}
+
+	std::vector<uint64_t> buffer(characters * 2);
+	uint8_t *const target = reinterpret_cast<uint8_t *>(buffer.data());
+	XCTAssertEqual(serialiser.bytes_per_character() * characters, int(expected.size()));
+	XCTAssertEqual(serialiser.output(target, source, characters), target + expected.size());
+	XCTAssert(std::equal(expected.begin(), expected.end(), target), @"Mode %d differs %@", mode, stage);
+}
+
+- (void)testMatchesReference {
+	std::minstd_rand generator{0x6128};
+	for(int mode = 0; mode < 4; mode++) {
+		AmstradCPC::PixelSerialiser serialiser;
+		uint8_t palette[16];
+		const auto set_pen = [&](int pen) {
+			palette[pen] = uint8_t(generator() & 0x3f);
+			serialiser.set_pen(pen, palette[pen]);
+		};
+
+		for(int pen = 0; pen < 16; pen++) set_pen(pen);
+		serialiser.set_mode(mode);
+		[self checkSerialiser:serialiser mode:mode palette:palette stage:@"initially"];
+
+		// Single pen changes are patched in; test each pen, whether or not the mode uses it.
+		for(int pen = 0; pen < 16; pen++) {
+			set_pen(pen);
+			[self checkSerialiser:serialiser mode:mode palette:palette stage:[NSString stringWithFormat:@"after a change to pen %d", pen]];
+		}
+
+		// Multiple pen changes cause a rebuild.
+		set_pen(1);
+		set_pen(0);
+		set_pen(3);
+		[self checkSerialiser:serialiser mode:mode palette:palette stage:@"after several pen changes"];
+
+		// Switch to another mode, output there, change a pen and switch back.
+		const int other_mode = (mode + 1) & 3;
+		serialiser.set_mode(other_mode);
+		[self checkSerialiser:serialiser mode:other_mode palette:palette stage:@"after a change of mode"];
+		set_pen(0);
+		serialiser.set_mode(mode);
+		[self checkSerialiser:serialiser mode:mode palette:palette stage:@"after returning from another mode"];
+
+		// A pen change immediately before a change of mode.
+		set_pen(1);
+		serialiser.set_mode(other_mode);
+		[self checkSerialiser:serialiser mode:other_mode palette:palette stage:@"after a pen change then a change of mode"];
+	}
+}
+
+// MARK: - Performance.
+
+- (void)measureMode:(int)mode {
+	const uint8_t *const ram = _ram.data();
+	const size_t limit = _ram.size() - 160;
+
+	[self measureBlock:^{
+		AmstradCPC::PixelSerialiser serialiser;
+		serialiser.set_mode(mode);
+		alignas(uint64_t) uint8_t line[640];
+
+		// Serialise 80-byte lines, i.e. 40 characters at a time as for an ordinary display,
+		// with a palette change every few lines to exercise table updates.
+		for(size_t c = 0; c < 100000; c++) {
+			if(!(c & 7)) {
+				serialiser.set_pen(int(c >> 3) & 15, uint8_t(c));
+			}
+			serialiser.output(line, &ram[(c * 80) % limit], 40);
+		}
+	}];
+}
+
+- (void)testMode0Performance	{	[self measureMode:0];	}
+- (void)testMode1Performance	{	[self measureMode:1];	}
+- (void)testMode2Performance	{	[self measureMode:2];	}
+- (void)testMode3Performance	{	[self measureMode:3];	}
+
+@end
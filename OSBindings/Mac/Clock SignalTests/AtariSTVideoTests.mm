@@ -20,6 +20,17 @@ struct VideoTester {
 	}
 };
 
+// A scan target that accepts and discards all output, so that pixel generation can be timed.
+struct DiscardingScanTarget: public Outputs::Display::ScanTarget {
+	void set_modals(Modals) final {}
+	Scan *begin_scan() final { return &scan_; }
+	uint8_t *begin_data(size_t, size_t) final { return reinterpret_cast<uint8_t *>(data_); }
+
+	private:
+		Scan scan_;
+		uint16_t data_[2048];
+};
+
 @interface AtariSTVideoTests : XCTestCase
 @end
 
@@ -383,4 +394,23 @@ struct RunLength {
 	}
 }
 
+// MARK: - Performance
+
+- (void)testLowResolutionFramePerformance {
+	// Fill memory with noise, so that every pixel is drawn from a full shifter.
+	for(size_t c = 0; c < sizeof(_ram) / sizeof(*_ram); c++) {
+		_ram[c] = uint16_t(c * 0x9e37);
+	}
+
+	static DiscardingScanTarget scan_target;
+	_video->set_scan_target(&scan_target);
+	_video->write(0x30, 0x0000);	// Low resolution.
+	_video->run_for(Cycles(160256 * 2));
+
+	// Measure ten frames.
+	[self measureBlock:^{
+		_video->run_for(Cycles(160256 * 10));
+	}];
+}
+
 @end
@@ -22,6 +22,10 @@ class DigitalPhaseLockedLoopDelegate {
 		void digital_phase_locked_loop_output_bit(int value) {
 			[bridge pushBit:value ? 1 : 0];
 		}
+
+		void digital_phase_locked_loop_output_zeroes(int count) {
+			while(count--) [bridge pushBit:0];
+		}
 };
 
 @implementation DigitalPhaseLockedLoopBridge {
@@ -0,0 +1,234 @@
+//
+//  BufferingScanTargetTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Outputs/ScanTargets/BufferingScanTarget.hpp"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// A BufferingScanTarget with buffers of its own, which can output single-scan lines on demand.
+template <size_t LineBufferSize> struct TestScanTarget: public Outputs::Display::BufferingScanTarget {
+	TestScanTarget() : write_area_(WriteAreaWidth * WriteAreaHeight) {
+		set_scan_buffer(scans_, LineBufferSize * 2);
+		set_line_buffer(lines_, metadata_, LineBufferSize);
+
+		Modals modals{};
+		modals.input_data_type = Outputs::Display::InputDataType::Luminance1;
+		static_cast<Outputs::Display::ScanTarget *>(this)->set_modals(modals);
+		new_modals();
+
+		reset();
+	}
+
+	void reset() {
+		set_write_area(write_area_.data());
+	}
+
+	/// Attempts to output a single line of one scan; @returns @c true if it was accepted.
+	bool output_line() {
+		Outputs::Display::ScanTarget &target = *this;
+		const Outputs::Display::ScanTarget::Scan::EndPoint location{};
+
+		target.announce(Event::EndHorizontalRetrace, true, location, 0);
+		const bool has_data = target.begin_data(4, 1);
+		target.end_data(4);
+
+		auto *const scan = target.begin_scan();
+		if(scan) {
+			scan->end_points[0] = scan->end_points[1] = location;
+			target.end_scan();
+		}
+		target.announce(Event::BeginHorizontalRetrace, false, location, 0);
+
+		return has_data && scan;
+	}
+
+	/// Announces the end of vertical retrace, optionally followed by a declaration that the new frame repeats the last.
+	void begin_frame(bool is_repeat) {
+		Outputs::Display::ScanTarget &target = *this;
+		const Outputs::Display::ScanTarget::Scan::EndPoint location{};
+		target.announce(Event::EndVerticalRetrace, false, location, 0);
+		if(is_repeat) target.announce(Event::RepeatPreviousFrame, false, location, 0);
+	}
+
+	const LineMetadata &metadata(size_t line) const {
+		return metadata_[line];
+	}
+
+	/// Outputs lines until the line buffer is full. @returns The number output, which is the number that had been freed.
+	size_t fill() {
+		size_t lines = 0;
+		while(output_line()) ++lines;
+		return lines;
+	}
+
+	/// @returns The parts of the next output area, split as evenly as possible into @c count.
+	std::vector<OutputArea> get_parts(size_t count) {
+		std::vector<OutputArea> parts(count);
+		parts.resize(split_output_area(get_output_area(), parts.data(), count));
+		return parts;
+	}
+
+	private:
+		std::vector<uint8_t> write_area_;
+		Scan scans_[LineBufferSize * 2];
+		Line lines_[LineBufferSize];
+		LineMetadata metadata_[LineBufferSize];
+};
+
+size_t lines(const Outputs::Display::BufferingScanTarget::OutputArea &area, size_t line_buffer_size) {
+	return (area.end.line + line_buffer_size - area.start.line) % line_buffer_size;
+}
+
+}
+
+@interface BufferingScanTargetTests : XCTestCase
+@end
+
+@implementation BufferingScanTargetTests
+
+/// Completes the parts of each area in a random order, checking after each completion that
+/// only lines within the completed prefix of parts have been freed.
+- (void)testShuffledCompletion {
+	auto target = std::make_unique<TestScanTarget<16>>();
+	std::mt19937 generator(1);
+
+	XCTAssertEqual(target->fill(), 15);
+	for(int round = 0; round < 20; round++) {
+		const auto parts = target->get_parts(5);
+		XCTAssertEqual(parts.size(), 5);
+
+		std::vector<size_t> order(parts.size());
+		for(size_t c = 0; c < order.size(); c++) order[c] = c;
+		std::shuffle(order.begin(), order.end(), generator);
+
+		std::vector<bool> completed(parts.size());
+		size_t prefix = 0;
+		for(const auto index: order) {
+			target->complete_output_area(parts[index]);
+			completed[index] = true;
+
+			size_t freed = 0;
+			while(prefix < parts.size() && completed[prefix]) {
+				freed += lines(parts[prefix], 16);
+				++prefix;
+			}
+			XCTAssertEqual(target->fill(), freed, @"Wrong number of lines freed in round %d", round);
+		}
+	}
+}
+
+/// Completes all but one part of each area from several threads at once; nothing should be freed
+/// until the exception is completed, at which point all preceding lines are.
+- (void)testConcurrentCompletion {
+	auto target = std::make_unique<TestScanTarget<64>>();
+	std::mt19937 generator(2);
+
+	XCTAssertEqual(target->fill(), 63);
+	for(int round = 0; round < 50; round++) {
+		const auto parts = target->get_parts(9);
+		XCTAssertEqual(parts.size(), 9);
+
+		const size_t withheld = generator() % parts.size();
+		std::vector<size_t> order;
+		for(size_t c = 0; c < parts.size(); c++) {
+			if(c != withheld) order.push_back(c);
+		}
+		std::shuffle(order.begin(), order.end(), generator);
+
+		std::vector<std::thread> threads;
+		for(size_t thread = 0; thread < 4; thread++) {
+			threads.emplace_back([&, thread] {
+				for(size_t c = thread; c < order.size(); c += 4) {
+					target->complete_output_area(parts[order[c]]);
+				}
+			});
+		}
+		for(auto &thread: threads) thread.join();
+
+		size_t preceding = 0;
+		for(size_t c = 0; c < withheld; c++) preceding += lines(parts[c], 64);
+		XCTAssertEqual(target->fill(), preceding, @"Wrong number of lines freed before completion of part %zu", withheld);
+
+		target->complete_output_area(parts[withheld]);
+		XCTAssertEqual(target->fill(), 63 - preceding, @"Not all lines freed after completion of part %zu", withheld);
+	}
+}
+
+/// Ends a repeated frame partway through; the first line output should be marked as first in frame, so that the
+/// consumer resets its stencil, but without prompting a clear of the retained portion of the display.
+- (void)testRepeatedFrameEndingMidFrame {
+	auto target = std::make_unique<TestScanTarget<16>>();
+
+	target->begin_frame(false);
+	XCTAssert(target->output_line());
+	XCTAssert(target->output_line());
+
+	target->begin_frame(true);
+	XCTAssert(target->output_line());
+	XCTAssert(target->output_line());
+
+	target->begin_frame(false);
+	XCTAssert(target->output_line());
+
+	XCTAssert(target->metadata(0).is_first_in_frame);
+	XCTAssertFalse(target->metadata(1).is_first_in_frame);
+
+	XCTAssert(target->metadata(2).is_first_in_frame);
+	XCTAssertFalse(target->metadata(2).previous_frame_was_complete);
+	XCTAssertFalse(target->metadata(3).is_first_in_frame);
+
+	XCTAssert(target->metadata(4).is_first_in_frame);
+	XCTAssert(target->metadata(4).previous_frame_was_complete);
+}
+
+/// Resets the write area while parts are outstanding; their completions should subsequently be ignored.
+- (void)testSetWriteAreaWithOutstandingParts {
+	auto target = std::make_unique<TestScanTarget<16>>();
+
+	// Run one area through so that the areas below don't begin at the start of the buffers.
+	XCTAssertEqual(target->fill(), 15);
+	for(const auto &part: target->get_parts(3)) {
+		target->complete_output_area(part);
+	}
+	XCTAssertEqual(target->fill(), 15);
+
+	const auto stale_parts = target->get_parts(5);
+	XCTAssertEqual(stale_parts.size(), 5);
+	target->complete_output_area(stale_parts[1]);
+	target->complete_output_area(stale_parts[3]);
+	target->reset();
+
+	// Everything should be available again, and the next area should begin at the start of the buffers.
+	target->complete_output_area(stale_parts[0]);
+	target->complete_output_area(stale_parts[2]);
+	XCTAssertEqual(target->fill(), 15);
+
+	const auto parts = target->get_parts(1);
+	XCTAssertEqual(parts.size(), 1);
+	XCTAssertEqual(parts[0].start.line, 0);
+	XCTAssertEqual(lines(parts[0], 16), 15);
+
+	// Stale parts, whether or not previously completed, should free nothing.
+	for(const auto &part: stale_parts) {
+		target->complete_output_area(part);
+	}
+	XCTAssertEqual(target->fill(), 0);
+
+	// Completion of the genuine area should free everything.
+	target->complete_output_area(parts[0]);
+	XCTAssertEqual(target->fill(), 15);
+}
+
+@end
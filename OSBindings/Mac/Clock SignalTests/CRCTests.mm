@@ -9,6 +9,7 @@
 #import <XCTest/XCTest.h>
 #include "CRC.hpp"
 #include <string>
+#include <vector>
 
 @interface CRCTests : XCTestCase
 @end
@@ -76,4 +77,60 @@
 	XCTAssertEqual(crcGenerator.get_value(), 0xcbf43926);
 }
 
+- (std::vector<uint8_t>)pseudoRandomDataOfLength:(size_t)length {
+	std::vector<uint8_t> data(length);
+	uint32_t seed = 0x12345678;
+	for(auto &byte: data) {
+		seed = seed * 1664525 + 1013904223;
+		byte = uint8_t(seed >> 24);
+	}
+	return data;
+}
+
+- (void)testBulkMatchesBytewise {
+	const size_t lengths[] = {0, 1, 7, 8, 9, 63, 64, 65, 127, 128, 255, 256, 1000, 6250, 65537};
+	for(const auto length: lengths) {
+		const auto data = [self pseudoRandomDataOfLength:length];
+
+		CRC::CRC32 crc32Bytewise, crc32Bulk;
+		CRC::CCITT ccittBytewise, ccittBulk;
+		for(const auto byte: data) {
+			crc32Bytewise.add(byte);
+			ccittBytewise.add(byte);
+		}
+
+		// Split the bulk additions in order to test continuation from a non-reset value.
+		crc32Bulk.add(data.data(), length / 3);
+		crc32Bulk.add(data.data() + length / 3, length - length / 3);
+		ccittBulk.add(data.data(), length / 3);
+		ccittBulk.add(data.data() + length / 3, length - length / 3);
+
+		XCTAssertEqual(crc32Bytewise.get_value(), crc32Bulk.get_value(), @"Bulk CRC32 should match bytewise for length %zu", length);
+		XCTAssertEqual(ccittBytewise.get_value(), ccittBulk.get_value(), @"Bulk CCITT should match bytewise for length %zu", length);
+		XCTAssertEqual(crc32Bytewise.get_value(), CRC::CRC32().compute_crc(data), @"CRC32 compute_crc should match bytewise for length %zu", length);
+	}
+}
+
+- (void)testCRC32ROMPerformance {
+	// A 256kb ROM.
+	const auto data = [self pseudoRandomDataOfLength:256*1024];
+	__block CRC::CRC32 crcGenerator;
+	[self measureBlock:^{
+		for(int c = 0; c < 100; c++) {
+			crcGenerator.compute_crc(data);
+		}
+	}];
+}
+
+- (void)testCCITTTrackPerformance {
+	// A double-density track's worth of data.
+	const auto data = [self pseudoRandomDataOfLength:12500];
+	__block CRC::CCITT crcGenerator;
+	[self measureBlock:^{
+		for(int c = 0; c < 1000; c++) {
+			crcGenerator.compute_crc(data);
+		}
+	}];
+}
+
 @end
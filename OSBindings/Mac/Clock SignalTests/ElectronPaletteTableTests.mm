@@ -0,0 +1,125 @@
+//
+//  ElectronPaletteTableTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Electron/PaletteTables.hpp"
+
+#include <cstring>
+#include <random>
+
+namespace {
+
+/// The tables as formerly regenerated in full by the Electron upon every palette write.
+struct ReferenceTables {
+	uint32_t forty1bpp[256];
+	uint16_t forty2bpp[256];
+	uint64_t eighty1bpp[256];
+	uint32_t eighty2bpp[256];
+	uint16_t eighty4bpp[256];
+
+	ReferenceTables(const uint8_t *palette_) {
+		for(int byte = 0; byte < 256; byte++) {
+			uint8_t *target = reinterpret_cast<uint8_t *>(&forty1bpp[byte]);
+			target[0] = palette_[(byte&0x80) >> 4];
+			target[1] = palette_[(byte&0x40) >> 3];
+			target[2] = palette_[(byte&0x20) >> 2];
+			target[3] = palette_[(byte&0x10) >> 1];
+
+			target = reinterpret_cast<uint8_t *>(&eighty2bpp[byte]);
+			target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
+			target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
+			target[2] = palette_[((byte&0x20) >> 2) | ((byte&0x02) >> 0)];
+			target[3] = palette_[((byte&0x10) >> 1) | ((byte&0x01) << 1)];
+
+			target = reinterpret_cast<uint8_t *>(&eighty1bpp[byte]);
+			target[0] = palette_[(byte&0x80) >> 4];
+			target[1] = palette_[(byte&0x40) >> 3];
+			target[2] = palette_[(byte&0x20) >> 2];
+			target[3] = palette_[(byte&0x10) >> 1];
+			target[4] = palette_[(byte&0x08) >> 0];
+			target[5] = palette_[(byte&0x04) << 1];
+			target[6] = palette_[(byte&0x02) << 2];
+			target[7] = palette_[(byte&0x01) << 3];
+
+			target = reinterpret_cast<uint8_t *>(&forty2bpp[byte]);
+			target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
+			target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
+
+			target = reinterpret_cast<uint8_t *>(&eighty4bpp[byte]);
+			target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x20) >> 3) | ((byte&0x08) >> 2) | ((byte&0x02) >> 1)];
+			target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x10) >> 2) | ((byte&0x04) >> 1) | ((byte&0x01) >> 0)];
+		}
+	}
+};
+
+template <typename EntryT> bool equal(const EntryT *lhs, const EntryT (&rhs)[256]) {
+	return !std::memcmp(lhs, rhs, sizeof(rhs));
+}
+
+}
+
+@interface ElectronPaletteTableTests : XCTestCase
+@end
+
+@implementation ElectronPaletteTableTests
+
+- (void)testMatchesReference {
+	std::minstd_rand generator{0xe1ec};
+	uint8_t palette[16]{};
+	Electron::PaletteTables tables;
+
+	for(int change = 0; change < 20; change++) {
+		for(auto &entry: palette) entry = uint8_t(generator() & 7);
+		const ReferenceTables expected(palette);
+
+		// Use only some of the tables before each palette change; the others should
+		// nevertheless be correct upon their next use.
+		XCTAssert(equal(tables.eighty4bpp.get(palette), expected.eighty4bpp), @"4bpp table incorrect after change %d", change);
+		if(change & 1) {
+			XCTAssert(equal(tables.forty1bpp.get(palette), expected.forty1bpp), @"40-column 1bpp table incorrect after change %d", change);
+			XCTAssert(equal(tables.eighty1bpp.get(palette), expected.eighty1bpp), @"80-column 1bpp table incorrect after change %d", change);
+		} else {
+			XCTAssert(equal(tables.forty2bpp.get(palette), expected.forty2bpp), @"40-column 2bpp table incorrect after change %d", change);
+			XCTAssert(equal(tables.eighty2bpp.get(palette), expected.eighty2bpp), @"80-column 2bpp table incorrect after change %d", change);
+		}
+
+		// Without invalidation a table should keep its contents, even if the palette changes.
+		if(change) {
+			palette[generator() & 15] ^= 7;
+			XCTAssert(equal(tables.eighty4bpp.get(palette), expected.eighty4bpp), @"4bpp table regenerated without invalidation");
+		}
+
+		tables.invalidate();
+	}
+}
+
+- (void)testSingleEntryInvalidation {
+	std::minstd_rand generator{0x5e1f};
+	uint8_t palette[16]{};
+	Electron::PaletteTables tables;
+
+	for(int change = 0; change < 64; change++) {
+		const int index = int(generator() & 15);
+		palette[index] = uint8_t(generator() & 7);
+		tables.forty1bpp.invalidate(index);
+		tables.forty2bpp.invalidate(index);
+		tables.eighty1bpp.invalidate(index);
+		tables.eighty2bpp.invalidate(index);
+		tables.eighty4bpp.invalidate(index);
+
+		const ReferenceTables expected(palette);
+		XCTAssert(equal(tables.forty1bpp.get(palette), expected.forty1bpp), @"40-column 1bpp table incorrect after change %d", change);
+		XCTAssert(equal(tables.forty2bpp.get(palette), expected.forty2bpp), @"40-column 2bpp table incorrect after change %d", change);
+		XCTAssert(equal(tables.eighty1bpp.get(palette), expected.eighty1bpp), @"80-column 1bpp table incorrect after change %d", change);
+		XCTAssert(equal(tables.eighty2bpp.get(palette), expected.eighty2bpp), @"80-column 2bpp table incorrect after change %d", change);
+		XCTAssert(equal(tables.eighty4bpp.get(palette), expected.eighty4bpp), @"4bpp table incorrect after change %d", change);
+	}
+}
+
+@end
@@ -0,0 +1,96 @@
+//
+//  FIRFilterTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "FIRFilter.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+@interface FIRFilterTests : XCTestCase
+@end
+
+@implementation FIRFilterTests {
+	std::vector<short> _samples;
+}
+
+- (void)setUp {
+	// Enough pseudo-random stereo input for the largest filter tested.
+	std::minstd_rand generator{0xc10c};
+	_samples.resize(8192);
+	for(auto &sample: _samples) {
+		sample = short(generator());
+	}
+}
+
+- (SignalProcessing::FIRFilter)filterWithTaps:(size_t)taps {
+	return SignalProcessing::FIRFilter(taps, 2000000.0f, 0.0f, 22050.0f);
+}
+
+- (void)testApplyMatchesScalar {
+	for(size_t taps = 3; taps < 300; taps += 2) {
+		const auto filter = [self filterWithTaps:taps];
+
+		// Compute the expected result directly from the fixed-point coefficients.
+		const auto coefficients = filter.get_coefficients();
+		int expected = 0;
+		for(size_t c = 0; c < taps; c++) {
+			expected += int(std::lround(coefficients[c] * 32767.0f)) * _samples[c];
+		}
+		expected >>= 15;
+
+		// Permit a difference of 1 for rounding, as Accelerate rounds where the portable implementations truncate.
+		const int result = filter.apply(_samples.data());
+		XCTAssert(std::abs(result - expected) <= 1, @"Filter of %zu taps produced %d; expected %d", taps, result, expected);
+	}
+}
+
+- (void)testStereoMatchesStrided {
+	for(size_t taps = 3; taps < 300; taps += 2) {
+		const auto filter = [self filterWithTaps:taps];
+
+		short stereo[2];
+		filter.apply_stereo(_samples.data(), stereo);
+		XCTAssertEqual(stereo[0], filter.apply(_samples.data(), 2), @"Left channel differs for %zu taps", taps);
+		XCTAssertEqual(stereo[1], filter.apply(_samples.data() + 1, 2), @"Right channel differs for %zu taps", taps);
+	}
+}
+
+// MARK: - Performance.
+
+- (void)measureTaps:(size_t)taps stereo:(BOOL)stereo {
+	const auto filter = [self filterWithTaps:taps];
+	const size_t span = stereo ? taps * 2 : taps;
+	const short *const samples = _samples.data();
+	const size_t limit = _samples.size() - span;
+	__block int total = 0;
+
+	[self measureBlock:^{
+		// Apply the filter a million times, at shifting offsets.
+		short results[2];
+		for(size_t c = 0; c < 1000000; c++) {
+			const size_t offset = (c * 2) % limit;
+			if(stereo) {
+				filter.apply_stereo(&samples[offset], results);
+				total += results[0] + results[1];
+			} else {
+				total += filter.apply(&samples[offset]);
+			}
+		}
+	}];
+}
+
+- (void)testMono31TapPerformance		{	[self measureTaps:31 stereo:NO];	}
+- (void)testMono255TapPerformance		{	[self measureTaps:255 stereo:NO];	}
+- (void)testStereo31TapPerformance		{	[self measureTaps:31 stereo:YES];	}
+- (void)testStereo255TapPerformance		{	[self measureTaps:255 stereo:YES];	}
+
+@end
@@ -0,0 +1,151 @@
+//
+//  MFMTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/Disk/Encodings/MFM/Constants.hpp"
+#include "../../../Storage/Disk/Encodings/MFM/Encoder.hpp"
+#include "../../../Storage/Disk/Encodings/MFM/SegmentParser.hpp"
+#include "../../../Storage/Disk/Encodings/MFM/Shifter.hpp"
+
+#include "../../../Storage/Disk/Track/TrackSerialiser.hpp"
+
+#include <random>
+
+@interface MFMTests : XCTestCase
+@end
+
+@implementation MFMTests {
+}
+
+- (std::vector<Storage::Encodings::MFM::Sector>)sectorsWithCount:(int)count size:(uint8_t)size {
+	std::minstd_rand generator;
+	std::vector<Storage::Encodings::MFM::Sector> sectors(size_t(count));
+	for(int c = 0; c < count; c++) {
+		auto &sector = sectors[size_t(c)];
+		sector.address.track = 12;
+		sector.address.side = 1;
+		sector.address.sector = uint8_t(c + 1);
+		sector.size = size;
+		sector.samples.emplace_back(size_t(128 << size));
+		for(auto &byte: sector.samples[0]) byte = uint8_t(generator());
+	}
+
+	// Plant a false sync in the first sector's data.
+	sectors[0].samples[0][3] = sectors[0].samples[0][4] = sectors[0].samples[0][5] = 0xa1;
+	return sectors;
+}
+
+- (void)assertRoundTrip:(bool)isDoubleDensity {
+	const auto sectors = [self sectorsWithCount:isDoubleDensity ? 9 : 5 size:isDoubleDensity ? 2 : 1];
+	const auto track = isDoubleDensity ?
+		Storage::Encodings::MFM::GetMFMTrackWithSectors(sectors) :
+		Storage::Encodings::MFM::GetFMTrackWithSectors(sectors);
+	const auto parsed = Storage::Encodings::MFM::sectors_from_segment(
+		Storage::Disk::track_serialisation(*track, isDoubleDensity ? Storage::Encodings::MFM::MFMBitLength : Storage::Encodings::MFM::FMBitLength),
+		isDoubleDensity);
+
+	XCTAssertEqual(parsed.size(), sectors.size());
+	auto sector = sectors.begin();
+	for(const auto &pair: parsed) {
+		XCTAssertEqual(pair.second.address.sector, sector->address.sector);
+		XCTAssertEqual(pair.second.size, sector->size);
+		XCTAssert(pair.second.samples[0] == sector->samples[0]);
+		++sector;
+	}
+}
+
+- (void)testMFMRoundTrip {
+	[self assertRoundTrip:true];
+}
+
+- (void)testFMRoundTrip {
+	[self assertRoundTrip:false];
+}
+
+- (void)testBulkShifterMatchesBitwise {
+	std::minstd_rand generator;
+	const uint16_t marks[] = {
+		Storage::Encodings::MFM::MFMIndexSync,
+		Storage::Encodings::MFM::MFMSync,
+		Storage::Encodings::MFM::FMIndexAddressMark,
+		Storage::Encodings::MFM::FMIDAddressMark,
+		Storage::Encodings::MFM::FMDataAddressMark,
+		Storage::Encodings::MFM::FMDeletedDataAddressMark,
+	};
+
+	for(int trial = 0; trial < 200; trial++) {
+		const bool isDoubleDensity = trial & 1;
+
+		// Generate random data with a sprinkling of marks.
+		const size_t length = 1 + generator() % 4000;
+		std::vector<bool> data(length);
+		for(size_t c = 0; c < length; c++) data[c] = !(generator() % 3);
+		for(size_t c = 0; c < length / 200; c++) {
+			const size_t start = generator() % length;
+			const uint16_t mark = marks[isDoubleDensity ? generator() % 2 : 2 + generator() % 4];
+			for(size_t bit = 0; bit < 16 && start + bit < length; bit++) {
+				data[start + bit] = (mark >> (15 - bit)) & 1;
+			}
+		}
+
+		std::vector<uint64_t> words((length + 63) >> 6);
+		for(size_t c = 0; c < length; c++) {
+			if(data[c]) words[c >> 6] |= uint64_t(1) << (63 - (c & 63));
+		}
+
+		Storage::Encodings::MFM::Shifter bitwise, bulk;
+		bitwise.set_is_double_density(isDoubleDensity);
+		bulk.set_is_double_density(isDoubleDensity);
+
+		size_t bitwise_cursor = 0, bulk_cursor = 0;
+		while(bulk_cursor < length) {
+			const bool report_bytes = generator() & 1;
+			const bool should_obey_syncs = generator() % 4;
+			bitwise.set_should_obey_syncs(should_obey_syncs);
+			bulk.set_should_obey_syncs(should_obey_syncs);
+
+			bulk_cursor = bulk.add_input_bits(words.data(), bulk_cursor, length, report_bytes);
+			while(bitwise_cursor < length) {
+				bitwise.add_input_bit(data[bitwise_cursor]);
+				++bitwise_cursor;
+
+				const auto token = bitwise.get_token();
+				if(token != Storage::Encodings::MFM::Shifter::Token::None && (report_bytes || token != Storage::Encodings::MFM::Shifter::Token::Byte)) break;
+			}
+
+			XCTAssertEqual(bitwise_cursor, bulk_cursor);
+			XCTAssertEqual(bitwise.get_token(), bulk.get_token());
+			XCTAssertEqual(bitwise.get_byte(), bulk.get_byte());
+			XCTAssertEqual(bitwise.get_crc_generator().get_value(), bulk.get_crc_generator().get_value());
+			if(bitwise_cursor != bulk_cursor) return;
+		}
+	}
+}
+
+- (void)testWholeDiskEncodePerformance {
+	const auto sectors = [self sectorsWithCount:9 size:2];
+	[self measureBlock:^{
+		for(int track = 0; track < 160; track++) {
+			Storage::Encodings::MFM::GetMFMTrackWithSectors(sectors);
+		}
+	}];
+}
+
+- (void)testWholeDiskDecodePerformance {
+	const auto sectors = [self sectorsWithCount:9 size:2];
+	const auto track = Storage::Encodings::MFM::GetMFMTrackWithSectors(sectors);
+	const auto segment = Storage::Disk::track_serialisation(*track, Storage::Encodings::MFM::MFMBitLength);
+	[self measureBlock:^{
+		for(int track = 0; track < 160; track++) {
+			Storage::Encodings::MFM::sectors_from_segment(Storage::Disk::PCMSegment(segment), true);
+		}
+	}];
+}
+
+@end
@@ -9,8 +9,11 @@
 #import <XCTest/XCTest.h>
 
 #include "Tables.hpp"
+#include "OPLL.hpp"
 
 #include <cmath>
+#include <memory>
+#include <vector>
 
 @interface OPLTests: XCTestCase
 @end
@@ -31,6 +34,29 @@
 	}
 }
 
+// MARK: - Performance
+
+- (void)testOPLLPerformance {
+	// Approximate an MSX-MUSIC workload: the OPLL at the MSX's clock rate, with all
+	// nine melodic channels keyed on, using a spread of instruments and notes.
+	Concurrency::DeferringAsyncTaskQueue queue;
+	const auto opll = std::make_shared<Yamaha::OPL::OPLL>(queue);
+	opll->set_sample_volume_range(32767);
+	for(uint8_t c = 0; c < 9; c++) {
+		opll->write(0, 0x30 + c);	opll->write(1, uint8_t(((c + 1) << 4) | c));
+		opll->write(0, 0x10 + c);	opll->write(1, uint8_t(0x80 + c * 23));
+		opll->write(0, 0x20 + c);	opll->write(1, uint8_t(0x18 | (c & 3) << 1));
+	}
+	queue.perform();
+	queue.flush();
+
+	// Generate one second of output per measurement.
+	__block std::vector<int16_t> samples(3579545);
+	[self measureBlock:^{
+		opll->get_samples(samples.size(), samples.data());
+	}];
+}
+
 // MARK: - Two-operator FM tests
 
 /*- (void)compareFMTo:(NSArray *)knownGood atAttenuation:(int)attenuation {
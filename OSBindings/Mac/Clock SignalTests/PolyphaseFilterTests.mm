@@ -0,0 +1,122 @@
+//
+//  PolyphaseFilterTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "PolyphaseFilter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr double Amplitude = 16384.0;
+
+/// @returns A sine wave of @c frequency, sampled at @c rate.
+std::vector<short> sine(double frequency, double rate) {
+	std::vector<short> samples(8192);
+	for(size_t c = 0; c < samples.size(); c++) {
+		samples[c] = short(Amplitude * std::sin(2.0 * M_PI * frequency * double(c) / rate));
+	}
+	return samples;
+}
+
+/// @returns The largest output that @c filter produces for a sine wave of @c frequency, as a proportion of the input amplitude, across all phases.
+double gain(const SignalProcessing::PolyphaseFilter &filter, double frequency, double rate) {
+	const auto samples = sine(frequency, rate);
+	double largest = 0.0;
+	for(size_t phase = 0; phase < filter.get_number_of_phases(); phase++) {
+		for(size_t offset = 0; offset < 4000; offset += 7) {
+			largest = std::max(largest, std::abs(double(filter.apply(&samples[offset], phase))));
+		}
+	}
+	return largest / Amplitude;
+}
+
+}
+
+@interface PolyphaseFilterTests : XCTestCase
+@end
+
+@implementation PolyphaseFilterTests
+
+/// @returns A filter as LowpassSpeaker would select for 2Mhz input and 44.1Khz output.
+- (SignalProcessing::PolyphaseFilter)speakerFilter {
+	return SignalProcessing::PolyphaseFilter(185, 12, 2000000.0f, 22050.0f);
+}
+
+- (void)testPassband {
+	const auto filter = [self speakerFilter];
+	const double result = 20.0 * std::log10(gain(filter, 1000.0, 2000000.0));
+	XCTAssert(std::abs(result) < 0.1, @"1Khz was scaled by %0.2fdB", result);
+}
+
+- (void)testStopband {
+	const auto filter = [self speakerFilter];
+	for(double frequency: {44100.0, 60000.0, 100000.0, 400000.0}) {
+		const double result = 20.0 * std::log10(gain(filter, frequency, 2000000.0));
+		XCTAssert(result < -50.0, @"%0.0fHz was attenuated by only %0.2fdB", frequency, -result);
+	}
+}
+
+- (void)testPhaseOffsets {
+	// Each phase should produce the input as at its fractional offset beyond the centre of the window.
+	const double rate = 48000.0;
+	const double frequency = 3000.0;
+	const size_t taps = 63;
+	const SignalProcessing::PolyphaseFilter filter(taps, 16, float(rate), 12000.0f);
+	const auto samples = sine(frequency, rate);
+
+	for(size_t phase = 0; phase < filter.get_number_of_phases(); phase++) {
+		for(size_t offset = 0; offset < 4000; offset += 13) {
+			const double position = double(offset) + double(taps - 1) / 2.0 + double(phase) / double(filter.get_number_of_phases());
+			const double expected = Amplitude * std::sin(2.0 * M_PI * frequency * position / rate);
+			const short result = filter.apply(&samples[offset], phase);
+			XCTAssert(std::abs(double(result) - expected) < 16.0, @"Phase %zu at offset %zu produced %d; expected %0.1f", phase, offset, result, expected);
+		}
+	}
+}
+
+// MARK: - Performance.
+
+- (void)measureStereo:(BOOL)stereo {
+	const auto filter = [self speakerFilter];
+	std::minstd_rand generator{0x9017};
+	std::vector<short> samples(8192);
+	for(auto &sample: samples) {
+		sample = short(generator());
+	}
+
+	const size_t span = filter.get_number_of_taps() * (stereo ? 2 : 1);
+	const size_t limit = samples.size() - span;
+	const size_t phases = filter.get_number_of_phases();
+	const short *const source = samples.data();
+	__block int total = 0;
+
+	[self measureBlock:^{
+		// Produce a million outputs, at shifting offsets and phases.
+		short results[2];
+		for(size_t c = 0; c < 1000000; c++) {
+			const size_t offset = (c * 2) % limit;
+			const size_t phase = c % phases;
+			if(stereo) {
+				filter.apply_stereo(&source[offset], phase, results);
+				total += results[0] + results[1];
+			} else {
+				total += filter.apply(&source[offset], phase);
+			}
+		}
+	}];
+}
+
+- (void)testMonoPerformance		{	[self measureStereo:NO];	}
+- (void)testStereoPerformance	{	[self measureStereo:YES];	}
+
+@end
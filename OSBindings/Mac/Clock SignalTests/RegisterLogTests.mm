@@ -0,0 +1,184 @@
+//
+//  RegisterLogTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/OPx/OPLL.hpp"
+#include "../../../Components/SN76489/SN76489.hpp"
+#include "../../../Outputs/Speaker/Implementation/CompoundSource.hpp"
+#include "../../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../../Outputs/Speaker/Implementation/RegisterLog.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+struct SampleCollector: public Outputs::Speaker::Speaker::Delegate {
+	std::vector<int16_t> samples;
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
+		samples.insert(samples.end(), buffer.begin(), buffer.end());
+	}
+};
+
+/*!
+	Runs a Master System-style SN76489 and OPLL pair through a LowpassSpeaker for 200 frames, with 300
+	randomised writes per frame, either via the audio queue or via a register log.
+
+	@returns All samples output by the speaker.
+*/
+std::vector<int16_t> run_sound_chips(bool use_log) {
+	Concurrency::DeferringAsyncTaskQueue queue;
+	Outputs::Speaker::RegisterLog log(queue, 1 << 18);
+	TI::SN76489 sn76489(TI::SN76489::Personality::SMS, queue, 2);
+	Yamaha::OPL::OPLL opll(queue, 2);
+	Outputs::Speaker::CompoundSource<TI::SN76489, Yamaha::OPL::OPLL> mixer(sn76489, opll);
+	Outputs::Speaker::LowpassSpeaker<decltype(mixer)> speaker(mixer);
+
+	SampleCollector collector;
+	speaker.set_input_rate(3579545.0f / 2.0f);
+	speaker.set_output_rate(44100, 512, false);
+	speaker.set_delegate(&collector);
+	mixer.set_relative_volumes({0.5, 0.5});
+
+	if(use_log) {
+		sn76489.set_register_log(log);
+		opll.set_register_log(log);
+		speaker.set_register_log(log);
+	}
+
+	// Writes are restricted to the OPLL's melodic registers, as its noise source is randomly seeded.
+	std::mt19937 generator(1);
+	for(int frame = 0; frame < 200; frame++) {
+		int remaining = 59659 / 2;
+		for(int write = 0; write < 300; write++) {
+			const int step = remaining / (300 - write);
+			remaining -= step;
+
+			if(use_log) log.run_for(Cycles(step));
+			else speaker.run_for(queue, Cycles(step));
+
+			if(generator() & 1) {
+				sn76489.write(uint8_t(generator()));
+			} else {
+				opll.write(0, uint8_t(0x10 + generator() % 0x30));
+				opll.write(1, uint8_t(generator()));
+			}
+		}
+
+		if(use_log) {
+			log.run_for(Cycles(remaining));
+			log.perform();
+		} else {
+			speaker.run_for(queue, Cycles(remaining));
+			queue.perform();
+		}
+	}
+
+	if(use_log) log.flush();
+	else queue.flush();
+	return collector.samples;
+}
+
+}
+
+@interface RegisterLogTests : XCTestCase
+@end
+
+@implementation RegisterLogTests
+
+- (void)testOutputMatchesQueue {
+	const auto queued = run_sound_chips(false);
+	const auto logged = run_sound_chips(true);
+
+	XCTAssertGreaterThan(queued.size(), 0);
+	XCTAssertEqual(queued.size(), logged.size());
+	XCTAssert(queued == logged, @"Output via the register log differs from output via the queue");
+}
+
+- (void)testOrderingWithDeferredTasks {
+	Concurrency::DeferringAsyncTaskQueue queue;
+	Outputs::Speaker::RegisterLog log(queue, 4);	// Small enough to fill repeatedly.
+
+	std::vector<int> events;
+	const auto input = log.add_input(&events, [](void *target, uint16_t address, uint8_t) {
+		static_cast<std::vector<int> *>(target)->push_back(address);
+	});
+
+	// Each deferred task should be applied after all writes logged before the perform
+	// that schedules it, and before all writes logged after.
+	std::vector<int> expected;
+	int next = 0;
+	for(int batch = 0; batch < 50; batch++) {
+		const int writes = (batch * 7) % 11;
+		for(int c = 0; c < writes; c++) {
+			input.post(uint16_t(next), 0);
+			expected.push_back(next);
+			++next;
+		}
+
+		const int marker = 10000 + batch;
+		queue.defer([&events, marker] {
+			events.push_back(marker);
+		});
+
+		// Post a few more after the deferral; these too precede the marker.
+		for(int c = 0; c < batch % 3; c++) {
+			input.post(uint16_t(next), 0);
+			expected.push_back(next);
+			++next;
+		}
+		expected.push_back(marker);
+
+		log.perform();
+	}
+	log.flush();
+
+	XCTAssert(events == expected, @"Writes and deferred tasks were applied out of order");
+}
+
+// MARK: - Performance.
+
+- (void)measureEmulationThreadWithLog:(bool)useLog {
+	Concurrency::DeferringAsyncTaskQueue queue;
+	Outputs::Speaker::RegisterLog log(queue, 1 << 18);
+	TI::SN76489 sn76489(TI::SN76489::Personality::SMS, queue, 2);
+	Outputs::Speaker::LowpassSpeaker<TI::SN76489> speaker(sn76489);
+	speaker.set_input_rate(3579545.0f / 2.0f);
+	if(useLog) {
+		sn76489.set_register_log(log);
+		speaker.set_register_log(log);
+	}
+
+	// Measures only the emulation thread's costs: logging or deferring 90,000 writes.
+	[self measureBlock:^{
+		for(int frame = 0; frame < 300; frame++) {
+			for(int write = 0; write < 300; write++) {
+				if(useLog) log.run_for(Cycles(99));
+				else speaker.run_for(queue, Cycles(99));
+				sn76489.write(uint8_t(write));
+			}
+
+			if(useLog) log.perform();
+			else queue.perform();
+		}
+	}];
+
+	if(useLog) log.flush();
+	else queue.flush();
+}
+
+- (void)testQueuePerformance {
+	[self measureEmulationThreadWithLog:false];
+}
+
+- (void)testLogPerformance {
+	[self measureEmulationThreadWithLog:true];
+}
+
+@end
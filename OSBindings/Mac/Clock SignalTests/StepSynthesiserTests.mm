@@ -0,0 +1,164 @@
+//
+//  StepSynthesiserTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "StepSynthesiser.hpp"
+#include "KaiserBessel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr float InputRate = 1000000.0f;
+constexpr float OutputRate = 44100.0f;
+
+// Kernels are quantised to 14 bits, so the error in output at any instant is a small proportion of
+// the sum of the steps that overlap it; permit 1/256th of a full-range 16-bit step.
+constexpr int MaximumError = 65536 / 256;
+
+/*!
+	Computes, in floating point, the band-limited output expected for a list of (offset, amount) steps,
+	as per the StepSynthesiser's design for a cut-off of 0.45 of the output rate: each step is a
+	32-tap Kaiser-windowed sinc, delayed by half its length and positioned to within 1/64th of an
+	output sample, integrated and clamped to 16 bits.
+*/
+std::vector<int> reference(const std::vector<std::pair<size_t, int>> &steps, size_t count) {
+	constexpr double cutoff = 0.45;
+	constexpr size_t taps = 32;
+	constexpr double half_width = double(taps) / 2.0;
+	const double alpha = SignalProcessing::KaiserBessel::alpha(60.0);
+	const double i0_alpha = SignalProcessing::KaiserBessel::ino(alpha);
+	const uint64_t input_sample_length = uint64_t((double(OutputRate) / double(InputRate)) * 4294967296.0);
+
+	std::vector<double> deltas(count + taps);
+	for(const auto &step: steps) {
+		const uint64_t position = step.first * input_sample_length;
+		const size_t index = size_t(position >> 32);
+		const double phase = double((position >> 26) & 63) / 64.0;
+
+		std::vector<double> kernel(taps);
+		double total = 0.0;
+		for(size_t tap = 0; tap < taps; tap++) {
+			const double t = double(tap) - half_width - phase;
+			const double x = t / half_width;
+			const double window = (x > -1.0 && x < 1.0) ? SignalProcessing::KaiserBessel::window(x, alpha, i0_alpha) : 0.0;
+			const double sinc = (t == 0.0) ? 1.0 : std::sin(2.0 * M_PI * cutoff * t) / (2.0 * M_PI * cutoff * t);
+			kernel[tap] = window * sinc;
+			total += kernel[tap];
+		}
+		for(size_t tap = 0; tap < taps; tap++) {
+			if(index + tap < deltas.size()) deltas[index + tap] += double(step.second) * kernel[tap] / total;
+		}
+	}
+
+	std::vector<int> output(count);
+	double level = 0.0;
+	for(size_t c = 0; c < count; c++) {
+		level += deltas[c];
+		output[c] = std::clamp(int(std::floor(level)), -32768, 32767);
+	}
+	return output;
+}
+
+/// @returns The largest difference between the StepSynthesiser's output for @c steps, within a single period of @c length input samples, and the reference.
+int largest_error(const std::vector<std::pair<size_t, int>> &steps, size_t length) {
+	SignalProcessing::StepSynthesiser synthesiser;
+	synthesiser.set_parameters(InputRate, OutputRate, OutputRate / 2.0f);
+	for(const auto &step: steps) {
+		synthesiser.add_step(step.first, step.second);
+	}
+	const size_t count = synthesiser.end_period(length);
+	std::vector<int16_t> output(count);
+	synthesiser.get_samples(count, output.data());
+
+	const auto expected = reference(steps, count);
+	int error = 0;
+	for(size_t c = 0; c < count; c++) {
+		error = std::max(error, std::abs(int(output[c]) - expected[c]));
+	}
+	return error;
+}
+
+/// @returns Steps that toggle between @c low and @c high every @c interval input samples, for @c length input samples.
+std::vector<std::pair<size_t, int>> square_wave(int low, int high, size_t interval, size_t length) {
+	std::vector<std::pair<size_t, int>> steps;
+	int level = 0;
+	for(size_t offset = 0; offset < length; offset += interval) {
+		const int target = (offset / interval) & 1 ? low : high;
+		steps.emplace_back(offset, target - level);
+		level = target;
+	}
+	return steps;
+}
+
+}
+
+@interface StepSynthesiserTests : XCTestCase
+@end
+
+@implementation StepSynthesiserTests
+
+- (void)testIsolatedSteps {
+	// Full-range steps, at arbitrary positions but far enough apart not to overlap.
+	std::minstd_rand generator{0x5729};
+	std::vector<std::pair<size_t, int>> steps;
+	int level = -32768;
+	size_t offset = 0;
+	for(int c = 0; c < 64; c++) {
+		offset += 2000 + generator() % 1000;
+		const int target = level < 0 ? 32767 : -32768;
+		steps.emplace_back(offset, target - level);
+		level = target;
+	}
+
+	const int error = largest_error(steps, offset + 2000);
+	XCTAssert(error <= 32, @"Output differed from reference by up to %d", error);
+}
+
+- (void)testCloseSteps {
+	// Full-range steps at a variety of intervals, including those at which the kernels
+	// of successive steps reinforce one another most.
+	for(size_t interval = 1; interval < 80; interval++) {
+		const int error = largest_error(square_wave(-32768, 32767, interval, 20000), 20000);
+		XCTAssert(error <= MaximumError, @"Output for steps %zu input samples apart differed from reference by up to %d", interval, error);
+	}
+}
+
+- (void)testOverdrivenSteps {
+	// Steps larger than the 16-bit output range, as may occur when several channels are summed,
+	// should clip rather than overflow.
+	for(size_t interval = 20; interval < 40; interval++) {
+		const int error = largest_error(square_wave(-131072, 131071, interval, 20000), 20000);
+		XCTAssert(error <= MaximumError * 4, @"Output for steps %zu input samples apart differed from reference by up to %d", interval, error);
+	}
+}
+
+// MARK: - Performance.
+
+- (void)testPerformance {
+	const auto steps = square_wave(-32768, 32767, 7, 1000000);
+	std::vector<int16_t> output(50000);
+	int16_t *const target = output.data();
+
+	[self measureBlock:^{
+		SignalProcessing::StepSynthesiser synthesiser;
+		synthesiser.set_parameters(InputRate, OutputRate, OutputRate / 2.0f);
+		for(const auto &step: steps) {
+			synthesiser.add_step(step.first, step.second);
+		}
+		const size_t count = synthesiser.end_period(1000000);
+		synthesiser.get_samples(count, target);
+	}];
+}
+
+@end
@@ -9,6 +9,36 @@
 #import <XCTest/XCTest.h>
 
 #include "Storage.hpp"
+#include "TimedEventLoop.hpp"
+
+namespace {
+
+/// Counts events at a fixed interval, recording the cycle at which the most recent occurred.
+class EventCounter: public Storage::TimedEventLoop {
+	public:
+		EventCounter(Cycles::IntType clock_rate, Storage::Time interval) :
+			Storage::TimedEventLoop(clock_rate), interval_(interval) {
+			set_next_event_time_interval(interval_);
+		}
+
+		uint64_t events = 0;
+		uint64_t cycles = 0;
+		uint64_t last_event_cycle = 0;
+
+	private:
+		void process_next_event() final {
+			++events;
+			last_event_cycle = cycles;
+			set_next_event_time_interval(interval_);
+		}
+		void advance(const Cycles cycles) final {
+			this->cycles += uint64_t(cycles.as_integral());
+		}
+
+		Storage::Time interval_;
+};
+
+}
 
 @interface TimeTests : XCTestCase
 @end
@@ -41,4 +71,37 @@
 	XCTAssert(time == Storage::Time::max(), @"Numbers too big to be represented should saturate");
 }
 
+- (void)testFixedPointConversion
+{
+	const Storage::Time times[] = {
+		Storage::Time(1, 44100), Storage::Time(3, 7), Storage::Time(12345, 3500000), Storage::Time(2, 1)
+	};
+	const uint32_t rates[] = {1000000, 985248 * 2, 8000000, 7};
+
+	for(const auto &time: times) {
+		for(const auto rate: rates) {
+			// Compare to the rational result, calculated with enough precision to be exact.
+			const uint64_t fixed = time.get_fixed_cycles(rate);
+			const long double exact = (long double)(time.length) * (long double)(rate) / (long double)(time.clock_rate);
+			const long double difference = exact - (long double)(fixed) / 4294967296.0L;
+			XCTAssert(difference >= 0.0L && difference < 1.0L / 4294967296.0L, @"%u/%u at %u should convert exactly to 32.32", time.length, time.clock_rate, rate);
+		}
+	}
+}
+
+- (void)testEventLoopLongRunAccuracy
+{
+	// Run for a simulated hour at 1Mhz with an event rate of 44.1Khz; the rational answer is
+	// that there are 158,760,000 events and that the final one falls exactly on the final cycle.
+	// Fixed point truncation permits that final event to be at most a single cycle early.
+	const Cycles::IntType clock_rate = 1000000;
+	EventCounter counter(clock_rate, Storage::Time(1, 44100));
+	for(int c = 0; c < 3600; c++) {
+		counter.run_for(Cycles(clock_rate));
+	}
+
+	XCTAssertEqual(counter.events, 158760000ull, @"Event count should match the rational result");
+	XCTAssertLessThanOrEqual(3600ull * uint64_t(clock_rate) - counter.last_event_cycle, 1ull, @"Final event should be no more than a cycle early");
+}
+
 @end
@@ -0,0 +1,165 @@
+//
+//  WD1770Tests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/1770/1770.hpp"
+#include "../../../Storage/Disk/Disk.hpp"
+#include "../../../Storage/Disk/Encodings/MFM/Encoder.hpp"
+
+#include <map>
+#include <vector>
+
+namespace {
+
+/// A single-sided, forty-track disk of nine 512-byte sectors per track, formed as if from a sector image.
+struct SectorImageDisk: public Storage::Disk::Disk {
+	Storage::Disk::HeadPosition get_maximum_head_position() final {
+		return Storage::Disk::HeadPosition(40);
+	}
+
+	int get_head_count() final {
+		return 1;
+	}
+
+	std::shared_ptr<Storage::Disk::Track> get_track_at_position(Storage::Disk::Track::Address address) final {
+		const int track = address.position.as_int();
+		auto &result = tracks_[track];
+		if(!result) {
+			std::vector<Storage::Encodings::MFM::Sector> sectors(9);
+			for(int c = 0; c < 9; c++) {
+				auto &sector = sectors[size_t(c)];
+				sector.address.track = uint8_t(track);
+				sector.address.side = 0;
+				sector.address.sector = uint8_t(c + 1);
+				sector.size = 2;
+				sector.samples.emplace_back(512);
+				for(int b = 0; b < 512; b++) {
+					sector.samples[0][size_t(b)] = uint8_t(b*7 + c*13 + track);
+				}
+			}
+			result = Storage::Encodings::MFM::GetMFMTrackWithSectors(sectors);
+		}
+		return std::shared_ptr<Storage::Disk::Track>(result->clone());
+	}
+
+	void set_track_at_position(Storage::Disk::Track::Address address, const std::shared_ptr<Storage::Disk::Track> &track) final {
+		tracks_[address.position.as_int()] = track;
+	}
+
+	void flush_tracks() final {}
+
+	bool get_is_read_only() final {
+		return false;
+	}
+
+	bool tracks_differ(Storage::Disk::Track::Address lhs, Storage::Disk::Track::Address rhs) final {
+		return !(lhs == rhs);
+	}
+
+	private:
+		std::map<int, std::shared_ptr<Storage::Disk::Track>> tracks_;
+};
+
+struct WD1772: public WD::WD1770 {
+	WD1772(bool allows_direct_reading) : WD::WD1770(WD::WD1770::P1772) {
+		emplace_drives(1, 8000000, 300, 1);
+		set_is_double_density(true);
+		set_allows_direct_reading(allows_direct_reading);
+		get_drive(0).set_disk(std::make_shared<SectorImageDisk>());
+		set_drive(1);
+	}
+
+	void set_motor_on(bool motor_on) final {
+		get_drive(0).set_motor_on(motor_on);
+	}
+
+	/// Performs @c command, servicing data requests, and returns all bytes read followed by the final status.
+	std::vector<uint8_t> perform(uint8_t command, const std::vector<uint8_t> &output = {}) {
+		const bool is_write = (command & 0xe0) == 0xa0;
+		std::vector<uint8_t> input;
+		size_t output_pointer = 0;
+
+		write(0, command);
+		for(int c = 0; c < 8000000 * 3; c += 16) {
+			run_for(Cycles(16));
+			if(get_data_request_line()) {
+				if(is_write) {
+					write(3, output_pointer < output.size() ? output[output_pointer++] : 0);
+				} else {
+					input.push_back(read(3));
+				}
+			}
+			if(c > 1000 && !(read(0) & 1)) break;
+		}
+
+		input.push_back(read(0));
+		return input;
+	}
+};
+
+}
+
+@interface WD1770Tests : XCTestCase
+@end
+
+@implementation WD1770Tests
+
+/// @returns The results of a sequence of seeks, sector reads, read-address commands and a write, in order.
+- (std::vector<std::vector<uint8_t>>)resultsWithDirectReading:(bool)allowsDirectReading {
+	WD1772 fdc(allowsDirectReading);
+	std::vector<std::vector<uint8_t>> results;
+
+	// Restore, with a known track register so that both runs step identically.
+	fdc.write(1, 0);
+	results.push_back(fdc.perform(0x00));
+
+	for(int track = 0; track < 40; track += 13) {
+		fdc.write(3, uint8_t(track));
+		results.push_back(fdc.perform(0x10));
+
+		for(int sector = 1; sector <= 9; sector++) {
+			fdc.write(2, uint8_t(sector));
+			results.push_back(fdc.perform(0x80));
+		}
+		results.push_back(fdc.perform(0xc0));
+
+		if(track == 13) {
+			// Write a sector; the written track will no longer be eligible for direct reading,
+			// so this also tests the fallback to flux.
+			std::vector<uint8_t> data(512);
+			for(size_t c = 0; c < data.size(); c++) data[c] = uint8_t(c ^ 0x5a);
+
+			fdc.write(2, 2);
+			results.push_back(fdc.perform(0xa0, data));
+
+			fdc.write(2, 2);
+			const auto read_back = fdc.perform(0x80);
+			XCTAssert(std::equal(data.begin(), data.end(), read_back.begin()), @"Written sector didn't read back");
+			results.push_back(read_back);
+		}
+	}
+
+	return results;
+}
+
+- (void)testDirectReadingMatchesFlux {
+	const auto flux = [self resultsWithDirectReading:false];
+	const auto direct = [self resultsWithDirectReading:true];
+
+	XCTAssertEqual(flux.size(), direct.size());
+	for(size_t c = 0; c < std::min(flux.size(), direct.size()); c++) {
+		XCTAssert(flux[c] == direct[c], @"Command %zu produced different results", c);
+	}
+
+	// Sanity check: each sector read should have produced 512 bytes plus a clean status.
+	XCTAssertEqual(flux[2].size(), 513);
+	XCTAssertEqual(flux[2].back() & 0x1c, 0);
+}
+
+@end
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -24,6 +25,8 @@
 #include "../../Analyser/Static/StaticAnalyser.hpp"
 #include "../../Machines/Utility/MachineForTarget.hpp"
 
+#include "../../Concurrency/RingBuffer.hpp"
+
 #include "../../ClockReceiver/TimeTypes.hpp"
 #include "../../ClockReceiver/ScanSynchroniser.hpp"
 
@@ -33,12 +36,102 @@
 #include "../../Outputs/OpenGL/Primitives/Rectangle.hpp"
 #include "../../Outputs/OpenGL/ScanTarget.hpp"
 #include "../../Outputs/OpenGL/Screenshot.hpp"
+#include "../../Outputs/Speaker/CaptureSink.hpp"
 
 #include "../../Reflection/Enum.hpp"
 #include "../../Reflection/Struct.hpp"
 
 namespace {
 
+struct SpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
+	// The number of sample frames to request that SDL collect per callback, and that the speaker provide per packet.
+	static constexpr size_t device_samples = 512;
+	static constexpr size_t speaker_samples = 256;
+
+	// The number of frames that rate control will try to keep buffered in addition to SDL's own
+	// buffer, which needs to cover one device callback's worth of samples plus timer jitter. If a
+	// stall leaves more than maximum_buffered_samples waiting then the excess is discarded.
+	static constexpr size_t target_buffered_samples = device_samples * 2;
+	static constexpr size_t maximum_buffered_samples = target_buffered_samples * 4;
+
+	bool is_stereo = false;
+	SDL_AudioDeviceID audio_device;
+
+	/// Sets the speaker to output to, at the nominal rate @c output_rate.
+	void set_speaker(Outputs::Speaker::Speaker *speaker, float output_rate, bool stereo) {
+		speaker_ = speaker;
+		output_rate_ = output_rate;
+		is_stereo = stereo;
+		applied_correction_ = 1.0;
+		speaker_->set_output_rate(output_rate_, speaker_samples, is_stereo);
+		speaker_->set_delegate(this);
+	}
+
+	/*!
+		Adjusts the speaker's output rate by up to ±0.5% in order to keep the amount of buffered audio
+		close to target_buffered_samples, so that audio keeps pace with the host's audio clock
+		regardless of the rate at which the machine is being run. Should be called periodically from
+		whichever thread updates the machine, while holding its lock.
+	*/
+	void update_rate_control() {
+		if(!speaker_) return;
+
+		// Smooth over the sawtooth caused by packetised production and consumption.
+		const double fill = double(audio_buffer_.size() / (is_stereo ? 2 : 1)) / double(target_buffered_samples);
+		average_fill_ += (fill - average_fill_) * 0.02;
+
+		// If overfull, produce fewer samples per second; if underfull, more. A slow integral term
+		// absorbs any constant difference between clocks, so that the fill level settles on target.
+		// Quantise to avoid churning the speaker's configuration for inconsequential changes.
+		const double error = average_fill_ - 1.0;
+		integrated_error_ = std::clamp(integrated_error_ + error * 0.000002, -0.005, 0.005);
+		const double correction = std::round(
+			(1.0 - std::clamp(error * 0.002 + integrated_error_, -0.005, 0.005)) * 10000.0
+		) / 10000.0;
+		if(correction != applied_correction_) {
+			applied_correction_ = correction;
+			speaker_->set_output_rate(float(double(output_rate_) * correction), speaker_samples, is_stereo);
+		}
+	}
+
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
+		// Anything that doesn't fit is dropped; rate control should ensure that doesn't happen.
+		audio_buffer_.write(buffer.data(), buffer.size());
+	}
+
+	void audio_callback(Uint8 *stream, int len) {
+		// SDL buffer length is in bytes, so there's no need to adjust for stereo/mono in here.
+		const std::size_t sample_length = size_t(len) / sizeof(int16_t);
+		int16_t *const target = static_cast<int16_t *>(static_cast<void *>(stream));
+
+		// If there's a large backlog, as after a stall, discard the oldest part to restore latency.
+		const size_t channels = is_stereo ? 2 : 1;
+		const size_t buffered = audio_buffer_.size() / channels;
+		if(buffered > maximum_buffered_samples) {
+			audio_buffer_.discard((buffered - target_buffered_samples) * channels);
+		}
+
+		const std::size_t copy_length = audio_buffer_.read(target, sample_length);
+		if(copy_length < sample_length) {
+			std::memset(&target[copy_length], 0, (sample_length - copy_length) * sizeof(int16_t));
+		}
+	}
+
+	static void SDL_audio_callback(void *userdata, Uint8 *stream, int len) {
+		reinterpret_cast<SpeakerDelegate *>(userdata)->audio_callback(stream, len);
+	}
+
+	private:
+		// Written by the thread that runs the speaker, read by SDL's audio thread.
+		Concurrency::RingBuffer<int16_t> audio_buffer_{maximum_buffered_samples * 4};
+
+		Outputs::Speaker::Speaker *speaker_ = nullptr;
+		float output_rate_ = 0.0f;
+		double average_fill_ = 0.0;
+		double integrated_error_ = 0.0;
+		double applied_correction_ = 1.0;
+};
+
 struct MachineRunner {
 	MachineRunner() {
 		frame_lock_.clear();
@@ -92,6 +185,7 @@ struct MachineRunner {
 
 	std::mutex *machine_mutex;
 	Machine::DynamicMachine *machine;
+	SpeakerDelegate *speaker_delegate = nullptr;
 
 	private:
 		SDL_TimerID timer_ = 0;
@@ -168,46 +262,11 @@ struct MachineRunner {
 				timed_machine->run_for(double(time_now - last_time_) / 1e9);
 			}
 			last_time_ = time_now;
-		}
-};
 
-struct SpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
-	// This is empirically the best that I can seem to do with SDL's timer precision.
-	static constexpr size_t buffered_samples = 1024;
-	bool is_stereo = false;
-
-	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
-		std::lock_guard lock_guard(audio_buffer_mutex_);
-		const size_t buffer_size = buffered_samples * (is_stereo ? 2 : 1);
-		if(audio_buffer_.size() > buffer_size) {
-			audio_buffer_.erase(audio_buffer_.begin(), audio_buffer_.end() - buffer_size);
-		}
-		audio_buffer_.insert(audio_buffer_.end(), buffer.begin(), buffer.end());
-	}
-
-	void audio_callback(Uint8 *stream, int len) {
-		std::lock_guard lock_guard(audio_buffer_mutex_);
-
-		// SDL buffer length is in bytes, so there's no need to adjust for stereo/mono in here.
-		const std::size_t sample_length = size_t(len) / sizeof(int16_t);
-		const std::size_t copy_length = std::min(sample_length, audio_buffer_.size());
-		int16_t *const target = static_cast<int16_t *>(static_cast<void *>(stream));
-
-		std::memcpy(stream, audio_buffer_.data(), copy_length * sizeof(int16_t));
-		if(copy_length < sample_length) {
-			std::memset(&target[copy_length], 0, (sample_length - copy_length) * sizeof(int16_t));
+			if(speaker_delegate) {
+				speaker_delegate->update_rate_control();
+			}
 		}
-		audio_buffer_.erase(audio_buffer_.begin(), audio_buffer_.begin() + copy_length);
-	}
-
-	static void SDL_audio_callback(void *userdata, Uint8 *stream, int len) {
-		reinterpret_cast<SpeakerDelegate *>(userdata)->audio_callback(stream, len);
-	}
-
-	SDL_AudioDeviceID audio_device;
-
-	std::mutex audio_buffer_mutex_;
-	std::vector<int16_t> audio_buffer_;
 };
 
 class ActivityObserver: public Activity::Observer {
@@ -488,7 +547,7 @@ int main(int argc, char *argv[]) {
 	const ParsedArguments arguments = parse_arguments(argc, argv);
 
 	// This may be printed either as
-	const std::string usage_suffix = " [file or --new={machine}] [OPTIONS] [--rompath={path to ROMs}] [--speed={speed multiplier, e.g. 1.5}]  [--logical-keyboard] [--volume={0.0 to 1.0}]";
+	const std::string usage_suffix = " [file or --new={machine}] [OPTIONS] [--rompath={path to ROMs}] [--speed={speed multiplier, e.g. 1.5}]  [--logical-keyboard] [--volume={0.0 to 1.0}] [--record-audio={path to .wav or raw file}]";
 
 	// Print a help message if requested.
 	if(arguments.selections.find("help") != arguments.selections.end() || arguments.selections.find("h") != arguments.selections.end()) {
@@ -645,6 +704,7 @@ int main(int argc, char *argv[]) {
 
 	MachineRunner machine_runner;
 	SpeakerDelegate speaker_delegate;
+	std::unique_ptr<Outputs::Speaker::CaptureSink> audio_capture;
 
 	// For vanilla SDL purposes, assume system ROMs can be found in one of:
 	//
@@ -856,15 +916,39 @@ int main(int argc, char *argv[]) {
 		desired_audio_spec.freq = 48000;	// TODO: how can I get SDL to reveal the output rate of this machine?
 		desired_audio_spec.format = AUDIO_S16;
 		desired_audio_spec.channels = 1 + int(speaker->get_is_stereo());
-		desired_audio_spec.samples = Uint16(SpeakerDelegate::buffered_samples);
+		desired_audio_spec.samples = Uint16(SpeakerDelegate::device_samples);
 		desired_audio_spec.callback = SpeakerDelegate::SDL_audio_callback;
 		desired_audio_spec.userdata = &speaker_delegate;
 
 		speaker_delegate.audio_device = SDL_OpenAudioDevice(nullptr, 0, &desired_audio_spec, &obtained_audio_spec, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
 
-		speaker->set_output_rate(obtained_audio_spec.freq, desired_audio_spec.samples, obtained_audio_spec.channels == 2);
-		speaker_delegate.is_stereo = obtained_audio_spec.channels == 2;
-		speaker->set_delegate(&speaker_delegate);
+		speaker_delegate.set_speaker(speaker, float(obtained_audio_spec.freq), obtained_audio_spec.channels == 2);
+		machine_runner.speaker_delegate = &speaker_delegate;
+
+		// If audio recording was requested, interpose a capture sink between the speaker and the audio pipe.
+		const auto record_argument = arguments.selections.find("record-audio");
+		if(record_argument != arguments.selections.end() && !record_argument->second.empty()) {
+			const std::string &file_name = record_argument->second;
+			const std::string wav_suffix = ".wav";
+			const bool is_wav =
+				file_name.size() >= wav_suffix.size() &&
+				std::equal(
+					wav_suffix.begin(), wav_suffix.end(),
+					file_name.end() - ptrdiff_t(wav_suffix.size()), file_name.end(),
+					[](char a, char b) { return tolower(b) == tolower(a); });
+
+			try {
+				audio_capture = std::make_unique<Outputs::Speaker::CaptureSink>(
+					file_name,
+					is_wav ? Outputs::Speaker::CaptureSink::Format::WAV : Outputs::Speaker::CaptureSink::Format::Raw,
+					obtained_audio_spec.freq,
+					obtained_audio_spec.channels == 2);
+				audio_capture->set_next_delegate(&speaker_delegate);
+				speaker->set_delegate(audio_capture.get());
+			} catch(...) {
+				std::cerr << "Unable to open " << file_name << " to record audio." << std::endl;
+			}
+		}
 		SDL_PauseAudioDevice(speaker_delegate.audio_device, 0);
 	}
 
@@ -1247,6 +1331,13 @@ int main(int argc, char *argv[]) {
 
 	// Clean up.
 	machine_runner.stop();	// Ensure no further updates will occur.
+	if(audio_capture) {
+		machine->audio_producer()->get_speaker()->set_delegate(nullptr);
+		if(audio_capture->dropped_packets()) {
+			std::cerr << "Audio recording is incomplete; " << audio_capture->dropped_packets() << " packets were dropped." << std::endl;
+		}
+		audio_capture.reset();	// Finalise the recording.
+	}
 	joysticks.clear();
 	SDL_DestroyWindow( window );
 	SDL_Quit();
@@ -64,33 +64,45 @@ void CRT::set_new_timing(int cycles_per_line, int height_of_display, Outputs::Di
 	scan_target_modals_.composite_colour_space = colour_space;
 	scan_target_modals_.colour_cycle_numerator = colour_cycle_numerator;
 	scan_target_modals_.colour_cycle_denominator = colour_cycle_denominator;
-	scan_target_->set_modals(scan_target_modals_);
+	post_modals();
 }
 
 void CRT::set_scan_target(Outputs::Display::ScanTarget *scan_target) {
 	scan_target_ = scan_target;
 	if(!scan_target_) scan_target_ = &Outputs::Display::NullScanTarget::singleton;
-	scan_target_->set_modals(scan_target_modals_);
+	post_modals();
 }
 
 void CRT::set_new_data_type(Outputs::Display::InputDataType data_type) {
 	scan_target_modals_.input_data_type = data_type;
-	scan_target_->set_modals(scan_target_modals_);
+	post_modals();
 }
 
 void CRT::set_aspect_ratio(float aspect_ratio) {
 	scan_target_modals_.aspect_ratio = aspect_ratio;
-	scan_target_->set_modals(scan_target_modals_);
+	post_modals();
 }
 
 void CRT::set_visible_area(Outputs::Display::Rect visible_area) {
 	scan_target_modals_.visible_area = visible_area;
-	scan_target_->set_modals(scan_target_modals_);
+	post_modals();
 }
 
 void CRT::set_display_type(Outputs::Display::DisplayType display_type) {
 	scan_target_modals_.display_type = display_type;
+	post_modals();
+}
+
+void CRT::post_modals() {
 	scan_target_->set_modals(scan_target_modals_);
+
+	// The scan target might discard or reinterpret whatever it is currently displaying,
+	// so don't permit repetition again until a complete frame has been output.
+	frame_must_be_output_ = true;
+}
+
+void CRT::set_is_repeating_frame(bool is_repeating_frame) {
+	repeat_is_requested_ = is_repeating_frame;
 }
 
 Outputs::Display::DisplayType CRT::get_display_type() const {
@@ -99,17 +111,17 @@ Outputs::Display::DisplayType CRT::get_display_type() const {
 
 void CRT::set_phase_linked_luminance_offset(float offset) {
 	scan_target_modals_.input_data_tweaks.phase_linked_luminance_offset = offset;
-	scan_target_->set_modals(scan_target_modals_);
+	post_modals();
 }
 
 void CRT::set_input_data_type(Outputs::Display::InputDataType input_data_type) {
 	scan_target_modals_.input_data_type = input_data_type;
-	scan_target_->set_modals(scan_target_modals_);
+	post_modals();
 }
 
 void CRT::set_brightness(float brightness) {
 	scan_target_modals_.brightness = brightness;
-	scan_target_->set_modals(scan_target_modals_);
+	post_modals();
 }
 
 void CRT::set_new_display_type(int cycles_per_line, Outputs::Display::Type displayType) {
@@ -138,7 +150,7 @@ void CRT::set_composite_function_type(CompositeSourceType type, float offset_of_
 
 void CRT::set_input_gamma(float gamma) {
 	scan_target_modals_.intended_gamma = gamma;
-	scan_target_->set_modals(scan_target_modals_);
+	post_modals();
 }
 
 CRT::CRT(	int cycles_per_line,
@@ -225,9 +237,13 @@ void CRT::advance_cycles(int number_of_cycles, bool hsync_requested, bool vsync_
 
 		// Determine whether to output any data for this portion of the output; if so then grab somewhere to put it.
 		const bool is_output_segment = ((is_output_run && next_run_length) && !horizontal_flywheel_->is_in_retrace() && !vertical_flywheel_->is_in_retrace());
-		Outputs::Display::ScanTarget::Scan *const next_scan = is_output_segment ? scan_target_->begin_scan() : nullptr;
+		Outputs::Display::ScanTarget::Scan *const next_scan = (is_output_segment && !is_repeating_frame_) ? scan_target_->begin_scan() : nullptr;
 		did_output |= is_output_segment;
 
+		// Something that should have been output but wasn't means that the display is now incomplete;
+		// that's not something to repeat.
+		frame_must_be_output_ |= is_output_segment && !is_repeating_frame_ && !next_scan;
+
 		// If outputting, store the start location and scan constants.
 		if(next_scan) {
 			next_scan->end_points[0] = end_point(uint16_t((total_cycles - number_of_cycles) * number_of_samples / total_cycles));
@@ -272,9 +288,12 @@ void CRT::advance_cycles(int number_of_cycles, bool hsync_requested, bool vsync_
 				colour_burst_amplitude_);
 
 			// If retrace is starting, update phase if required and mark no colour burst spotted yet.
+			// Also end any repetition that is no longer wanted; doing so only here ensures that the
+			// scan target never receives a partial line.
 			if(next_horizontal_sync_event == Flywheel::SyncEvent::StartRetrace) {
 				is_alernate_line_ ^= phase_alternates_;
 				colour_burst_amplitude_ = 0;
+				is_repeating_frame_ &= repeat_is_requested_ && !frame_must_be_output_;
 			}
 		}
 
@@ -292,6 +311,17 @@ void CRT::advance_cycles(int number_of_cycles, bool hsync_requested, bool vsync_
 
 		// if this is vertical retrace then advance a field
 		if(next_run_length == time_until_vertical_sync_event && next_vertical_sync_event == Flywheel::SyncEvent::EndRetrace) {
+			// Determine whether this field is a repeat, and announce it if so.
+			is_repeating_frame_ = repeat_is_requested_ && !frame_must_be_output_;
+			frame_must_be_output_ = false;
+			if(is_repeating_frame_) {
+				scan_target_->announce(
+					Outputs::Display::ScanTarget::Event::RepeatPreviousFrame,
+					!(horizontal_flywheel_->is_in_retrace() || vertical_flywheel_->is_in_retrace()),
+					end_point(uint16_t((total_cycles - number_of_cycles) * number_of_samples / total_cycles)),
+					colour_burst_amplitude_);
+			}
+
 			if(delegate_) {
 				frames_since_last_delegate_call_++;
 				if(frames_since_last_delegate_call_ == 20) {
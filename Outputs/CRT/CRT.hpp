@@ -81,6 +81,11 @@ class CRT {
 
 		Outputs::Display::ScanTarget *scan_target_ = &Outputs::Display::NullScanTarget::singleton;
 		Outputs::Display::ScanTarget::Modals scan_target_modals_;
+		void post_modals();
+
+		bool repeat_is_requested_ = false;			// @c true if the owner has most recently indicated that its output is a repeat of the previous frame; @c false otherwise.
+		bool is_repeating_frame_ = false;			// @c true if output is currently being withheld from the scan target as a repeat; @c false otherwise.
+		bool frame_must_be_output_ = true;			// @c true if something has happened since the start of the current frame that means the next can't be a repeat.
 		static constexpr uint8_t DefaultAmplitude = 41;	// Based upon a black level to maximum excursion and positive burst peak of: NTSC: 882 & 143; PAL: 933 & 150.
 
 #ifndef NDEBUG
@@ -234,7 +239,7 @@ class CRT {
 			@returns A pointer to the allocated area if room is available; @c nullptr otherwise.
 		*/
 		inline uint8_t *begin_data(std::size_t required_length, std::size_t required_alignment = 1) {
-			const auto result = scan_target_->begin_data(required_length, required_alignment);
+			const auto result = is_repeating_frame_ ? nullptr : scan_target_->begin_data(required_length, required_alignment);
 #ifndef NDEBUG
 			// If data was allocated, make a record of how much so as to be able to hold the caller to that
 			// contract later. If allocation failed, don't constrain the caller. This allows callers that
@@ -245,6 +250,19 @@ class CRT {
 			return result;
 		}
 
+		/*!	Indicates whether the caller knows its output to be identical to that of the previous frame.
+
+			Repetition begins at the start of the next frame, provided that the CRT has since output a complete frame
+			and that the scan target hasn't been changed or reconfigured. While repeating, the CRT continues to
+			process sync as usual but posts neither data nor scans; the scan target is notified via
+			@c Event::RepeatPreviousFrame and @c begin_data will return @c nullptr, so the caller can skip
+			serialising pixels.
+
+			Setting @c false, e.g. because memory that is being displayed has just been modified, ends repetition
+			from the next line; the caller should go back to requesting and populating data immediately.
+		*/
+		void set_is_repeating_frame(bool is_repeating_frame);
+
 		/*!	Sets the gamma exponent for the simulated screen. */
 		void set_input_gamma(float gamma);
 
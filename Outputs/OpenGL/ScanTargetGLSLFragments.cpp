@@ -207,6 +207,7 @@ std::string ScanTarget::sampling_function() const {
 	switch(modals.input_data_type) {
 		case InputDataType::Luminance1:
 		case InputDataType::Luminance8:
+		case InputDataType::PackedLuminance1:
 			// Easy, just copy across.
 			fragment_shader +=
 				is_svideo ?
@@ -535,6 +536,15 @@ std::unique_ptr<Shader> ScanTarget::composition_shader() const {
 			fragment_shader += "fragColour = textureLod(textureName, textureCoordinate, 0).rrrr / vec4(255.0);";
 		break;
 
+		case InputDataType::PackedLuminance1:
+			// Each texel holds eight pixels; pick a bit based on the fractional part of the texel position.
+			fragment_shader +=
+				"vec2 texelCoordinate = textureCoordinate * vec2(textureSize(textureName, 0));"
+				"uint textureValue = texelFetch(textureName, ivec2(texelCoordinate), 0).r;"
+				"uint bit = 7u - uint(fract(texelCoordinate.x) * 8.0);"
+				"fragColour = vec4(float((textureValue >> bit) & 1u));";
+		break;
+
 		case InputDataType::PhaseLinkedLuminance8:
 		case InputDataType::Luminance8Phase8:
 		case InputDataType::Red8Green8Blue8:
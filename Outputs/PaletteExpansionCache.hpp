@@ -0,0 +1,111 @@
+//
+//  PaletteExpansionCache.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef PaletteExpansionCache_hpp
+#define PaletteExpansionCache_hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Outputs {
+namespace Display {
+
+/*!
+	Maps each possible byte of video memory to all of the pixels that it produces, as a single
+	value of type @c EntryT that can be written directly to a CRT's data buffer.
+
+	Each entry is formed of sizeof(EntryT) / sizeof(PixelT) pixels, in memory order. @c Indexer
+	supplies the mapping from byte to palette entries, via a static function of the form:
+
+		static int index(uint8_t byte, int pixel);
+
+	...which should return the palette entry, less than @c PaletteSize, that determines the colour
+	of @c pixel within the output for @c byte.
+
+	The table is regenerated lazily: @c invalidate marks it stale, and the next call to
+	@c get regenerates it. A machine that has several modes can therefore invalidate all of its
+	tables upon any palette change but pay only for regenerating whichever it next uses, and
+	any number of palette changes between uses of a table cost only the first regeneration.
+
+	Invalidation can also be of a single palette entry, in which case only those table entries
+	that use it are regenerated, provided that no other palette entry has also changed.
+*/
+template <typename EntryT, typename Indexer, typename PixelT = uint8_t, int PaletteSize = 16> class PaletteExpansionCache {
+	public:
+		static constexpr int PixelsPerEntry = int(sizeof(EntryT) / sizeof(PixelT));
+		static_assert(PixelsPerEntry * sizeof(PixelT) == sizeof(EntryT), "Entries must hold a whole number of pixels");
+		static_assert(PaletteSize <= 32, "Palettes are limited to 32 entries");
+
+		/// Marks this table as requiring complete regeneration before its next use.
+		void invalidate() {
+			stale_entries_ = AllEntries;
+		}
+
+		/// Marks those parts of this table that use palette entry @c index as requiring regeneration before its next use.
+		void invalidate(int index) {
+			stale_entries_ |= uint32_t(1) << index;
+		}
+
+		/// @returns The table of 256 entries implied by @c palette, regenerating it first if it is stale.
+		const EntryT *get(const PixelT *palette) {
+			if(stale_entries_) {
+				// A single changed entry can be patched in; otherwise it's cheaper to rebuild.
+				if(stale_entries_ & (stale_entries_ - 1)) {
+					for(int byte = 0; byte < 256; byte++) {
+						update(uint8_t(byte), palette);
+					}
+				} else {
+					int index = 0;
+					while(!(stale_entries_ & (uint32_t(1) << index))) ++index;
+					for(const uint8_t byte: users()[size_t(index)]) {
+						update(byte, palette);
+					}
+				}
+				stale_entries_ = 0;
+			}
+			return table_;
+		}
+
+	private:
+		EntryT table_[256];
+
+		static constexpr uint32_t AllEntries = ~uint32_t(0);
+		uint32_t stale_entries_ = AllEntries;
+
+		void update(uint8_t byte, const PixelT *palette) {
+			PixelT *const target = reinterpret_cast<PixelT *>(&table_[byte]);
+			for(int pixel = 0; pixel < PixelsPerEntry; pixel++) {
+				target[pixel] = palette[Indexer::index(byte, pixel)];
+			}
+		}
+
+		/// @returns A list, per palette entry, of the bytes whose output uses it.
+		static const std::array<std::vector<uint8_t>, PaletteSize> &users() {
+			static const std::array<std::vector<uint8_t>, PaletteSize> users = [] {
+				std::array<std::vector<uint8_t>, PaletteSize> users;
+				for(int byte = 0; byte < 256; byte++) {
+					uint32_t used = 0;
+					for(int pixel = 0; pixel < PixelsPerEntry; pixel++) {
+						used |= uint32_t(1) << Indexer::index(uint8_t(byte), pixel);
+					}
+					for(int index = 0; index < PaletteSize; index++) {
+						if(used & (uint32_t(1) << index)) users[size_t(index)].push_back(uint8_t(byte));
+					}
+				}
+				return users;
+			}();
+			return users;
+		}
+};
+
+}
+}
+
+#endif /* PaletteExpansionCache_hpp */
@@ -55,8 +55,8 @@ enum class DisplayType {
 /*!
 	Enumerates the potential formats of input data.
 
-	All types are designed to be 1, 2 or 4 bytes per pixel; this hopefully creates appropriate alignment
-	on all formats.
+	All types are designed to be 1, 2 or 4 bytes per sample; this hopefully creates appropriate alignment
+	on all formats. A sample is a single pixel in all formats other than PackedLuminance1.
 */
 enum class InputDataType {
 
@@ -66,6 +66,10 @@ enum class InputDataType {
 	Luminance1,				// 1 byte/pixel; any bit set => white; no bits set => black.
 	Luminance8,				// 1 byte/pixel; linear scale.
 
+	PackedLuminance1,		// 1 byte/8 pixels; each bit is a pixel, most significant first;
+							// set => white; clear => black. Sample counts and offsets for this
+							// format are in bytes, so a run of n pixels is n/8 samples.
+
 	PhaseLinkedLuminance8,	// 4 bytes/pixel; each byte is an individual 8-bit luminance
 							// value and which value is output is a function of
 							// colour subcarrier phase — byte 0 defines the first quarter
@@ -97,6 +101,7 @@ constexpr inline size_t size_for_data_type(InputDataType data_type) {
 	switch(data_type) {
 		case InputDataType::Luminance1:
 		case InputDataType::Luminance8:
+		case InputDataType::PackedLuminance1:
 		case InputDataType::Red1Green1Blue1:
 		case InputDataType::Red2Green2Blue2:
 			return 1;
@@ -126,6 +131,7 @@ constexpr inline size_t data_type_is_normalised(InputDataType data_type) {
 
 		default:
 		case InputDataType::Luminance1:
+		case InputDataType::PackedLuminance1:
 		case InputDataType::Red1Green1Blue1:
 		case InputDataType::Red2Green2Blue2:
 		case InputDataType::Red4Green4Blue4:
@@ -140,6 +146,7 @@ constexpr inline DisplayType natural_display_type_for_data_type(InputDataType da
 		default:
 		case InputDataType::Luminance1:
 		case InputDataType::Luminance8:
+		case InputDataType::PackedLuminance1:
 		case InputDataType::PhaseLinkedLuminance8:
 			return DisplayType::CompositeColour;
 
@@ -360,6 +367,12 @@ struct ScanTarget {
 
 			BeginVerticalRetrace,
 			EndVerticalRetrace,
+
+			/// Posted immediately after an EndVerticalRetrace if the frame now beginning is known to be
+			/// identical to the previous. Retrace events will continue as usual but no scans or data will be
+			/// supplied until the next line that differs, if any; the scan target should leave whatever it is
+			/// currently displaying in place.
+			RepeatPreviousFrame,
 		};
 
 		/*!
@@ -369,7 +382,8 @@ struct ScanTarget {
 			* any announce acts as an implicit fence on data/scans, much as a submit().
 
 			Permitted ScanTarget implementation:
-			* ignore all output during retrace periods.
+			* ignore all output during retrace periods;
+			* ignore RepeatPreviousFrame, given that its only effect is an absence of output.
 
 			@param event The event.
 			@param is_visible @c true if the output stream is visible immediately after this event; @c false otherwise.
@@ -8,6 +8,7 @@
 
 #include "BufferingScanTarget.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -19,8 +20,9 @@
 using namespace Outputs::Display;
 
 BufferingScanTarget::BufferingScanTarget() {
-	// Ensure proper initialisation of the two atomic pointer sets.
+	// Ensure proper initialisation of the three atomic pointer sets.
 	read_pointers_.store(write_pointers_, std::memory_order::memory_order_relaxed);
+	read_ahead_pointers_.store(write_pointers_, std::memory_order::memory_order_relaxed);
 	submit_pointers_.store(write_pointers_, std::memory_order::memory_order_relaxed);
 
 	// Establish initial state for is_updating_.
@@ -195,6 +197,14 @@ void BufferingScanTarget::announce(Event event, bool is_visible, const Outputs::
 		frame_is_complete_ = true;
 	}
 
+	if(event == ScanTarget::Event::RepeatPreviousFrame) {
+		// Nothing will be output for at least the start of this frame. Whatever does arrive, if
+		// anything, still needs to be marked as first in frame so that the consumer resets its
+		// stencil, but shouldn't prompt a clearing of those portions of the display that
+		// are being left in place; so mark the previous frame as incomplete.
+		previous_frame_was_complete_ = false;
+	}
+
 	// Proceed from here only if a change in visibility has occurred.
 	if(output_is_visible_ == is_visible) return;
 	output_is_visible_ = is_visible;
@@ -279,7 +289,13 @@ const Outputs::Display::Metrics &BufferingScanTarget::display_metrics() {
 void BufferingScanTarget::set_write_area(uint8_t *base) {
 	std::lock_guard lock_guard(producer_mutex_);
 	write_area_ = base;
-	write_pointers_ = submit_pointers_ = read_pointers_ = PointerSet();
+	{
+		// Anything that was outstanding or pending completion has just been released; the completion
+		// mutex is held so that no completion can observe the pointers mid-reset.
+		std::lock_guard completion_lock(completion_mutex_);
+		write_pointers_ = submit_pointers_ = read_pointers_ = read_ahead_pointers_ = PointerSet();
+		pending_completions_.clear();
+	}
 	allocation_has_failed_ = true;
 	vended_scan_ = nullptr;
 }
@@ -331,20 +347,92 @@ BufferingScanTarget::OutputArea BufferingScanTarget::get_output_area() {
 	return area;
 }
 
+size_t BufferingScanTarget::split_output_area(const OutputArea &area, OutputArea *parts, size_t max_parts) const {
+	assert(max_parts);
+
+	// Divide the lines as evenly as possible, with at least one line per part unless the area is empty.
+	const size_t lines = (area.end.line + line_buffer_size_ - area.start.line) % line_buffer_size_;
+	const size_t count = std::max(size_t(1), std::min(max_parts, lines));
+
+	for(size_t c = 0; c < count; c++) {
+		OutputArea &part = parts[c];
+		part = area;
+
+		if(c) {
+			part.start.line = parts[c - 1].end.line;
+			part.start.scan = parts[c - 1].end.scan;
+		}
+
+		// All parts but the last end where the next begins, which is the first scan of its first line.
+		// The last retains the original end, including all of the write area, so that the write area
+		// is released only once every scan that might refer to it has been drawn.
+		if(c != count - 1) {
+			part.end.line = (area.start.line + ((c + 1) * lines) / count) % line_buffer_size_;
+			part.end.scan = line_metadata_buffer_[part.end.line].first_scan;
+			part.end.write_area_x = area.start.write_area_x;
+			part.end.write_area_y = area.start.write_area_y;
+		}
+	}
+
+	return count;
+}
+
 void BufferingScanTarget::complete_output_area(const OutputArea &area) {
-	// TODO: check that this is the expected next area if in DEBUG mode.
+	const auto pointers = [](const OutputArea::Endpoint &endpoint) {
+		PointerSet pointers;
+		pointers.line = uint16_t(endpoint.line);
+		pointers.scan = uint16_t(endpoint.scan);
+		pointers.write_area = TextureAddress(endpoint.write_area_x, endpoint.write_area_y);
+		return pointers;
+	};
+	PendingCompletion completion{pointers(area.start), pointers(area.end)};
+
+	// Completing an empty area has no effect.
+	if(completion.start == completion.end) return;
+
+	std::lock_guard lock_guard(completion_mutex_);
+
+	// Ignore any area that doesn't begin within the outstanding range, e.g. because it was vended
+	// before the most recent set_write_area; it could never be released. Every non-empty area covers
+	// at least one line, so position within the outstanding range can be judged by line alone.
+	auto read_pointers = read_pointers_.load(std::memory_order::memory_order_relaxed);
+	const auto read_ahead_pointers = read_ahead_pointers_.load(std::memory_order::memory_order_relaxed);
+	const auto offset = [&](const PointerSet &pointers) {
+		return (size_t(pointers.line) + line_buffer_size_ - read_pointers.line) % line_buffer_size_;
+	};
+	const auto is_outstanding = [&](const PointerSet &start) {
+		const size_t start_offset = offset(start);
+		return start_offset < offset(read_ahead_pointers) && (start_offset || start == read_pointers);
+	};
+	if(!is_outstanding(completion.start)) return;
+
+	// Areas can be released only in the order they were provided; if this area doesn't begin where
+	// the read pointers are then something before it is still outstanding, so park it.
+	if(!(completion.start == read_pointers)) {
+		pending_completions_.push_back(completion);
+		return;
+	}
 
-	PointerSet new_read_pointers;
-	new_read_pointers.line = uint16_t(area.end.line);
-	new_read_pointers.scan = uint16_t(area.end.scan);
-	new_read_pointers.write_area = TextureAddress(area.end.write_area_x, area.end.write_area_y);
-	read_pointers_.store(new_read_pointers, std::memory_order::memory_order_relaxed);
+	// Otherwise release this area plus any parked areas that now follow on.
+	read_pointers = completion.end;
+	while(true) {
+		const auto next = std::find_if(pending_completions_.begin(), pending_completions_.end(), [&](const PendingCompletion &pending) {
+			return pending.start == read_pointers;
+		});
+		if(next == pending_completions_.end()) break;
 
-#ifndef NDEBUG
-	// This will fire if the caller is announcing completed output areas out of order.
-	assert(area.counter == output_area_next_returned_);
-	++output_area_next_returned_;
-#endif
+		read_pointers = next->end;
+		pending_completions_.erase(next);
+	}
+	read_pointers_.store(read_pointers, std::memory_order::memory_order_relaxed);
+
+	// Anything parked that the read pointers have now passed can't be released either.
+	pending_completions_.erase(
+		std::remove_if(pending_completions_.begin(), pending_completions_.end(), [&](const PendingCompletion &pending) {
+			return !is_outstanding(pending.start);
+		}),
+		pending_completions_.end()
+	);
 }
 
 void BufferingScanTarget::perform(const std::function<void(void)> &function) {
@@ -140,12 +140,25 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 		/// Does not require the caller to be within a @c perform block.
 		OutputArea get_output_area();
 
+		/// Splits @c area into at most @c max_parts areas, each covering a run of consecutive whole lines
+		/// plus the scans that fall upon them, so that they can be composed independently, e.g. by a pool
+		/// of worker threads. Parts are written to @c parts in display order; their number is returned.
+		///
+		/// Only the final part covers any of the write area. Callers that don't use shared memory for the
+		/// write area should therefore upload the whole of the original area's range before processing any part.
+		///
+		/// Each part should be completed in place of the original area, via @c complete_output_area.
+		///
+		/// Does not require the caller to be within a @c perform block.
+		size_t split_output_area(const OutputArea &area, OutputArea *parts, size_t max_parts) const;
+
 		/// Announces that the output area has now completed output, freeing up its memory for
 		/// further modification.
 		///
 		/// It is the caller's responsibility to ensure that the areas passed to complete_output_area
-		/// are those from get_output_area and are marked as completed in the same order that
-		/// they were originally provided.
+		/// are those from get_output_area or split_output_area. They may be completed in any order
+		/// and from any thread; the memory of each is freed only once all of the areas that preceded
+		/// it have also been completed. Areas obtained before the most recent call to @c set_write_area are ignored.
 		///
 		/// Does not require the caller to be within a @c perform block.
 		void complete_output_area(const OutputArea &);
@@ -215,6 +228,10 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 
 			// Points into the line buffer.
 			uint16_t line = 0;
+
+			bool operator ==(const PointerSet &rhs) const {
+				return write_area == rhs.write_area && scan == rhs.scan && line == rhs.line;
+			}
 		};
 
 		/// A pointer to the final thing currently cleared for submission.
@@ -225,8 +242,19 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 		/// may run and is therefore used by both producer and consumer.
 		std::atomic<PointerSet> read_pointers_;
 
+		/// A pointer to the first thing not yet returned by get_output_area; everything between this and
+		/// the read pointers has been vended to the consumer but not yet completed.
 		std::atomic<PointerSet> read_ahead_pointers_;
 
+		/// Output areas that have been completed but which can't yet be released, because areas that
+		/// precede them are still outstanding. Both these and advancement of the read pointers upon
+		/// completion are guarded by the completion mutex, since completion may occur on any thread.
+		struct PendingCompletion {
+			PointerSet start, end;
+		};
+		std::vector<PendingCompletion> pending_completions_;
+		std::mutex completion_mutex_;
+
 		/// This is used as a spinlock to guard `perform` calls.
 		std::atomic_flag is_updating_;
 
@@ -259,7 +287,6 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 		// Debug features; these amount to API validation.
 		bool scan_is_ongoing_ = false;
 		size_t output_area_counter_ = 0;
-		size_t output_area_next_returned_ = 0;
 #endif
 };
 
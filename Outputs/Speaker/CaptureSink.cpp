@@ -0,0 +1,143 @@
+//
+//  CaptureSink.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#include "CaptureSink.hpp"
+
+#include "../../Storage/FileHolder.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace Outputs::Speaker;
+
+namespace {
+
+constexpr long WAVHeaderSize = 44;
+
+}
+
+CaptureSink::CaptureSink(const std::string &file_name, Format format, int sample_rate, bool stereo, bool wait_for_writer) :
+	file_(std::make_unique<Storage::FileHolder>(file_name, Storage::FileHolder::FileMode::Rewrite)),
+	format_(format),
+	sample_rate_(sample_rate),
+	stereo_(stereo),
+	wait_for_writer_(wait_for_writer) {
+	// Leave space for the header; it'll be written properly once the data size is known.
+	if(format_ == Format::WAV) {
+		file_->putn(WAVHeaderSize, 0);
+	}
+
+	// All buffers start in the free list; this precedes the writer thread, which otherwise
+	// is the only thing to post to it.
+	for(auto &buffer: pool_) {
+		auto pointer = &buffer;
+		free_buffers_.write(&pointer, 1);
+	}
+
+	writer_ = std::thread([this] {
+		run_writer();
+	});
+}
+
+CaptureSink::~CaptureSink() {
+	is_finishing_.store(true, std::memory_order::memory_order_release);
+	writer_condition_.notify_one();
+	writer_.join();
+}
+
+void CaptureSink::speaker_did_complete_samples(Speaker *speaker, const std::vector<int16_t> &buffer) {
+	std::vector<int16_t> *target;
+	while(!free_buffers_.read(&target, 1)) {
+		if(!wait_for_writer_) {
+			target = nullptr;
+			dropped_packets_.fetch_add(1, std::memory_order::memory_order_relaxed);
+			break;
+		}
+
+		writer_condition_.notify_one();
+		std::this_thread::yield();
+	}
+
+	if(target) {
+		// Buffers retain their capacity between uses, so this allocates only until
+		// each has seen a packet of the usual size.
+		target->assign(buffer.begin(), buffer.end());
+		full_buffers_.write(&target, 1);
+
+		// The writer wakes up periodically anyway; hurry it along if a backlog is building.
+		if(full_buffers_.size() >= PoolSize / 4) {
+			writer_condition_.notify_one();
+		}
+	}
+
+	const auto next_delegate = next_delegate_.load(std::memory_order::memory_order_relaxed);
+	if(next_delegate) {
+		next_delegate->speaker_did_complete_samples(speaker, buffer);
+	}
+}
+
+void CaptureSink::speaker_did_change_input_clock(Speaker *speaker) {
+	const auto next_delegate = next_delegate_.load(std::memory_order::memory_order_relaxed);
+	if(next_delegate) {
+		next_delegate->speaker_did_change_input_clock(speaker);
+	}
+}
+
+void CaptureSink::run_writer() {
+	std::vector<uint8_t> bytes;
+	uint64_t data_size = 0;
+
+	while(true) {
+		// Sample is_finishing_ before draining, so that everything posted before it
+		// was set is definitely written.
+		const bool is_finishing = is_finishing_.load(std::memory_order::memory_order_acquire);
+
+		std::vector<int16_t> *buffer;
+		while(full_buffers_.read(&buffer, 1)) {
+			bytes.resize(buffer->size() * 2);
+			for(std::size_t c = 0; c < buffer->size(); c++) {
+				const auto sample = uint16_t((*buffer)[c]);
+				bytes[(c << 1) + 0] = uint8_t(sample);
+				bytes[(c << 1) + 1] = uint8_t(sample >> 8);
+			}
+			free_buffers_.write(&buffer, 1);
+
+			file_->write(bytes.data(), bytes.size());
+			data_size += bytes.size();
+		}
+
+		if(is_finishing) break;
+
+		std::unique_lock lock(writer_mutex_);
+		writer_condition_.wait_for(lock, std::chrono::milliseconds(20), [this] {
+			return full_buffers_.size() || is_finishing_.load(std::memory_order::memory_order_relaxed);
+		});
+	}
+
+	if(format_ == Format::WAV) {
+		// RIFF sizes are 32-bit; anything longer than that will be unreadable by a strict
+		// parser but the data is intact, so just clamp.
+		const auto riff_data_size = uint32_t(std::min(data_size, uint64_t(0xffff'ffff) - uint64_t(WAVHeaderSize - 8)));
+		const uint16_t channels = stereo_ ? 2 : 1;
+
+		file_->seek(0, SEEK_SET);
+		file_->write(reinterpret_cast<const uint8_t *>("RIFF"), 4);
+		file_->put_le<uint32_t>(riff_data_size + uint32_t(WAVHeaderSize - 8));
+		file_->write(reinterpret_cast<const uint8_t *>("WAVEfmt "), 8);
+		file_->put_le<uint32_t>(16);								// Size of the fmt chunk.
+		file_->put_le<uint16_t>(1);									// PCM.
+		file_->put_le<uint16_t>(channels);
+		file_->put_le<uint32_t>(uint32_t(sample_rate_));
+		file_->put_le<uint32_t>(uint32_t(sample_rate_) * channels * 2);	// Bytes per second.
+		file_->put_le<uint16_t>(channels * 2);						// Bytes per sample frame.
+		file_->put_le<uint16_t>(16);								// Bits per sample.
+		file_->write(reinterpret_cast<const uint8_t *>("data"), 4);
+		file_->put_le<uint32_t>(riff_data_size);
+	}
+	file_->flush();
+}
@@ -0,0 +1,112 @@
+//
+//  CaptureSink.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef CaptureSink_hpp
+#define CaptureSink_hpp
+
+#include "Speaker.hpp"
+#include "../../Concurrency/RingBuffer.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Storage {
+class FileHolder;
+}
+
+namespace Outputs {
+namespace Speaker {
+
+/*!
+	A capture sink records the audio packets produced by a @c Speaker to a file, as either a
+	WAV or as raw 16-bit little-endian PCM.
+
+	It acts as a speaker delegate, and may forward every packet on to a further delegate so that it
+	can sit between a speaker and whatever would otherwise have been receiving its output. Packets are
+	copied into a fixed pool of buffers and handed to a background thread for writing via a lock-free
+	queue, so the thread that runs the speaker never waits for file I/O.
+
+	If the writer falls behind then packets are either dropped or, if @c wait_for_writer was specified,
+	the speaker's thread will wait for a buffer to become available. The latter is appropriate only
+	when audio isn't also being played live, e.g. for a machine being run headlessly.
+
+	Because packets are delivered at the speaker's output rate, the owner should ensure that rate has been
+	set, either directly or via the delegate that this sink forwards to.
+*/
+class CaptureSink: public Speaker::Delegate {
+	public:
+		enum class Format {
+			WAV,
+			Raw
+		};
+
+		/*!
+			Opens @c file_name for writing and starts the writer thread.
+
+			@param sample_rate The output rate of the speaker; this is recorded in the WAV header.
+			@param stereo @c true if the speaker's output is stereo; @c false otherwise.
+			@param wait_for_writer @c true if packets should be delayed rather than dropped when the writer is behind.
+			@raises Storage::FileHolder::Error::CantOpen if the file cannot be opened.
+		*/
+		CaptureSink(const std::string &file_name, Format format, int sample_rate, bool stereo, bool wait_for_writer = false);
+
+		/// Writes all pending packets, finalises the file and stops the writer thread.
+		~CaptureSink();
+
+		/// Sets a delegate that should receive every packet after it has been captured.
+		void set_next_delegate(Speaker::Delegate *delegate) {
+			next_delegate_.store(delegate, std::memory_order::memory_order_relaxed);
+		}
+
+		/// @returns The number of packets that have been dropped because the writer fell behind.
+		std::size_t dropped_packets() const {
+			return dropped_packets_.load(std::memory_order::memory_order_relaxed);
+		}
+
+		void speaker_did_complete_samples(Speaker *speaker, const std::vector<int16_t> &buffer) final;
+		void speaker_did_change_input_clock(Speaker *speaker) final;
+
+	private:
+		void run_writer();
+
+		// Buffers circulate from free_buffers_ to the speaker's thread, which fills them and posts
+		// them to full_buffers_; the writer thread writes them and returns them to free_buffers_.
+		// So each ring has exactly one producer and one consumer.
+		static constexpr std::size_t PoolSize = 64;
+		std::array<std::vector<int16_t>, PoolSize> pool_;
+		Concurrency::RingBuffer<std::vector<int16_t> *> free_buffers_{PoolSize};
+		Concurrency::RingBuffer<std::vector<int16_t> *> full_buffers_{PoolSize};
+
+		std::unique_ptr<Storage::FileHolder> file_;
+		const Format format_;
+		const int sample_rate_;
+		const bool stereo_;
+		const bool wait_for_writer_;
+
+		std::atomic<Speaker::Delegate *> next_delegate_{nullptr};
+		std::atomic<std::size_t> dropped_packets_{0};
+
+		// The writer sleeps on this between batches; the speaker's thread signals it without taking
+		// the mutex, so a wake-up may occasionally be missed but the writer also wakes periodically.
+		std::mutex writer_mutex_;
+		std::condition_variable writer_condition_;
+		std::atomic<bool> is_finishing_{false};
+		std::thread writer_;
+};
+
+}
+}
+
+#endif /* CaptureSink_hpp */
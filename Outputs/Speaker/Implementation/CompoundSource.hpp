@@ -37,10 +37,23 @@ template <typename... T> class CompoundSource:
 			source_holder_.template get_samples<get_is_stereo()>(number_of_samples, target);
 		}
 
+		void get_steps(std::size_t number_of_samples, StepTarget &target) {
+			source_holder_.get_steps(number_of_samples, target);
+		}
+
 		void skip_samples(const std::size_t number_of_samples) {
 			source_holder_.skip_samples(number_of_samples);
 		}
 
+		bool is_constant_level(std::size_t number_of_samples, std::int16_t *level) const {
+			std::int16_t levels[2];
+			if(!source_holder_.is_constant_level(number_of_samples, levels)) return false;
+
+			level[0] = levels[0];
+			if constexpr (get_is_stereo()) level[1] = levels[1];
+			return true;
+		}
+
 		/*!
 			Sets the total output volume of this CompoundSource.
 		*/
@@ -66,6 +79,11 @@ template <typename... T> class CompoundSource:
 		*/
 		static constexpr bool get_is_stereo() { return CompoundSourceHolder<T...>::get_is_stereo(); }
 
+		/*!
+			@returns true if all of the sources owned by this CompoundSource supply steps.
+		*/
+		static constexpr bool get_supplies_steps() { return CompoundSourceHolder<T...>::get_supplies_steps(); }
+
 		/*!
 			@returns the average output peak given the sources owned by this CompoundSource and the
 				current relative volumes.
@@ -86,6 +104,13 @@ template <typename... T> class CompoundSource:
 					std::memset(target, 0, sizeof(std::int16_t) * number_of_samples);
 				}
 
+				void get_steps(std::size_t, StepTarget &) {}
+
+				bool is_constant_level(std::size_t, std::int16_t *level) const {
+					level[0] = level[1] = 0;
+					return true;
+				}
+
 				void set_scaled_volume_range(int16_t, double *, double) {}
 
 				static constexpr std::size_t size() {
@@ -96,6 +121,10 @@ template <typename... T> class CompoundSource:
 					return false;
 				}
 
+				static constexpr bool get_supplies_steps() {
+					return true;
+				}
+
 				double total_scale(double *) const {
 					return 0.0;
 				}
@@ -116,6 +145,28 @@ template <typename... T> class CompoundSource:
 						return;
 					}
 
+					std::int16_t level[2];
+					if(source_constant_level(number_of_samples, level)) {
+						// This component is outputting a constant level, so just add that rather than
+						// generating samples.
+						source_.skip_samples(number_of_samples);
+						if constexpr (output_stereo) {
+							if(level[0] || level[1]) {
+								for(std::size_t c = 0; c < number_of_samples; c++) {
+									target[c*2] += level[0];
+									target[c*2 + 1] += level[1];
+								}
+							}
+						} else {
+							if(level[0]) {
+								for(std::size_t c = 0; c < number_of_samples; c++) {
+									target[c] += level[0];
+								}
+							}
+						}
+						return;
+					}
+
 					// Get this component's output.
 					auto buffer_size = number_of_samples * (output_stereo ? 2 : 1);
 					int16_t local_samples[buffer_size];
@@ -140,11 +191,38 @@ template <typename... T> class CompoundSource:
 					// TODO: accelerate above?
 				}
 
+				void get_steps(std::size_t number_of_samples, StepTarget &target) {
+					next_source_.get_steps(number_of_samples, target);
+
+					if(source_.is_zero_level()) {
+						// As per get_samples, skip this component; it need post only any change in
+						// level that led to its silence, which a zero-length period will capture.
+						source_.get_steps(0, target);
+						source_.skip_samples(number_of_samples);
+						return;
+					}
+
+					// Steps from all sources simply accumulate; a mono source's steps are
+					// posted to both channels if output is stereo.
+					source_.get_steps(number_of_samples, target);
+				}
+
 				void skip_samples(const std::size_t number_of_samples) {
 					source_.skip_samples(number_of_samples);
 					next_source_.skip_samples(number_of_samples);
 				}
 
+				/// Provides the sum of all constant levels, as a left and right pair, if every source is constant.
+				bool is_constant_level(std::size_t number_of_samples, std::int16_t *level) const {
+					std::int16_t next_level[2];
+					if(!source_constant_level(number_of_samples, level)) return false;
+					if(!next_source_.is_constant_level(number_of_samples, next_level)) return false;
+
+					level[0] = std::int16_t(level[0] + next_level[0]);
+					level[1] = std::int16_t(level[1] + next_level[1]);
+					return true;
+				}
+
 				void set_scaled_volume_range(int16_t range, double *volumes, double scale) {
 					const auto scaled_range = volumes[0] / double(source_.get_average_output_peak()) * double(range) / scale;
 					source_.set_sample_volume_range(int16_t(scaled_range));
@@ -159,11 +237,30 @@ template <typename... T> class CompoundSource:
 					return S::get_is_stereo() || CompoundSourceHolder<R...>::get_is_stereo();
 				}
 
+				static constexpr bool get_supplies_steps() {
+					return S::get_supplies_steps() && CompoundSourceHolder<R...>::get_supplies_steps();
+				}
+
 				double total_scale(double *volumes) const {
 					return (volumes[0] / source_.get_average_output_peak()) + next_source_.total_scale(&volumes[1]);
 				}
 
 			private:
+				/// Provides this source's constant level, if any, as a left and right pair.
+				bool source_constant_level(std::size_t number_of_samples, std::int16_t *level) const {
+					if(source_.is_zero_level()) {
+						level[0] = level[1] = 0;
+						return true;
+					}
+					if(!source_.is_constant_level(number_of_samples, level)) {
+						return false;
+					}
+					if constexpr (!S::get_is_stereo()) {
+						level[1] = level[0];
+					}
+					return true;
+				}
+
 				S &source_;
 				CompoundSourceHolder<R...> next_source_;
 		};
@@ -10,10 +10,14 @@
 #define FilteringSpeaker_h
 
 #include "../Speaker.hpp"
-#include "../../../SignalProcessing/FIRFilter.hpp"
+#include "RegisterLog.hpp"
+#include "SampleSource.hpp"
+#include "../../../SignalProcessing/PolyphaseFilter.hpp"
+#include "../../../SignalProcessing/StepSynthesiser.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 #include "../../../Concurrency/AsyncTaskQueue.hpp"
 
+#include <algorithm>
 #include <mutex>
 #include <cstring>
 #include <cmath>
@@ -24,14 +28,22 @@ namespace Speaker {
 /*!
 	The low-pass speaker expects an Outputs::Speaker::SampleSource-derived
 	template class, and uses the instance supplied to its constructor as the
-	source of a high-frequency stream of audio which it filters down to a
-	lower-frequency output.
+	source of a stream of audio which it resamples, via a low-pass polyphase
+	filter, to the output rate.
+
+	If the sample source supplies steps then, rather than filtering, the speaker will
+	synthesise its output directly from those.
 */
 template <typename SampleSource> class LowpassSpeaker: public Speaker {
 	public:
 		LowpassSpeaker(SampleSource &sample_source) : sample_source_(sample_source) {
 			// Propagate an initial volume level.
 			sample_source.set_sample_volume_range(32767);
+
+			step_target_.channels[0] = &synthesisers_[0];
+			if constexpr (SampleSource::get_is_stereo()) {
+				step_target_.channels[1] = &synthesisers_[1];
+			}
 		}
 
 		void set_output_volume(float volume) final {
@@ -118,6 +130,17 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 			});
 		}
 
+		/*!
+			Nominates @c log as the means by which this speaker will be advanced: time should be
+			posted to the log rather than to this speaker, and the log will advance the speaker
+			on its queue as it replays.
+		*/
+		void set_register_log(RegisterLog &log) {
+			log.set_speaker(this, [](void *speaker, Cycles cycles) {
+				static_cast<LowpassSpeaker *>(speaker)->run_for(cycles);
+			});
+		}
+
 	private:
 		enum class Conversion {
 			ResampleSmaller,
@@ -154,7 +177,8 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 				case Conversion::Copy:
 					while(cycles_remaining) {
 						const auto cycles_to_read = std::min((output_buffer_.size() - output_buffer_pointer_) / (SampleSource::get_is_stereo() ? 2 : 1), cycles_remaining);
-						sample_source_.get_samples(cycles_to_read, &output_buffer_[output_buffer_pointer_ ]);
+						int16_t level[2]{};
+						read_source(cycles_to_read, &output_buffer_[output_buffer_pointer_], level);
 						output_buffer_pointer_ += cycles_to_read * (SampleSource::get_is_stereo() ? 2 : 1);
 
 						// TODO: apply scale.
@@ -170,23 +194,57 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 				break;
 
 				case Conversion::ResampleSmaller:
+				case Conversion::ResampleLarger:
+					if constexpr (SampleSource::get_supplies_steps()) {
+						while(cycles_remaining) {
+							const auto cycles_to_read = std::min(MaximumStepPeriod, cycles_remaining);
+
+							sample_source_.get_steps(cycles_to_read, step_target_);
+							const auto complete = synthesisers_[0].end_period(cycles_to_read);
+							if constexpr (SampleSource::get_is_stereo()) {
+								synthesisers_[1].end_period(cycles_to_read);
+							}
+							output_synthesised_samples(complete, scale);
+
+							cycles_remaining -= cycles_to_read;
+						}
+						break;
+					}
+
 					while(cycles_remaining) {
-						const auto cycles_to_read = std::min((input_buffer_.size() - input_buffer_depth_) / (SampleSource::get_is_stereo() ? 2 : 1), cycles_remaining);
+						// Skip anything that won't contribute to output.
+						if(input_samples_to_skip_) {
+							const auto cycles_to_skip = std::min(input_samples_to_skip_, cycles_remaining);
+							sample_source_.skip_samples(cycles_to_skip);
+							input_samples_to_skip_ -= cycles_to_skip;
+							cycles_remaining -= cycles_to_skip;
+							continue;
+						}
 
-						sample_source_.get_samples(cycles_to_read, &input_buffer_[input_buffer_depth_]);
-						input_buffer_depth_ += cycles_to_read * (SampleSource::get_is_stereo() ? 2 : 1);
+						const auto cycles_to_read = std::min((input_buffer_.size() - input_buffer_depth_) / (SampleSource::get_is_stereo() ? 2 : 1), cycles_remaining);
 
-						if(input_buffer_depth_ == input_buffer_.size()) {
-							resample_input_buffer(scale);
+						// Track how much of the end of the input buffer is a single constant level; output
+						// that depends only upon that can be calculated without filtering.
+						int16_t level[2]{};
+						if(read_source(cycles_to_read, &input_buffer_[input_buffer_depth_], level)) {
+							const bool same_level =
+								level[0] == constant_input_level_[0] &&
+								(!SampleSource::get_is_stereo() || level[1] == constant_input_level_[1]);
+							if(!constant_input_samples_ || !same_level) {
+								constant_input_samples_ = 0;
+								constant_input_level_[0] = level[0];
+								constant_input_level_[1] = level[1];
+							}
+							constant_input_samples_ += cycles_to_read;
+						} else {
+							constant_input_samples_ = 0;
 						}
+						input_buffer_depth_ += cycles_to_read * (SampleSource::get_is_stereo() ? 2 : 1);
+						resample_input_buffer(scale);
 
 						cycles_remaining -= cycles_to_read;
 					}
 				break;
-
-				case Conversion::ResampleLarger:
-					// TODO: input rate is less than output rate.
-				break;
 			}
 		}
 
@@ -197,9 +255,31 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 		std::vector<int16_t> input_buffer_;
 		std::vector<int16_t> output_buffer_;
 
-		float step_rate_ = 0.0f;
-		float position_error_ = 0.0f;
-		std::unique_ptr<SignalProcessing::FIRFilter> filter_;
+		// The position of the next output sample within the input buffer, and the distance
+		// between output samples, both in input samples and in 32.32 fixed point.
+		uint64_t input_position_ = 0;
+		uint64_t input_step_ = 0;
+		std::size_t input_samples_to_skip_ = 0;
+
+		// The number of samples at the end of the input buffer that are known to be
+		// constant_input_level_, per channel.
+		std::size_t constant_input_samples_ = 0;
+		int16_t constant_input_level_[2]{};
+
+		std::unique_ptr<SignalProcessing::PolyphaseFilter> filter_;
+		float filter_input_cycles_per_second_ = 0.0f;
+		float filter_high_frequency_ = 0.0f;
+
+		// Upsampling filters are guaranteed at least this many taps; the input buffer always
+		// has space for at least MinimumInputBuffer samples, to amortise compaction.
+		static constexpr std::size_t MinimumTaps = 32;
+		static constexpr std::size_t MinimumInputBuffer = 4096;
+
+		// Used in place of the filter if the sample source supplies steps; the period is
+		// bounded only to keep the synthesisers' buffers small.
+		static constexpr std::size_t MaximumStepPeriod = 8192;
+		SignalProcessing::StepSynthesiser synthesisers_[2];
+		StepTarget step_target_;
 
 		std::mutex filter_parameters_mutex_;
 		struct FilterParameters {
@@ -212,110 +292,225 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 		} filter_parameters_;
 
 		void update_filter_coefficients(const FilterParameters &filter_parameters) {
+			// Pick the new conversion function.
+			if(	filter_parameters.input_cycles_per_second == filter_parameters.output_cycles_per_second &&
+				filter_parameters.high_frequency_cutoff < 0.0) {
+				// If input and output rates exactly match, and no additional cut-off has been specified,
+				// just accumulate results and pass on.
+				conversion_ = Conversion::Copy;
+			} else if(	filter_parameters.input_cycles_per_second > filter_parameters.output_cycles_per_second ||
+				(filter_parameters.input_cycles_per_second == filter_parameters.output_cycles_per_second && filter_parameters.high_frequency_cutoff >= 0.0)) {
+				// If the output rate is less than the input rate, or an additional cut-off has been specified, use the filter.
+				conversion_ = Conversion::ResampleSmaller;
+			} else {
+				conversion_ = Conversion::ResampleLarger;
+			}
+
 			float high_pass_frequency = filter_parameters.output_cycles_per_second / 2.0f;
 			if(filter_parameters.high_frequency_cutoff > 0.0) {
 				high_pass_frequency = std::min(filter_parameters.high_frequency_cutoff, high_pass_frequency);
 			}
 
+			// If upsampling, nothing above the input's Nyquist frequency should survive; leave
+			// a margin for the transition band.
+			if(conversion_ == Conversion::ResampleLarger) {
+				high_pass_frequency = std::min(high_pass_frequency, filter_parameters.input_cycles_per_second * 0.45f);
+			}
+
 			// Make a guess at a good number of taps.
 			std::size_t number_of_taps = std::size_t(
 				ceilf((filter_parameters.input_cycles_per_second + high_pass_frequency) / high_pass_frequency)
 			);
-			number_of_taps = (number_of_taps * 2) | 1;
+			number_of_taps = std::max((number_of_taps * 2) | 1, MinimumTaps);
 
-			step_rate_ = filter_parameters.input_cycles_per_second / filter_parameters.output_cycles_per_second;
-			position_error_ = 0.0f;
+			// Pick a number of phases sufficient that the timing error of picking the nearest
+			// is negligible at the cut-off frequency.
+			const std::size_t number_of_phases = std::clamp(
+				std::size_t(ceilf(1024.0f * high_pass_frequency / filter_parameters.input_cycles_per_second)),
+				std::size_t(1),
+				std::size_t(256));
 
-			filter_ = std::make_unique<SignalProcessing::FIRFilter>(
-				unsigned(number_of_taps),
-				filter_parameters.input_cycles_per_second,
-				0.0,
-				high_pass_frequency,
-				SignalProcessing::FIRFilter::DefaultAttenuation);
+			input_step_ = uint64_t(
+				double(filter_parameters.input_cycles_per_second) / double(filter_parameters.output_cycles_per_second) * 4294967296.0
+			);
 
+			// Small changes in output rate, such as those a host might make to compensate for drift
+			// between its audio and video clocks, are applied without rebuilding the filter.
+			const bool filter_is_current =
+				filter_input_cycles_per_second_ == filter_parameters.input_cycles_per_second &&
+				std::abs(filter_high_frequency_ - high_pass_frequency) <= high_pass_frequency * 0.01f;
+			if(!filter_is_current) {
+				filter_input_cycles_per_second_ = filter_parameters.input_cycles_per_second;
+				filter_high_frequency_ = high_pass_frequency;
+			}
 
-			// Pick the new conversion function.
-			if(	filter_parameters.input_cycles_per_second == filter_parameters.output_cycles_per_second &&
-				filter_parameters.high_frequency_cutoff < 0.0) {
-				// If input and output rates exactly match, and no additional cut-off has been specified,
-				// just accumulate results and pass on.
-				conversion_ = Conversion::Copy;
-			} else if(	filter_parameters.input_cycles_per_second > filter_parameters.output_cycles_per_second ||
-				(filter_parameters.input_cycles_per_second == filter_parameters.output_cycles_per_second && filter_parameters.high_frequency_cutoff >= 0.0)) {
-				// If the output rate is less than the input rate, or an additional cut-off has been specified, use the filter.
-				conversion_ = Conversion::ResampleSmaller;
-			} else {
-				conversion_ = Conversion::ResampleLarger;
+			if constexpr (SampleSource::get_supplies_steps()) {
+				for(auto &synthesiser: synthesisers_) {
+					if(filter_is_current) {
+						synthesiser.set_sample_rates(
+							filter_parameters.input_cycles_per_second,
+							filter_parameters.output_cycles_per_second);
+					} else {
+						synthesiser.set_parameters(
+							filter_parameters.input_cycles_per_second,
+							filter_parameters.output_cycles_per_second,
+							high_pass_frequency);
+					}
+				}
+			} else if(!filter_is_current) {
+				filter_ = std::make_unique<SignalProcessing::PolyphaseFilter>(
+					number_of_taps,
+					number_of_phases,
+					filter_parameters.input_cycles_per_second,
+					high_pass_frequency,
+					SignalProcessing::FIRFilter::DefaultAttenuation);
 			}
 
 			// Do something sensible with any dangling input, if necessary.
-			const int scale = get_scale();
 			switch(conversion_) {
-				// Neither direct copying nor resampling larger currently use any temporary input.
-				// Although in the latter case that's just because it's unimplemented. But, regardless,
-				// that means nothing to do.
+				// Direct copying doesn't use any temporary input.
 				default: break;
 
-				case Conversion::ResampleSmaller: {
-					// Reize the input buffer only if absolutely necessary; if sizing downward
-					// such that a sample would otherwise be lost then output it now. Keep anything
-					// currently in the input buffer that hasn't yet been processed.
-					const size_t required_buffer_size = size_t(number_of_taps) * (SampleSource::get_is_stereo() ? 2 : 1);
-					if(input_buffer_.size() != required_buffer_size) {
-						if(input_buffer_depth_ >= required_buffer_size) {
-							resample_input_buffer(scale);
-							input_buffer_depth_ %= required_buffer_size;
-						}
-						input_buffer_.resize(required_buffer_size);
+				case Conversion::ResampleSmaller:
+				case Conversion::ResampleLarger: {
+					// The step synthesisers retain any pending output themselves.
+					if constexpr (SampleSource::get_supplies_steps()) break;
+
+					// Keep the most recent input if the buffer is shrinking, adjusting the output position to match.
+					constexpr std::size_t channels = SampleSource::get_is_stereo() ? 2 : 1;
+					const std::size_t required_buffer_size = std::max(filter_->get_number_of_taps() * 4, MinimumInputBuffer) * channels;
+					if(input_buffer_depth_ > required_buffer_size) {
+						const std::size_t discard = (input_buffer_depth_ - required_buffer_size) / channels;
+						std::memmove(	input_buffer_.data(),
+										&input_buffer_[discard * channels],
+										sizeof(int16_t) * required_buffer_size);
+						input_buffer_depth_ = required_buffer_size;
+						constant_input_samples_ = std::min(constant_input_samples_, required_buffer_size / channels);
+						input_position_ = (uint64_t(discard) << 32) > input_position_ ? 0 : input_position_ - (uint64_t(discard) << 32);
 					}
+					input_buffer_.resize(required_buffer_size);
 				} break;
 			}
 		}
 
+		/*!
+			Produces as much output as the input buffer currently permits, then, if the input buffer
+			is full, discards whatever input will not contribute to future output.
+		*/
 		inline void resample_input_buffer(int scale) {
-			if constexpr (SampleSource::get_is_stereo()) {
-				output_buffer_[output_buffer_pointer_ + 0] = filter_->apply(input_buffer_.data(), 2);
-				output_buffer_[output_buffer_pointer_ + 1] = filter_->apply(input_buffer_.data() + 1, 2);
-				output_buffer_pointer_+= 2;
-			} else {
-				output_buffer_[output_buffer_pointer_] = filter_->apply(input_buffer_.data());
-				output_buffer_pointer_++;
+			constexpr std::size_t channels = SampleSource::get_is_stereo() ? 2 : 1;
+			const std::size_t number_of_taps = filter_->get_number_of_taps();
+			const uint64_t number_of_phases = filter_->get_number_of_phases();
+			const std::size_t available = input_buffer_depth_ / channels;
+			const std::size_t first_constant_sample = available - constant_input_samples_;
+
+			// Offset positions by half a phase so that truncation picks the nearest phase; a
+			// position that rounds up to the next whole sample is phase 0 of the next index.
+			const uint64_t phase_rounding = (uint64_t(1) << 31) / number_of_phases;
+
+			while(true) {
+				const uint64_t position = input_position_ + phase_rounding;
+				const std::size_t index = std::size_t(position >> 32);
+				if(index + number_of_taps > available) break;
+
+				const auto phase = std::size_t(((position & 0xffff'ffff) * number_of_phases) >> 32);
+				if(index >= first_constant_sample) {
+					output_buffer_[output_buffer_pointer_] = filter_->apply_constant(constant_input_level_[0], phase);
+					if constexpr (SampleSource::get_is_stereo()) {
+						output_buffer_[output_buffer_pointer_ + 1] = filter_->apply_constant(constant_input_level_[1], phase);
+					}
+				} else if constexpr (SampleSource::get_is_stereo()) {
+					filter_->apply_stereo(&input_buffer_[index * 2], phase, &output_buffer_[output_buffer_pointer_]);
+				} else {
+					output_buffer_[output_buffer_pointer_] = filter_->apply(&input_buffer_[index], phase);
+				}
+				input_position_ += input_step_;
+
+				// Apply scale, if supplied, clamping appropriately.
+				if(scale != 65536) {
+					for(std::size_t c = 0; c < channels; c++) {
+						int16_t &sample = output_buffer_[output_buffer_pointer_ + c];
+						sample = int16_t(std::max(std::min((int(sample) * scale) >> 16, 32767), -32768));
+					}
+				}
+				output_buffer_pointer_ += channels;
+
+				// Announce to delegate if full.
+				if(output_buffer_pointer_ == output_buffer_.size()) {
+					output_buffer_pointer_ = 0;
+					did_complete_samples(this, output_buffer_, SampleSource::get_is_stereo());
+				}
 			}
 
-			// Apply scale, if supplied, clamping appropriately.
-			if(scale != 65536) {
-				#define SCALE(x) x = int16_t(std::max(std::min((int(x) * scale) >> 16, 32767), -32768))
-				if constexpr (SampleSource::get_is_stereo()) {
-					SCALE(output_buffer_[output_buffer_pointer_ - 2]);
-					SCALE(output_buffer_[output_buffer_pointer_ - 1]);
+			// If the input buffer is full, shuffle down whatever is still needed, or mark for
+			// skipping anything that isn't yet in the buffer but won't be needed.
+			if(input_buffer_depth_ == input_buffer_.size()) {
+				const std::size_t index = std::size_t(input_position_ >> 32);
+				if(index < available) {
+					std::memmove(	input_buffer_.data(),
+									&input_buffer_[index * channels],
+									sizeof(int16_t) * (available - index) * channels);
+					input_buffer_depth_ -= index * channels;
+					constant_input_samples_ = std::min(constant_input_samples_, available - index);
 				} else {
-					SCALE(output_buffer_[output_buffer_pointer_ - 1]);
+					input_samples_to_skip_ = index - available;
+					input_buffer_depth_ = 0;
+					constant_input_samples_ = 0;
 				}
-				#undef SCALE
+				input_position_ -= uint64_t(index) << 32;
 			}
+		}
+
+		/*!
+			Writes the next @c count samples from the sample source to @c target. If the source is known to
+			be outputting a constant level then it is skipped and @c target filled with that level, which is
+			also stored to @c level.
 
-			// Announce to delegate if full.
-			if(output_buffer_pointer_ == output_buffer_.size()) {
-				output_buffer_pointer_ = 0;
-				did_complete_samples(this, output_buffer_, SampleSource::get_is_stereo());
+			@returns @c true if the source's output was constant; @c false otherwise.
+		*/
+		inline bool read_source(std::size_t count, int16_t *target, int16_t *level) {
+			if(!sample_source_.is_constant_level(count, level)) {
+				sample_source_.get_samples(count, target);
+				return false;
 			}
 
-			// If the next loop around is going to reuse some of the samples just collected, use a memmove to
-			// preserve them in the correct locations (TODO: use a longer buffer to fix that?) and don't skip
-			// anything. Otherwise skip as required to get to the next sample batch and don't expect to reuse.
-			const size_t steps = size_t(step_rate_ + position_error_) * (SampleSource::get_is_stereo() ? 2 : 1);
-			position_error_ = fmodf(step_rate_ + position_error_, 1.0f);
-			if(steps < input_buffer_.size()) {
-				auto *const input_buffer = input_buffer_.data();
-				std::memmove(	input_buffer,
-								&input_buffer[steps],
-								sizeof(int16_t) * (input_buffer_.size() - steps));
-				input_buffer_depth_ -= steps;
+			sample_source_.skip_samples(count);
+			if constexpr (SampleSource::get_is_stereo()) {
+				for(std::size_t c = 0; c < count; c++) {
+					target[c*2] = level[0];
+					target[c*2 + 1] = level[1];
+				}
 			} else {
-				if(steps > input_buffer_.size()) {
-					sample_source_.skip_samples((steps - input_buffer_.size()) / (SampleSource::get_is_stereo() ? 2 : 1));
+				std::fill(target, target + count, level[0]);
+			}
+			return true;
+		}
+
+		inline void output_synthesised_samples(std::size_t count, int scale) {
+			constexpr std::size_t channels = SampleSource::get_is_stereo() ? 2 : 1;
+			while(count) {
+				const auto samples_to_write = std::min(count, (output_buffer_.size() - output_buffer_pointer_) / channels);
+				int16_t *const target = &output_buffer_[output_buffer_pointer_];
+				synthesisers_[0].get_samples(samples_to_write, target, channels);
+				if constexpr (SampleSource::get_is_stereo()) {
+					synthesisers_[1].get_samples(samples_to_write, target + 1, channels);
 				}
-				input_buffer_depth_ = 0;
+				output_buffer_pointer_ += samples_to_write * channels;
+
+				// Apply scale, if supplied, clamping appropriately.
+				if(scale != 65536) {
+					for(std::size_t c = 0; c < samples_to_write * channels; c++) {
+						target[c] = int16_t(std::max(std::min((int(target[c]) * scale) >> 16, 32767), -32768));
+					}
+				}
+
+				// Announce to delegate if full.
+				if(output_buffer_pointer_ == output_buffer_.size()) {
+					output_buffer_pointer_ = 0;
+					did_complete_samples(this, output_buffer_, SampleSource::get_is_stereo());
+				}
+
+				count -= samples_to_write;
 			}
 		}
 
@@ -0,0 +1,204 @@
+//
+//  RegisterLog.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef RegisterLog_hpp
+#define RegisterLog_hpp
+
+#include "../../../ClockReceiver/ClockReceiver.hpp"
+#include "../../../Concurrency/AsyncTaskQueue.hpp"
+#include "../../../Concurrency/RingBuffer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace Outputs {
+namespace Speaker {
+
+/*!
+	A register log records time-stamped writes to sound chips, and replays them in batches on an
+	audio thread, advancing a speaker between writes.
+
+	It is an alternative to deferring a closure onto a @c DeferringAsyncTaskQueue for every write
+	and for every update of the speaker that precedes one: time is accumulated here as plain arithmetic,
+	and each write costs a single fixed-size entry in a lock-free ring.
+
+	Sound chips opt in by obtaining an @c Input via @c add_input, supplying a function that applies a
+	write on the audio thread; a speaker opts in via LowpassSpeaker::set_register_log. Thereafter the
+	owner should call @c run_for and @c perform on this log in place of running the speaker on its queue.
+
+	Replay is performed on the queue supplied at construction, so it remains serialised with anything
+	else deferred there; @c perform also performs that queue. Each replay covers exactly the writes logged
+	before it was scheduled, and @c perform schedules its replay before performing the queue, so anything
+	deferred there takes effect after all writes logged before that call to @c perform and before any
+	logged after it.
+
+	@c run_for, @c perform, @c flush and @c Input::post must all be called from the same thread. As with
+	a queue, the owner should @c flush before destroying anything that the log might replay into.
+*/
+class RegisterLog {
+	public:
+		/// A function that applies a logged write to @c target on the audio thread.
+		using Receiver = void (*)(void *target, uint16_t address, uint8_t value);
+
+		/// A function that advances @c speaker on the audio thread.
+		using Advancer = void (*)(void *speaker, Cycles cycles);
+
+		/*!
+			The means by which a sound chip posts writes to the log.
+		*/
+		class Input {
+			public:
+				Input() = default;
+
+				/// Logs a write of @c value to @c address, at the log's current time.
+				void post(uint16_t address, uint8_t value) const {
+					log_->post(index_, address, value);
+				}
+
+				/// @returns @c true if this input is attached to a log; @c false otherwise.
+				explicit operator bool() const {
+					return log_;
+				}
+
+			private:
+				friend RegisterLog;
+				Input(RegisterLog *log, uint8_t index) : log_(log), index_(index) {}
+
+				RegisterLog *log_ = nullptr;
+				uint8_t index_ = 0;
+		};
+
+		/*!
+			Constructs a log that will replay on @c queue, able to hold @c capacity writes between
+			replays before the calling thread has to wait for the audio thread to catch up.
+		*/
+		RegisterLog(Concurrency::DeferringAsyncTaskQueue &queue, std::size_t capacity = 16384) :
+			queue_(queue), events_(capacity) {}
+
+		/// Sets the speaker that is advanced as time passes; this is an implementation detail of LowpassSpeaker::set_register_log.
+		void set_speaker(void *speaker, Advancer advancer) {
+			speaker_ = speaker;
+			advancer_ = advancer;
+		}
+
+		/// Adds a receiver of writes; this should be called only during setup, before any writes are posted.
+		Input add_input(void *target, Receiver receiver) {
+			receivers_.push_back({target, receiver});
+			return Input(this, uint8_t(receivers_.size() - 1));
+		}
+
+		/// Advances the log's current time.
+		void run_for(const Cycles cycles) {
+			pending_cycles_ += cycles.as_integral();
+		}
+
+		/// Schedules replay of everything logged so far, including any time that has since passed.
+		void perform() {
+			if(pending_cycles_) {
+				post(NoReceiver, 0, 0);
+			}
+			schedule_replay();
+			queue_.perform();
+		}
+
+		/// Blocks until everything logged so far has been replayed.
+		void flush() {
+			perform();
+			queue_.flush();
+		}
+
+	private:
+		struct Event {
+			uint32_t cycles;
+			uint16_t address;
+			uint8_t value;
+			uint8_t receiver;
+		};
+		static constexpr uint8_t NoReceiver = 0xff;
+
+		void post(uint8_t receiver, uint16_t address, uint8_t value) {
+			// Split any period too long to fit an event.
+			constexpr auto MaxCycles = Cycles::IntType(std::numeric_limits<uint32_t>::max());
+			while(pending_cycles_ > MaxCycles) {
+				push({uint32_t(MaxCycles), 0, 0, NoReceiver});
+				pending_cycles_ -= MaxCycles;
+			}
+
+			push({uint32_t(pending_cycles_), address, value, receiver});
+			pending_cycles_ = 0;
+		}
+
+		void push(const Event &event) {
+			while(!events_.write(&event, 1)) {
+				// The audio thread is a whole ring behind; make sure it knows that
+				// there's work to do, and wait.
+				schedule_replay();
+				std::this_thread::yield();
+			}
+			++posted_;
+		}
+
+		void schedule_replay() {
+			// Replay only what has been posted so far; anything posted later belongs to a later replay,
+			// so that it remains ordered with respect to anything deferred in the meantime.
+			if(scheduled_ == posted_) return;
+			scheduled_ = posted_;
+			queue_.enqueue([this, limit = posted_] {
+				replay(limit);
+			});
+		}
+
+		// Performed on the audio thread.
+		void replay(uint64_t limit) {
+			Event events[256];
+			while(replayed_ < limit) {
+				const std::size_t count = events_.read(events, std::size_t(std::min(limit - replayed_, uint64_t(std::size(events)))));
+				replayed_ += count;
+
+				for(std::size_t c = 0; c < count; c++) {
+					const Event &event = events[c];
+					if(event.cycles && speaker_) {
+						advancer_(speaker_, Cycles(event.cycles));
+					}
+					if(event.receiver != NoReceiver) {
+						const auto &receiver = receivers_[event.receiver];
+						receiver.function(receiver.target, event.address, event.value);
+					}
+				}
+			}
+		}
+
+		Concurrency::DeferringAsyncTaskQueue &queue_;
+		Concurrency::RingBuffer<Event> events_;
+
+		// Accessed on the emulation thread only.
+		Cycles::IntType pending_cycles_ = 0;
+		uint64_t posted_ = 0;
+		uint64_t scheduled_ = 0;
+
+		// Accessed on the audio thread only.
+		uint64_t replayed_ = 0;
+
+		// Set during setup.
+		struct ReceiverTarget {
+			void *target;
+			Receiver function;
+		};
+		std::vector<ReceiverTarget> receivers_;
+		void *speaker_ = nullptr;
+		Advancer advancer_ = nullptr;
+};
+
+}
+}
+
+#endif /* RegisterLog_hpp */
@@ -12,9 +12,48 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "../../../SignalProcessing/StepSynthesiser.hpp"
+
 namespace Outputs {
 namespace Speaker {
 
+/*!
+	Receives the amplitude transitions posted by a sample source that supplies steps;
+	@c channels[1] is @c nullptr if output is mono.
+*/
+struct StepTarget {
+	SignalProcessing::StepSynthesiser *channels[2] = {nullptr, nullptr};
+
+	/// Posts a change of @c amount in level, @c offset samples into the current period, to all channels.
+	void add_step(std::size_t offset, int amount) {
+		channels[0]->add_step(offset, amount);
+		if(channels[1]) channels[1]->add_step(offset, amount);
+	}
+
+	/// Posts changes of @c left and @c right in level, @c offset samples into the current period; output must be stereo.
+	void add_step(std::size_t offset, int left, int right) {
+		if(left) channels[0]->add_step(offset, left);
+		if(right) channels[1]->add_step(offset, right);
+	}
+};
+
+/*!
+	A helper for sources that supply steps, allowing them to skip inaudible activity: advances by
+	@c ticks a divider that counts down to zero and then, on the following tick, reloads with @c reload.
+
+	@returns The number of reloads that occurred.
+*/
+template <typename IntT> int advance_divider(IntT &counter, int reload, int ticks) {
+	if(ticks <= int(counter)) {
+		counter = IntT(counter - ticks);
+		return 0;
+	}
+
+	ticks -= int(counter) + 1;
+	counter = IntT(reload - (ticks % (reload + 1)));
+	return 1 + ticks / (reload + 1);
+}
+
 /*!
 	A sample source is something that can provide a stream of audio.
 	This optional base class provides the interface expected to be exposed
@@ -27,6 +66,24 @@ class SampleSource {
 		*/
 		void get_samples([[maybe_unused]] std::size_t number_of_samples, [[maybe_unused]] std::int16_t *target) {}
 
+		/*!
+			Should post to @c target every change in output level that occurs over the next @c number_of_samples,
+			with the same net effect on this source's state as a call to @c get_samples. This is used in
+			preference to @c get_samples only if @c get_supplies_steps returns @c true.
+
+			A source should also post, at offset 0, any change in level since its previous call to @c get_steps,
+			such as one caused by a register write or by @c set_sample_volume_range. The level implied by the
+			first such call is relative to 0.
+		*/
+		void get_steps([[maybe_unused]] std::size_t number_of_samples, [[maybe_unused]] StepTarget &target) {}
+
+		/*!
+			Indicates whether this component implements @c get_steps. Sources that produce a small number of
+			discrete level changes relative to their sampling rate — square waves, mostly — should do so, as a
+			speaker can then synthesise output directly at its output rate.
+		*/
+		static constexpr bool get_supplies_steps() { return false; }
+
 		/*!
 			Should skip the next @c number_of_samples. Subclasses of this SampleSource
 			need not implement this if it would no more efficient to do so than it is
@@ -47,6 +104,16 @@ class SampleSource {
 			return false;
 		}
 
+		/*!
+			@returns @c true if it is trivially true that a call to get_samples for the next @c number_of_samples
+				would fill the target with a single repeated value, in which case that value is written to
+				@c level — as a left and right pair if this source is stereo. An owner may then add that
+				level itself and call @c skip_samples. @c false if output might vary.
+		*/
+		bool is_constant_level([[maybe_unused]] std::size_t number_of_samples, [[maybe_unused]] std::int16_t *level) const {
+			return false;
+		}
+
 		/*!
 			Sets the proper output range for this sample source; it should write values
 			between 0 and volume.
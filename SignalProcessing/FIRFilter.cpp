@@ -7,6 +7,8 @@
 //
 
 #include "FIRFilter.hpp"
+#include "KaiserBessel.hpp"
+
 #include <cmath>
 
 #ifndef M_PI
@@ -35,44 +37,20 @@ using namespace SignalProcessing;
 		"DIGITAL SIGNAL PROCESSING, II", IEEE Press, pages 123-126.
 */
 
-/*! Evaluates the 0th order Bessel function at @c a. */
-float FIRFilter::ino(float a) {
-	float d = 0.0f;
-	float ds = 1.0f;
-	float s = 1.0f;
-
-	do {
-		d += 2.0f;
-		ds *= (a * a) / (d * d);
-		s += ds;
-	} while(ds > s*1e-6f);
-
-	return s;
-}
-
 void FIRFilter::coefficients_for_idealised_filter_response(short *filter_coefficients, float *A, float attenuation, std::size_t number_of_taps) {
 	/* calculate alpha, which is the Kaiser-Bessel window shape factor */
-	float a;	// to take the place of alpha in the normal derivation
-
-	if(attenuation < 21.0f) {
-		a = 0.0f;
-	} else {
-		if(attenuation > 50.0f)
-			a = 0.1102f * (attenuation - 8.7f);
-		else
-			a = 0.5842f * powf(attenuation - 21.0f, 0.4f) + 0.7886f * (attenuation - 21.0f);
-	}
+	const float a = float(KaiserBessel::alpha(attenuation));	// to take the place of alpha in the normal derivation
 
 	std::vector<float> filter_coefficients_float(number_of_taps);
 
 	/* work out the right hand side of the filter coefficients */
 	std::size_t Np = (number_of_taps - 1) / 2;
-	float I0 = ino(a);
+	float I0 = float(KaiserBessel::ino(a));
 	float Np_squared = float(Np * Np);
 	for(unsigned int i = 0; i <= Np; ++i) {
 		filter_coefficients_float[Np + i] =
 				A[i] *
-				ino(a * sqrtf(1.0f - (float(i * i) / Np_squared) )) /
+				float(KaiserBessel::ino(a * sqrtf(1.0f - (float(i * i) / Np_squared) ))) /
 				I0;
 	}
 
@@ -133,12 +111,21 @@ FIRFilter::FIRFilter(std::size_t number_of_taps, float input_sample_rate, float
 	}
 
 	FIRFilter::coefficients_for_idealised_filter_response(filter_coefficients_.data(), A.data(), attenuation, number_of_taps);
+	set_coefficient_sum();
 }
 
 FIRFilter::FIRFilter(const std::vector<float> &coefficients) {
 	for(const auto coefficient: coefficients) {
 		filter_coefficients_.push_back(short(coefficient * FixedMultiplier));
 	}
+	set_coefficient_sum();
+}
+
+void FIRFilter::set_coefficient_sum() {
+	coefficient_sum_ = 0;
+	for(const auto coefficient: filter_coefficients_) {
+		coefficient_sum_ += coefficient;
+	}
 }
 
 FIRFilter FIRFilter::operator+(const FIRFilter &rhs) const {
@@ -174,3 +161,242 @@ FIRFilter FIRFilter::operator*(const FIRFilter &rhs) const {
 
 	return FIRFilter(sum);
 }
+
+// MARK: - Application.
+
+#ifndef USE_ACCELERATE
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define FIR_USE_X86_SIMD
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FIR_USE_NEON
+#endif
+
+namespace {
+
+/*!
+	Each of the following computes the sum of products of the first @c length entries in @c coefficients with
+	the first @c length entries of @c src. The stereo versions do so for each of two interleaved channels, storing
+	the left result to @c results[0] and the right to @c results[1].
+
+	All are bit-for-bit equivalent, accumulating in 32 bits.
+*/
+
+int dot_product_scalar(const short *coefficients, const short *src, std::size_t length, std::size_t c = 0) {
+	int result = 0;
+	for(; c < length; ++c) {
+		result += coefficients[c] * src[c];
+	}
+	return result;
+}
+
+void dot_product_stereo_scalar(const short *coefficients, const short *src, std::size_t length, int *results, std::size_t c = 0) {
+	for(; c < length; ++c) {
+		results[0] += coefficients[c] * src[c*2 + 0];
+		results[1] += coefficients[c] * src[c*2 + 1];
+	}
+}
+
+#ifdef FIR_USE_X86_SIMD
+
+/// Performs an unaligned load of eight samples from @c src.
+__attribute__((target("sse2"))) inline __m128i load_128(const short *src) {
+	return _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+}
+
+/// @returns The sum of all four 32-bit lanes of @c value.
+__attribute__((target("sse2"))) inline int horizontal_sum(__m128i value) {
+	value = _mm_add_epi32(value, _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2)));
+	value = _mm_add_epi32(value, _mm_shuffle_epi32(value, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(value);
+}
+
+/// Separates the left and right channels of eight stereo samples, from @c src, into @c left and @c right.
+__attribute__((target("sse2"))) inline void deinterleave_128(const short *src, __m128i &left, __m128i &right) {
+	// Sign extend each channel to 32 bits, then pack back together; no saturation will occur.
+	const __m128i first = load_128(src), second = load_128(src + 8);
+	left = _mm_packs_epi32(
+		_mm_srai_epi32(_mm_slli_epi32(first, 16), 16),
+		_mm_srai_epi32(_mm_slli_epi32(second, 16), 16)
+	);
+	right = _mm_packs_epi32(_mm_srai_epi32(first, 16), _mm_srai_epi32(second, 16));
+}
+
+__attribute__((target("sse2"))) int dot_product_sse2(const short *coefficients, const short *src, std::size_t length) {
+	__m128i sum = _mm_setzero_si128();
+	std::size_t c = 0;
+	for(; c + 8 <= length; c += 8) {
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(load_128(&coefficients[c]), load_128(&src[c])));
+	}
+	return horizontal_sum(sum) + dot_product_scalar(coefficients, src, length, c);
+}
+
+__attribute__((target("sse2"))) void dot_product_stereo_sse2(const short *coefficients, const short *src, std::size_t length, int *results) {
+	__m128i left_sum = _mm_setzero_si128(), right_sum = _mm_setzero_si128();
+	std::size_t c = 0;
+	for(; c + 8 <= length; c += 8) {
+		__m128i left, right;
+		deinterleave_128(&src[c*2], left, right);
+
+		const __m128i k = load_128(&coefficients[c]);
+		left_sum = _mm_add_epi32(left_sum, _mm_madd_epi16(k, left));
+		right_sum = _mm_add_epi32(right_sum, _mm_madd_epi16(k, right));
+	}
+	results[0] = horizontal_sum(left_sum);
+	results[1] = horizontal_sum(right_sum);
+	dot_product_stereo_scalar(coefficients, src, length, results, c);
+}
+
+/// Performs an unaligned load of sixteen samples from @c src.
+__attribute__((target("avx2"))) inline __m256i load_256(const short *src) {
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+}
+
+__attribute__((target("avx2"))) int dot_product_avx2(const short *coefficients, const short *src, std::size_t length) {
+	__m256i sum = _mm256_setzero_si256();
+	std::size_t c = 0;
+	for(; c + 16 <= length; c += 16) {
+		sum = _mm256_add_epi32(sum, _mm256_madd_epi16(load_256(&coefficients[c]), load_256(&src[c])));
+	}
+
+	// Calling into dot_product_sse2 for the remainder would incur a penalty for switching
+	// between AVX and legacy SSE encodings on some processors, so complete the job here.
+	__m128i sum_128 = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+	if(c + 8 <= length) {
+		sum_128 = _mm_add_epi32(sum_128, _mm_madd_epi16(load_128(&coefficients[c]), load_128(&src[c])));
+		c += 8;
+	}
+	return horizontal_sum(sum_128) + dot_product_scalar(coefficients, src, length, c);
+}
+
+__attribute__((target("avx2"))) void dot_product_stereo_avx2(const short *coefficients, const short *src, std::size_t length, int *results) {
+	__m256i left_sum = _mm256_setzero_si256(), right_sum = _mm256_setzero_si256();
+	std::size_t c = 0;
+	for(; c + 16 <= length; c += 16) {
+		// As per deinterleave_128, but packing operates within 128-bit lanes, leaving samples
+		// [0–3, 8–11 | 4–7, 12–15] of each channel. So rearrange the coefficients to match.
+		const __m256i first = load_256(&src[c*2]), second = load_256(&src[c*2 + 16]);
+		const __m256i left = _mm256_packs_epi32(
+			_mm256_srai_epi32(_mm256_slli_epi32(first, 16), 16),
+			_mm256_srai_epi32(_mm256_slli_epi32(second, 16), 16)
+		);
+		const __m256i right = _mm256_packs_epi32(_mm256_srai_epi32(first, 16), _mm256_srai_epi32(second, 16));
+
+		const __m256i k = _mm256_permute4x64_epi64(load_256(&coefficients[c]), _MM_SHUFFLE(3, 1, 2, 0));
+		left_sum = _mm256_add_epi32(left_sum, _mm256_madd_epi16(k, left));
+		right_sum = _mm256_add_epi32(right_sum, _mm256_madd_epi16(k, right));
+	}
+
+	// As per dot_product_avx2, complete the remainder here.
+	__m128i left_sum_128 = _mm_add_epi32(_mm256_castsi256_si128(left_sum), _mm256_extracti128_si256(left_sum, 1));
+	__m128i right_sum_128 = _mm_add_epi32(_mm256_castsi256_si128(right_sum), _mm256_extracti128_si256(right_sum, 1));
+	if(c + 8 <= length) {
+		__m128i left, right;
+		deinterleave_128(&src[c*2], left, right);
+
+		const __m128i k = load_128(&coefficients[c]);
+		left_sum_128 = _mm_add_epi32(left_sum_128, _mm_madd_epi16(k, left));
+		right_sum_128 = _mm_add_epi32(right_sum_128, _mm_madd_epi16(k, right));
+		c += 8;
+	}
+	results[0] = horizontal_sum(left_sum_128);
+	results[1] = horizontal_sum(right_sum_128);
+	dot_product_stereo_scalar(coefficients, src, length, results, c);
+}
+
+bool has_sse2() {
+	static const bool has_sse2 = __builtin_cpu_supports("sse2");
+	return has_sse2;
+}
+
+bool has_avx2() {
+	static const bool has_avx2 = __builtin_cpu_supports("avx2");
+	return has_avx2;
+}
+
+#endif
+
+#ifdef FIR_USE_NEON
+
+/// @returns The sum of all four 32-bit lanes of @c value.
+inline int horizontal_sum(int32x4_t value) {
+	const int32x2_t pair = vadd_s32(vget_low_s32(value), vget_high_s32(value));
+	return vget_lane_s32(vpadd_s32(pair, pair), 0);
+}
+
+/// Adds to @c sum the products of the eight 16-bit lanes of @c lhs and @c rhs.
+inline int32x4_t multiply_accumulate(int32x4_t sum, int16x8_t lhs, int16x8_t rhs) {
+	sum = vmlal_s16(sum, vget_low_s16(lhs), vget_low_s16(rhs));
+	return vmlal_s16(sum, vget_high_s16(lhs), vget_high_s16(rhs));
+}
+
+int dot_product_neon(const short *coefficients, const short *src, std::size_t length) {
+	int32x4_t sum = vdupq_n_s32(0);
+	std::size_t c = 0;
+	for(; c + 8 <= length; c += 8) {
+		sum = multiply_accumulate(sum, vld1q_s16(&coefficients[c]), vld1q_s16(&src[c]));
+	}
+	return horizontal_sum(sum) + dot_product_scalar(coefficients, src, length, c);
+}
+
+void dot_product_stereo_neon(const short *coefficients, const short *src, std::size_t length, int *results) {
+	int32x4_t left_sum = vdupq_n_s32(0), right_sum = vdupq_n_s32(0);
+	std::size_t c = 0;
+	for(; c + 8 <= length; c += 8) {
+		// vld2q deinterleaves as it loads.
+		const int16x8x2_t samples = vld2q_s16(&src[c*2]);
+		const int16x8_t k = vld1q_s16(&coefficients[c]);
+		left_sum = multiply_accumulate(left_sum, k, samples.val[0]);
+		right_sum = multiply_accumulate(right_sum, k, samples.val[1]);
+	}
+	results[0] = horizontal_sum(left_sum);
+	results[1] = horizontal_sum(right_sum);
+	dot_product_stereo_scalar(coefficients, src, length, results, c);
+}
+
+#endif
+
+int dot_product(const short *coefficients, const short *src, std::size_t length) {
+#if defined(FIR_USE_X86_SIMD)
+	if(has_avx2()) return dot_product_avx2(coefficients, src, length);
+	if(has_sse2()) return dot_product_sse2(coefficients, src, length);
+#elif defined(FIR_USE_NEON)
+	return dot_product_neon(coefficients, src, length);
+#endif
+	return dot_product_scalar(coefficients, src, length);
+}
+
+void dot_product_stereo(const short *coefficients, const short *src, std::size_t length, int *results) {
+#if defined(FIR_USE_X86_SIMD)
+	if(has_avx2()) {
+		dot_product_stereo_avx2(coefficients, src, length, results);
+		return;
+	}
+	if(has_sse2()) {
+		dot_product_stereo_sse2(coefficients, src, length, results);
+		return;
+	}
+#elif defined(FIR_USE_NEON)
+	dot_product_stereo_neon(coefficients, src, length, results);
+	return;
+#endif
+	results[0] = results[1] = 0;
+	dot_product_stereo_scalar(coefficients, src, length, results);
+}
+
+}
+
+short FIRFilter::apply_contiguous(const short *src) const {
+	return short(dot_product(filter_coefficients_.data(), src, filter_coefficients_.size()) >> FixedShift);
+}
+
+void FIRFilter::apply_stereo(const short *src, short *target) const {
+	int results[2];
+	dot_product_stereo(filter_coefficients_.data(), src, filter_coefficients_.size(), results);
+	target[0] = short(results[0] >> FixedShift);
+	target[1] = short(results[1] >> FixedShift);
+}
+
+#endif
@@ -17,6 +17,7 @@
 #define USE_ACCELERATE
 #endif
 
+#include <cstddef>
 #include <vector>
 
 namespace SignalProcessing {
@@ -59,6 +60,10 @@ class FIRFilter {
 				vDSP_dotpr_s1_15(filter_coefficients_.data(), 1, src, vDSP_Stride(stride), &result, filter_coefficients_.size());
 				return result;
 			#else
+				if(stride == 1) {
+					return apply_contiguous(src);
+				}
+
 				int outputValue = 0;
 				for(std::size_t c = 0; c < filter_coefficients_.size(); ++c) {
 					outputValue += filter_coefficients_[c] * src[c * stride];
@@ -67,6 +72,30 @@ class FIRFilter {
 			#endif
 		}
 
+		/*!
+			Applies the filter to one batch of interleaved stereo input samples, filtering
+			both channels in a single pass.
+
+			@param src The source buffer to apply the filter to, holding alternating left and right samples.
+			@param target The buffer to which the left and then the right result will be written.
+		*/
+#ifdef USE_ACCELERATE
+		inline void apply_stereo(const short *src, short *target) const {
+			target[0] = apply(src, 2);
+			target[1] = apply(src + 1, 2);
+		}
+#else
+		void apply_stereo(const short *src, short *target) const;
+#endif
+
+		/*!
+			Applies the filter to input that is @c level throughout, as an alternative to
+			filling a buffer and calling @c apply.
+		*/
+		inline short apply_constant(short level) const {
+			return short((coefficient_sum_ * level) >> FixedShift);
+		}
+
 		/*! @returns The number of taps used by this filter. */
 		inline std::size_t get_number_of_taps() const {
 			return filter_coefficients_.size();
@@ -94,9 +123,15 @@ class FIRFilter {
 
 	private:
 		std::vector<short> filter_coefficients_;
+		int coefficient_sum_ = 0;
+		void set_coefficient_sum();
+
+#ifndef USE_ACCELERATE
+		/// Applies the filter to contiguous input, using whichever vector unit is available.
+		short apply_contiguous(const short *src) const;
+#endif
 
 		static void coefficients_for_idealised_filter_response(short *filterCoefficients, float *A, float attenuation, std::size_t numberOfTaps);
-		static float ino(float a);
 };
 
 }
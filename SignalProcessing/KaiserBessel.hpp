@@ -0,0 +1,55 @@
+//
+//  KaiserBessel.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef KaiserBessel_hpp
+#define KaiserBessel_hpp
+
+#include <algorithm>
+#include <cmath>
+
+namespace SignalProcessing {
+namespace KaiserBessel {
+
+/*! Evaluates the 0th order Bessel function at @c a. */
+inline double ino(double a) {
+	double d = 0.0;
+	double ds = 1.0;
+	double s = 1.0;
+
+	do {
+		d += 2.0;
+		ds *= (a * a) / (d * d);
+		s += ds;
+	} while(ds > s*1e-9);
+
+	return s;
+}
+
+/*! @returns The Kaiser window shape factor, alpha, that provides @c attenuation decibels of attenuation. */
+inline double alpha(double attenuation) {
+	if(attenuation > 50.0) {
+		return 0.1102 * (attenuation - 8.7);
+	}
+	if(attenuation > 21.0) {
+		return 0.5842 * std::pow(attenuation - 21.0, 0.4) + 0.7886 * (attenuation - 21.0);
+	}
+	return 0.0;
+}
+
+/*!
+	@returns The Kaiser window, of shape factor @c alpha, at @c x in the range [-1, 1];
+	@c i0_alpha should be @c ino(alpha).
+*/
+inline double window(double x, double alpha, double i0_alpha) {
+	return ino(alpha * std::sqrt(std::max(0.0, 1.0 - x*x))) / i0_alpha;
+}
+
+}
+}
+
+#endif /* KaiserBessel_hpp */
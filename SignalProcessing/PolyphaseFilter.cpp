@@ -0,0 +1,57 @@
+//
+//  PolyphaseFilter.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#include "PolyphaseFilter.hpp"
+#include "KaiserBessel.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace SignalProcessing;
+
+PolyphaseFilter::PolyphaseFilter(std::size_t number_of_taps, std::size_t number_of_phases, float input_sample_rate, float high_frequency, float attenuation) :
+	number_of_taps_(std::max(number_of_taps, std::size_t(1))) {
+	number_of_phases = std::max(number_of_phases, std::size_t(1));
+
+	// Cut-off, as a proportion of the input rate.
+	const double cutoff = std::min(double(high_frequency) / double(input_sample_rate), 0.5);
+
+	const double alpha = KaiserBessel::alpha(double(attenuation));
+	const double i0_alpha = KaiserBessel::ino(alpha);
+
+	// Centre the window half a sample beyond the outermost taps so that neither end is zero at any phase.
+	const double delay = double(number_of_taps_ - 1) / 2.0;
+	const double half_width = double(number_of_taps_ + 1) / 2.0;
+
+	phases_.reserve(number_of_phases);
+	std::vector<float> coefficients(number_of_taps_);
+	for(std::size_t phase = 0; phase < number_of_phases; phase++) {
+		// Phase n produces the output n/number_of_phases of an input sample beyond the
+		// centre of its window; its coefficients are normalised for unity gain at DC.
+		const double offset = double(phase) / double(number_of_phases);
+		double total = 0.0;
+		std::vector<double> kernel(number_of_taps_);
+		for(std::size_t tap = 0; tap < number_of_taps_; tap++) {
+			const double t = double(tap) - delay - offset;
+			const double x = t / half_width;
+			const double window = KaiserBessel::window(x, alpha, i0_alpha);
+			const double sinc = (t == 0.0) ? 1.0 : std::sin(2.0 * M_PI * cutoff * t) / (2.0 * M_PI * cutoff * t);
+			kernel[tap] = window * sinc;
+			total += kernel[tap];
+		}
+
+		for(std::size_t tap = 0; tap < number_of_taps_; tap++) {
+			coefficients[tap] = float(kernel[tap] / total);
+		}
+		phases_.emplace_back(coefficients);
+	}
+}
@@ -0,0 +1,83 @@
+//
+//  PolyphaseFilter.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef PolyphaseFilter_hpp
+#define PolyphaseFilter_hpp
+
+#include "FIRFilter.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace SignalProcessing {
+
+/*!
+	A polyphase filter is a bank of low-pass FIR filters that differ only in the fractional
+	input-sample offset at which each samples its output. So it can resample a PCM signal
+	by any ratio, upward or downward, with no per-sample coefficient calculation: an output
+	at fractional position p between input samples is formed by applying the filter for
+	the phase nearest to p.
+
+	Each phase has a latency of (number_of_taps - 1) / 2 input samples plus its fractional offset.
+*/
+class PolyphaseFilter {
+	public:
+		/*!
+			Creates an instance of @c PolyphaseFilter.
+
+			@param number_of_taps The size of window for input data.
+			@param number_of_phases The number of distinct fractional offsets for which filters will be precomputed.
+			@param input_sample_rate The sampling rate of the input signal.
+			@param high_frequency The highest frequency of signal to retain in the output.
+			@param attenuation The attenuation of the discarded frequencies.
+		*/
+		PolyphaseFilter(std::size_t number_of_taps, std::size_t number_of_phases, float input_sample_rate, float high_frequency, float attenuation = FIRFilter::DefaultAttenuation);
+
+		/*!
+			Applies the filter for @c phase to one batch of input samples, returning the net result.
+
+			@param src The source buffer to apply the filter to.
+			@param phase The fractional offset of the output, in units of 1/number_of_phases of an input sample.
+			@returns The result of applying the filter.
+		*/
+		inline short apply(const short *src, std::size_t phase) const {
+			return phases_[phase].apply(src);
+		}
+
+		/*!
+			Applies the filter for @c phase to one batch of interleaved stereo input samples; see FIRFilter::apply_stereo.
+		*/
+		inline void apply_stereo(const short *src, std::size_t phase, short *target) const {
+			phases_[phase].apply_stereo(src, target);
+		}
+
+		/*!
+			Applies the filter for @c phase to input that is @c level throughout; see FIRFilter::apply_constant.
+		*/
+		inline short apply_constant(short level, std::size_t phase) const {
+			return phases_[phase].apply_constant(level);
+		}
+
+		/*! @returns The number of taps used by each phase of this filter. */
+		inline std::size_t get_number_of_taps() const {
+			return number_of_taps_;
+		}
+
+		/*! @returns The number of phases provided by this filter. */
+		inline std::size_t get_number_of_phases() const {
+			return phases_.size();
+		}
+
+	private:
+		std::size_t number_of_taps_;
+		std::vector<FIRFilter> phases_;
+};
+
+}
+
+#endif /* PolyphaseFilter_hpp */
@@ -0,0 +1,99 @@
+//
+//  StepSynthesiser.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#include "StepSynthesiser.hpp"
+#include "KaiserBessel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace SignalProcessing;
+
+void StepSynthesiser::set_parameters(float input_sample_rate, float output_sample_rate, float high_frequency) {
+	// Keep the cut-off a little way below the output Nyquist frequency, as there are
+	// relatively few taps and therefore a fairly wide transition band.
+	double cutoff = 0.45;
+	set_sample_rates(input_sample_rate, output_sample_rate);
+	if(input_sample_length_ && high_frequency > 0.0f) {
+		cutoff = std::min(cutoff, double(high_frequency) / double(output_sample_rate));
+	}
+
+	// Allow a kernel length in proportion to the width of the main lobe, much as
+	// LowpassSpeaker does for its FIR filter, rounded up to a multiple of eight.
+	taps_ = std::max(MinimumTaps, (std::size_t(std::ceil(2.0 / cutoff)) + 7) & ~std::size_t(7));
+
+	// Use a Kaiser window for 60dB of attenuation, as per FIRFilter's default.
+	const double alpha = KaiserBessel::alpha(60.0);
+	const double i0_alpha = KaiserBessel::ino(alpha);
+	const double half_width = double(taps_) / 2.0;
+
+	kernels_.resize(Phases * taps_);
+	std::vector<double> kernel(taps_);
+	for(std::size_t phase = 0; phase < Phases; phase++) {
+		// Each kernel is centred on the step, which is phase/Phases of the way
+		// into its first output sample, plus a delay of half the kernel.
+		double total = 0.0;
+		for(std::size_t tap = 0; tap < taps_; tap++) {
+			const double t = double(tap) - half_width - double(phase) / double(Phases);
+			const double x = t / half_width;
+			const double window = (x > -1.0 && x < 1.0) ? KaiserBessel::window(x, alpha, i0_alpha) : 0.0;
+			const double sinc = (t == 0.0) ? 1.0 : std::sin(2.0 * M_PI * cutoff * t) / (2.0 * M_PI * cutoff * t);
+			kernel[tap] = window * sinc;
+			total += kernel[tap];
+		}
+
+		// Quantise, ensuring that the kernel sums to exactly 1.0 so that the integrated output
+		// settles precisely on each new level; any rounding error goes to the largest tap.
+		int32_t *const target = &kernels_[phase * taps_];
+		int32_t sum = 0;
+		std::size_t largest = 0;
+		for(std::size_t tap = 0; tap < taps_; tap++) {
+			target[tap] = int32_t(std::round(kernel[tap] * double(1 << KernelShift) / total));
+			sum += target[tap];
+			if(target[tap] > target[largest]) largest = tap;
+		}
+		target[largest] += (1 << KernelShift) - sum;
+	}
+}
+
+void StepSynthesiser::set_sample_rates(float input_sample_rate, float output_sample_rate) {
+	input_sample_length_ = 0;
+	if(input_sample_rate > 0.0f && output_sample_rate > 0.0f) {
+		input_sample_length_ = uint64_t((double(output_sample_rate) / double(input_sample_rate)) * 4294967296.0);
+	}
+}
+
+std::size_t StepSynthesiser::end_period(std::size_t length) {
+	period_start_ += length * input_sample_length_;
+
+	const std::size_t complete = std::size_t(period_start_ >> 32);
+	if(complete + taps_ > deltas_.size()) {
+		deltas_.resize(complete + taps_);
+	}
+	return complete;
+}
+
+void StepSynthesiser::get_samples(std::size_t count, int16_t *target, std::size_t stride) {
+	int64_t accumulator = accumulator_;
+	for(std::size_t c = 0; c < count; c++) {
+		accumulator += deltas_[c];
+		*target = int16_t(std::clamp(accumulator >> KernelShift, int64_t(-32768), int64_t(32767)));
+		target += stride;
+	}
+	accumulator_ = accumulator;
+
+	// Shuffle down whatever remains, and account for the samples consumed.
+	std::memmove(deltas_.data(), &deltas_[count], (deltas_.size() - count) * sizeof(int64_t));
+	std::fill(deltas_.end() - ptrdiff_t(count), deltas_.end(), 0);
+	period_start_ -= uint64_t(count) << 32;
+}
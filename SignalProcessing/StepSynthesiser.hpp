@@ -0,0 +1,102 @@
+//
+//  StepSynthesiser.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef StepSynthesiser_hpp
+#define StepSynthesiser_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SignalProcessing {
+
+/*!
+	A step synthesiser produces band-limited output at a fixed output rate from a list of
+	amplitude transitions — steps — that are timestamped at a higher input rate.
+
+	Each step is accumulated into a buffer of output-rate deltas as a windowed-sinc impulse
+	positioned to within 1/64th of an output sample; output is then formed by integrating
+	those deltas. So the cost is proportional to the number of steps plus the number of
+	output samples, rather than to the number of input samples.
+
+	Usage is in periods: the owner posts steps via @c add_step, each positioned relative to
+	the start of the current period, then calls @c end_period to announce the period's length
+	and discover how many output samples are now complete. Those can be collected via @c get_samples.
+*/
+class StepSynthesiser {
+	public:
+		/*!
+			Sets the input and output sample rates, and the highest frequency that should be retained.
+			Any steps already posted but not yet output are retained.
+		*/
+		void set_parameters(float input_sample_rate, float output_sample_rate, float high_frequency);
+
+		/*!
+			Changes the input and output sample rates without recomputing kernels, so the cut-off
+			moves in proportion to the output rate. This is much cheaper than @c set_parameters,
+			and therefore suited to small, frequent adjustments.
+		*/
+		void set_sample_rates(float input_sample_rate, float output_sample_rate);
+
+		/*!
+			Adds a change of @c amount in output level, occurring @c offset input samples after the
+			start of the current period.
+		*/
+		inline void add_step(std::size_t offset, int amount) {
+			const uint64_t position = period_start_ + offset * input_sample_length_;
+			const std::size_t index = std::size_t(position >> 32);
+			if(index + taps_ > deltas_.size()) {
+				deltas_.resize(index + taps_);
+			}
+
+			const int32_t *const kernel = &kernels_[((position >> (32 - PhaseBits)) & (Phases - 1)) * taps_];
+			int64_t *const deltas = &deltas_[index];
+			for(std::size_t c = 0; c < taps_; c++) {
+				deltas[c] += int64_t(kernel[c]) * amount;
+			}
+		}
+
+		/*!
+			Ends the current period, which was @c length input samples long.
+
+			@returns The number of output samples that are now complete and may be obtained via @c get_samples.
+		*/
+		std::size_t end_period(std::size_t length);
+
+		/*!
+			Writes @c count complete output samples to @c target, at intervals of @c stride.
+		*/
+		void get_samples(std::size_t count, int16_t *target, std::size_t stride = 1);
+
+	private:
+		static constexpr int PhaseBits = 6;
+		static constexpr std::size_t Phases = 1 << PhaseBits;
+		static constexpr int KernelShift = 14;
+
+		// The number of output samples that each step affects; this grows if a cut-off
+		// well below the output rate is requested.
+		static constexpr std::size_t MinimumTaps = 32;
+		std::size_t taps_ = MinimumTaps;
+
+		// Phases × taps_ integer kernels, each summing to exactly 1 << KernelShift.
+		std::vector<int32_t> kernels_;
+
+		// Pending output deltas, starting from the next output sample. A single full-range
+		// 16-bit step already occupies most of 32 bits once scaled by a kernel, and those
+		// that are close together can sum, so both deltas and their integral are 64-bit.
+		std::vector<int64_t> deltas_;
+		int64_t accumulator_ = 0;
+
+		// Both in 32.32 fixed point, measured in output samples.
+		uint64_t period_start_ = 0;
+		uint64_t input_sample_length_ = 0;
+};
+
+}
+
+#endif /* StepSynthesiser_hpp */
@@ -8,6 +8,8 @@
 
 #include "DiskController.hpp"
 
+#include <algorithm>
+
 using namespace Storage::Disk;
 
 Controller::Controller(Cycles clock_rate) :
@@ -39,6 +41,8 @@ ClockingHint::Preference Controller::preferred_clocking() const {
 }
 
 void Controller::run_for(const Cycles cycles) {
+	if(allows_direct_reading_ || direct_drive_) update_direct_reading();
+
 	for(auto &drive: drives_) {
 		drive.run_for(cycles);
 	}
@@ -54,11 +58,18 @@ Drive &Controller::get_drive() {
 void Controller::process_event(const Drive::Event &event) {
 	switch(event.type) {
 		case Track::Event::FluxTransition:	pll_.add_pulse();		break;
-		case Track::Event::IndexHole:		process_index_hole();	break;
+		case Track::Event::IndexHole:
+			if(direct_drive_ == drive_) read_directly(true);
+			process_index_hole();
+		break;
 	}
 }
 
 void Controller::advance(const Cycles cycles) {
+	if(direct_drive_ == drive_) {
+		read_directly(false);
+		return;
+	}
 	if(is_reading_) pll_.run_for(Cycles(cycles.as_integral() * clock_rate_multiplier_));
 }
 
@@ -85,6 +96,104 @@ void Controller::digital_phase_locked_loop_output_bit(int value) {
 	if(is_reading_) process_input_bit(value);
 }
 
+void Controller::digital_phase_locked_loop_output_zeroes(int count) {
+	if(is_reading_) process_input_bits(0, count);
+}
+
+void Controller::process_input_bits(int value, int count) {
+	while(count-- && is_reading_) process_input_bit(value);
+}
+
+// MARK: - Direct reading
+
+void Controller::set_allows_direct_reading(bool allows_direct_reading) {
+	// This will take effect upon the next run_for.
+	allows_direct_reading_ = allows_direct_reading;
+}
+
+void Controller::process_input_bits(const uint64_t *bits, std::size_t begin, std::size_t end) {
+	while(begin < end && is_reading_) {
+		process_input_bit(int(bits[begin >> 6] >> (63 - (begin & 63))) & 1);
+		++begin;
+	}
+}
+
+void Controller::update_direct_reading() {
+	// If a different drive has been selected, restore flux reporting to the one previously read from.
+	if(direct_drive_ && direct_drive_ != drive_) {
+		direct_drive_->set_reports_flux_transitions(true);
+		direct_drive_ = nullptr;
+		direct_track_ = nullptr;
+	}
+
+	const bool should_read_directly =
+		allows_direct_reading_ &&
+		drive_->has_disk() &&
+		select_direct_track(drive_->get_current_track());
+	drive_->set_reports_flux_transitions(!should_read_directly);
+	direct_drive_ = should_read_directly ? drive_ : nullptr;
+}
+
+bool Controller::select_direct_track(const std::shared_ptr<Track> &track) {
+	if(track == direct_track_ && bit_length_ == direct_bit_length_) {
+		return direct_bit_count_;
+	}
+
+	direct_track_ = track;
+	direct_bit_length_ = bit_length_;
+	direct_bit_count_ = 0;
+	direct_bits_.clear();
+
+	// Only a track that is a single segment, which hasn't been resampled to accommodate writes
+	// and which has no fuzzy bits, can be read directly.
+	const auto pcm_track = dynamic_cast<PCMTrack *>(track.get());
+	if(!pcm_track || pcm_track->is_resampled_clone()) return false;
+
+	const PCMSegment *const segment = pcm_track->get_sole_segment();
+	if(!segment || std::find(segment->fuzzy_mask.begin(), segment->fuzzy_mask.end(), true) != segment->fuzzy_mask.end()) {
+		return false;
+	}
+
+	// Also require the track to be within an eighth of the expected number of bits; otherwise it's
+	// being read at the wrong density and the PLL's version of events is the interesting one.
+	const double expected_bits =
+		double(drive_->get_cycles_per_revolution()) / (double(drive_->get_input_clock_rate()) * bit_length_.get<double>());
+	const double bits = double(segment->data.size());
+	if(bits < expected_bits * 0.875 || bits > expected_bits * 1.125) return false;
+
+	direct_bit_count_ = segment->data.size();
+	direct_bits_.resize((direct_bit_count_ + 63) >> 6);
+	for(std::size_t bit = 0; bit < direct_bit_count_; ++bit) {
+		if(segment->data[bit]) direct_bits_[bit >> 6] |= uint64_t(1) << (63 - (bit & 63));
+	}
+
+	// Begin from wherever the head currently is.
+	direct_bit_cursor_ = direct_bit_position();
+	return true;
+}
+
+std::size_t Controller::direct_bit_position() const {
+	const auto cycles = uint64_t(drive_->get_cycles_since_index_hole());
+	const auto position = cycles * direct_bit_count_ / uint64_t(drive_->get_cycles_per_revolution());
+	return std::min(direct_bit_count_, std::size_t(position));
+}
+
+void Controller::read_directly(bool to_end_of_track) {
+	// If the track or density has changed then switch immediately if possible; otherwise
+	// nothing can be read until flux reporting is restored by the next run_for.
+	if(drive_->get_current_track() != direct_track_ || !(bit_length_ == direct_bit_length_)) {
+		if(!select_direct_track(drive_->get_current_track())) return;
+	}
+
+	const std::size_t target = to_end_of_track ? direct_bit_count_ : direct_bit_position();
+	if(is_reading_ && target > direct_bit_cursor_) {
+		process_input_bits(direct_bits_.data(), direct_bit_cursor_, target);
+	}
+	direct_bit_cursor_ = to_end_of_track ? 0 : target;
+}
+
+// MARK: - Drive selection
+
 void Controller::set_drive(int index_mask) {
 	if(drive_selection_mask_ == index_mask) {
 		return;
@@ -79,6 +79,36 @@ class Controller:
 		*/
 		virtual void process_input_bit(int value) = 0;
 
+		/*!
+			May be implemented by subclasses that can process runs of bits more efficiently than
+			one at a time; communicates that @c count consecutive bits of @c value have been recognised.
+
+			The default implementation makes an appropriate number of calls to @c process_input_bit,
+			stopping early if the controller ceases reading.
+		*/
+		virtual void process_input_bits(int value, int count);
+
+		/*!
+			May be implemented by subclasses that can process packed bits more efficiently than one at a time;
+			communicates bits @c begin to @c end (exclusive) of @c bits, which are packed most-significant bit first.
+			This is used only while reading directly; see @c set_allows_direct_reading.
+
+			The default implementation makes an appropriate number of calls to @c process_input_bit,
+			stopping early if the controller ceases reading.
+		*/
+		virtual void process_input_bits(const uint64_t *bits, std::size_t begin, std::size_t end);
+
+		/*!
+			Enables or disables direct reading. If enabled then whenever the current track consists of a single
+			segment of unmodified bits, at approximately the rate set via @c set_expected_bit_length,
+			those bits are supplied directly rather than being converted to flux transitions and
+			fed through the PLL. Other tracks, including any that have been written to, continue to be read via flux.
+
+			This is not a realistic mode of operation and therefore should be used only on the user's say so, but
+			it is indistinguishable in practice for tracks generated from sector images.
+		*/
+		void set_allows_direct_reading(bool);
+
 		/*!
 			Should be implemented by subclasses; communicates that the index hole has been reached.
 		*/
@@ -143,6 +173,20 @@ class Controller:
 
 		bool is_reading_ = true;
 
+		// Direct reading state: the drive and track being read, and that track's bits, packed
+		// most-significant bit first. direct_bit_count_ is zero if the track isn't eligible.
+		bool allows_direct_reading_ = false;
+		Drive *direct_drive_ = nullptr;
+		std::shared_ptr<Track> direct_track_;
+		Time direct_bit_length_;
+		std::vector<uint64_t> direct_bits_;
+		std::size_t direct_bit_count_ = 0;
+		std::size_t direct_bit_cursor_ = 0;
+		void update_direct_reading();
+		bool select_direct_track(const std::shared_ptr<Track> &);
+		std::size_t direct_bit_position() const;
+		void read_directly(bool to_end_of_track);
+
 		DigitalPhaseLockedLoop<Controller> pll_;
 		friend DigitalPhaseLockedLoop<Controller>;
 
@@ -160,6 +204,7 @@ class Controller:
 
 		// to satisfy DigitalPhaseLockedLoop::Delegate
 		void digital_phase_locked_loop_output_bit(int value);
+		void digital_phase_locked_loop_output_zeroes(int count);
 };
 
 }
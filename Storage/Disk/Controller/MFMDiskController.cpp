@@ -10,6 +10,8 @@
 
 #include "../Encodings/MFM/Constants.hpp"
 
+#include <algorithm>
+
 using namespace Storage::Disk;
 
 MFMController::MFMController(Cycles clock_rate) :
@@ -56,6 +58,34 @@ void MFMController::process_input_bit(int value) {
 	if(data_mode_ == DataMode::Writing) return;
 
 	shifter_.add_input_bit(value);
+	post_token();
+}
+
+void MFMController::process_input_bits(int value, int count) {
+	if(value) {
+		Controller::process_input_bits(value, count);
+		return;
+	}
+
+	// Feed zeroes to the shifter in bulk; it'll stop after each token, which gives the
+	// state machine an opportunity to react exactly as if bits were being supplied singly.
+	static constexpr uint64_t zeroes[16]{};
+	while(count && is_reading() && data_mode_ != DataMode::Writing) {
+		const auto length = std::min(std::size_t(count), sizeof(zeroes) * 8);
+		const auto consumed = shifter_.add_input_bits(zeroes, 0, length);
+		count -= int(consumed);
+		post_token();
+	}
+}
+
+void MFMController::process_input_bits(const uint64_t *bits, std::size_t begin, std::size_t end) {
+	while(begin < end && is_reading() && data_mode_ != DataMode::Writing) {
+		begin = shifter_.add_input_bits(bits, begin, end);
+		post_token();
+	}
+}
+
+void MFMController::post_token() {
 	switch(shifter_.get_token()) {
 		case Encodings::MFM::Shifter::Token::None:
 		return;
@@ -148,12 +148,15 @@ class MFMController: public Controller {
 	private:
 		// Storage::Disk::Controller
 		virtual void process_input_bit(int value);
+		virtual void process_input_bits(int value, int count);
+		virtual void process_input_bits(const uint64_t *bits, std::size_t begin, std::size_t end);
 		virtual void process_index_hole();
 		virtual void process_write_completed();
 
 		// Reading state.
 		Token latest_token_;
 		Encodings::MFM::Shifter shifter_;
+		void post_token();
 
 		// input configuration
 		bool is_double_density_;
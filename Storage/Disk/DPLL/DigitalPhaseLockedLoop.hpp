@@ -21,7 +21,8 @@ namespace Storage {
 /*!
 	Template parameters:
 
-	@c bit_handler A class that must implement a method, digital_phase_locked_loop_output_bit(int) for receving bits from the DPLL.
+	@c bit_handler A class that must implement a method, digital_phase_locked_loop_output_bit(int) for receving bits from the DPLL,
+		and a method digital_phase_locked_loop_output_zeroes(int) for receiving runs of consecutive zeroes.
 	@c length_of_history The number of historic pulses to consider in locking to phase.
 */
 template <typename BitHandler, size_t length_of_history = 3> class DigitalPhaseLockedLoop {
@@ -52,10 +53,10 @@ template <typename BitHandler, size_t length_of_history = 3> class DigitalPhaseL
 			if(phase_ >= window_length_) {
 				auto windows_crossed = phase_ / window_length_;
 
-				// Check whether this triggers any 0s.
+				// Check whether this triggers any 0s; if so then post them as a single run.
 				if(window_was_filled_) --windows_crossed;
-				for(int c = 0; c < windows_crossed; c++)
-					bit_handler_.digital_phase_locked_loop_output_bit(0);
+				if(windows_crossed > 0)
+					bit_handler_.digital_phase_locked_loop_output_zeroes(int(windows_crossed));
 
 				window_was_filled_ = false;
 				phase_ %= window_length_;
@@ -138,6 +138,40 @@ bool Drive::get_tachometer() const {
 	return int(get_rotation() * 2.0f * ticks_per_rotation) & 1;
 }
 
+void Drive::set_reports_flux_transitions(bool reports_flux_transitions) {
+	if(reports_flux_transitions_ == reports_flux_transitions) return;
+	reports_flux_transitions_ = reports_flux_transitions;
+
+	// Discard whatever event was pending and schedule afresh from the current position; if
+	// flux transitions are now to be reported, that'll involve seeking within the track.
+	random_interval_ = 0.0f;
+	if(reports_flux_transitions_) track_ = nullptr;
+	reset_timer();
+	get_next_event(0.0f);
+}
+
+const std::shared_ptr<Track> &Drive::get_current_track() {
+	if(!track_ && disk_) {
+		if(reports_flux_transitions_) {
+			reset_timer();
+			setup_track();
+		} else {
+			// Event timing is independent of the track if flux transitions aren't being
+			// reported, so there's no need to seek.
+			load_track();
+		}
+	}
+	return track_;
+}
+
+Cycles::IntType Drive::get_cycles_since_index_hole() const {
+	return cycles_since_index_hole_;
+}
+
+int Drive::get_cycles_per_revolution() const {
+	return cycles_per_revolution_;
+}
+
 float Drive::get_rotation() const {
 	return get_time_into_track();
 }
@@ -216,30 +250,28 @@ void Drive::run_for(const Cycles cycles) {
 
 	if(disk_is_rotating_) {
 		if(has_disk_) {
-			Time zero(0);
-
 			auto number_of_cycles = cycles.as_integral();
 			while(number_of_cycles) {
 				auto cycles_until_next_event = get_cycles_until_next_event();
 				auto cycles_to_run_for = std::min(cycles_until_next_event, number_of_cycles);
-				if(!is_reading_ && cycles_until_bits_written_ > zero) {
-					auto write_cycles_target = cycles_until_bits_written_.get<Cycles::IntType>();
-					if(cycles_until_bits_written_.length % cycles_until_bits_written_.clock_rate) ++write_cycles_target;
+				if(!is_reading_ && cycles_until_bits_written_) {
+					// Round up to the cycle in which the final bit is completed.
+					const auto write_cycles_target = Cycles::IntType((cycles_until_bits_written_ + 0xffff'ffff) >> 32);
 					cycles_to_run_for = std::min(cycles_to_run_for, write_cycles_target);
 				}
 
 				number_of_cycles -= cycles_to_run_for;
 				if(!is_reading_) {
-					if(cycles_until_bits_written_ > zero) {
-						Storage::Time cycles_to_run_for_time(static_cast<int>(cycles_to_run_for));
-						if(cycles_until_bits_written_ <= cycles_to_run_for_time) {
+					if(cycles_until_bits_written_) {
+						const uint64_t cycles_to_run_for_fixed = uint64_t(cycles_to_run_for) << 32;
+						if(cycles_until_bits_written_ <= cycles_to_run_for_fixed) {
 							if(event_delegate_) event_delegate_->process_write_completed();
-							if(cycles_until_bits_written_ <= cycles_to_run_for_time)
-								cycles_until_bits_written_.set_zero();
+							if(cycles_until_bits_written_ <= cycles_to_run_for_fixed)
+								cycles_until_bits_written_ = 0;
 							else
-								cycles_until_bits_written_ -= cycles_to_run_for_time;
+								cycles_until_bits_written_ -= cycles_to_run_for_fixed;
 						} else {
-							cycles_until_bits_written_ -= cycles_to_run_for_time;
+							cycles_until_bits_written_ -= cycles_to_run_for_fixed;
 						}
 					}
 				}
@@ -270,6 +302,14 @@ void Drive::get_next_event(float duration_already_passed) {
 		return;
 	}
 
+	// If flux transitions aren't being reported, just wait for the next index hole.
+	if(!reports_flux_transitions_) {
+		current_event_.type = Track::Event::IndexHole;
+		current_event_.length = 1.0f;
+		set_next_event_time_interval(std::max(1.0f - get_time_into_track(), 0.0f) * rotational_multiplier_);
+		return;
+	}
+
 	// Grab a new track if not already in possession of one. This will recursively call get_next_event,
 	// supplying a proper duration_already_passed.
 	if(!track_) {
@@ -350,11 +390,15 @@ void Drive::set_track(const std::shared_ptr<Track> &track) {
 	if(disk_) disk_->set_track_at_position(Track::Address(head_, head_position_), track);
 }
 
-void Drive::setup_track() {
+void Drive::load_track() {
 	track_ = get_track();
 	if(!track_) {
 		track_ = std::make_shared<UnformattedTrack>();
 	}
+}
+
+void Drive::setup_track() {
+	load_track();
 
 	float offset = 0.0f;
 	const float track_time_now = get_time_into_track();
@@ -388,17 +432,18 @@ void Drive::begin_writing(Time bit_length, bool clamp_to_index_hole) {
 	// TODO: cope properly if there's no disk to write to.
 	if(!is_reading_ || !disk_) return;
 
-	// Get a copy of the track if that hasn't happened yet.
+	// Get a copy of the track if that hasn't happened yet; there's no need to seek
+	// if flux transitions aren't being reported.
 	if(!track_) {
-		setup_track();
+		if(reports_flux_transitions_) setup_track();
+		else load_track();
 	}
 
 	// Store the relevant parameters, and kick off writing.
 	is_reading_ = false;
 	clamp_writing_to_index_hole_ = clamp_to_index_hole;
 
-	cycles_per_bit_ = Storage::Time(int(get_input_clock_rate())) * bit_length;
-	cycles_per_bit_.simplify();
+	cycles_per_bit_ = bit_length.get_fixed_cycles(uint32_t(get_input_clock_rate()));
 
 	write_segment_.length_of_a_bit = bit_length / Time(rotational_multiplier_);
 	write_segment_.data.clear();
@@ -179,6 +179,30 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		*/
 		bool get_tachometer() const;
 
+		/*!
+			Sets whether this drive will report flux transitions to its event delegate. If not then
+			only index holes are reported; this is for the benefit of controllers that instead
+			read the current track directly, as obtained via @c get_current_track.
+
+			Should not be called while an event is being processed.
+		*/
+		void set_reports_flux_transitions(bool);
+
+		/*!
+			@returns the track currently underneath the head, or @c nullptr if no disk is inserted.
+		*/
+		const std::shared_ptr<Track> &get_current_track();
+
+		/*!
+			@returns the number of input clock cycles that have elapsed since the index hole was last seen.
+		*/
+		Cycles::IntType get_cycles_since_index_hole() const;
+
+		/*!
+			@returns the number of input clock cycles that make up a single revolution at the current rotation speed.
+		*/
+		int get_cycles_per_revolution() const;
+
 	protected:
 		/*!
 			Announces the result of a step.
@@ -235,6 +259,9 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		bool is_reading_ = true;
 		bool clamp_writing_to_index_hole_ = false;
 
+		// If flux transitions aren't being reported then the event loop will visit only index holes.
+		bool reports_flux_transitions_ = true;
+
 		// If writing is occurring then the drive will be accumulating a write segment,
 		// for addition to a (high-resolution) PCM track.
 		std::shared_ptr<PCMTrack> patched_track_;
@@ -247,9 +274,9 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		bool is_ready_ = false;
 
 		// Maintains appropriate counting to know when to indicate that writing
-		// is complete.
-		Time cycles_until_bits_written_;
-		Time cycles_per_bit_;
+		// is complete; both are in 32.32 fixed point.
+		uint64_t cycles_until_bits_written_ = 0;
+		uint64_t cycles_per_bit_ = 0;
 
 		// TimedEventLoop call-ins and state.
 		void process_next_event() override;
@@ -272,6 +299,7 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		*/
 		void set_track(const std::shared_ptr<Track> &track);
 
+		void load_track();
 		void setup_track();
 		void invalidate_track();
 
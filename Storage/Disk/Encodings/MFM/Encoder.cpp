@@ -12,11 +12,39 @@
 #include "../../Track/PCMTrack.hpp"
 #include "../../../../Numeric/CRC.hpp"
 
+#include <array>
 #include <cassert>
 #include <set>
 
 using namespace Storage::Encodings::MFM;
 
+namespace {
+
+/// Maps from a byte to a 16-bit value with each of its bits in the even positions, i.e. as data bits.
+constexpr auto spread_bytes = [] {
+	std::array<uint16_t, 256> table{};
+	for(int c = 0; c < 256; c++) {
+		for(int bit = 0; bit < 8; bit++) {
+			table[c] |= uint16_t(((c >> bit) & 1) << (bit << 1));
+		}
+	}
+	return table;
+}();
+
+/// Maps from the previous data bit and a byte, as (previous << 8) | byte, to a complete MFM encoding:
+/// each clock bit is set only if the data bits on either side of it are both clear.
+constexpr auto mfm_bytes = [] {
+	std::array<uint16_t, 512> table{};
+	for(int c = 0; c < 512; c++) {
+		const uint16_t spread_value = spread_bytes[c & 0xff];
+		const uint16_t or_bits = uint16_t((spread_value << 1) | (spread_value >> 1) | ((c >> 8) << 15));
+		table[c] = spread_value | ((~or_bits) & 0xaaaa);
+	}
+	return table;
+}();
+
+}
+
 enum class SurfaceItem {
 	Mark,
 	Data
@@ -29,33 +57,7 @@ class MFMEncoder: public Encoder {
 
 		void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) final {
 			crc_generator_.add(input);
-			const uint16_t spread_value =
-				uint16_t(
-					((input & 0x01) << 0) |
-					((input & 0x02) << 1) |
-					((input & 0x04) << 2) |
-					((input & 0x08) << 3) |
-					((input & 0x10) << 4) |
-					((input & 0x20) << 5) |
-					((input & 0x40) << 6) |
-					((input & 0x80) << 7)
-				);
-			const uint16_t or_bits = uint16_t((spread_value << 1) | (spread_value >> 1) | (last_output_ << 15));
-			const uint16_t output = spread_value | ((~or_bits) & 0xaaaa);
-
-			const uint16_t spread_mask =
-				uint16_t(
-					((fuzzy_mask & 0x01) << 0) |
-					((fuzzy_mask & 0x02) << 1) |
-					((fuzzy_mask & 0x04) << 2) |
-					((fuzzy_mask & 0x08) << 3) |
-					((fuzzy_mask & 0x10) << 4) |
-					((fuzzy_mask & 0x20) << 5) |
-					((fuzzy_mask & 0x40) << 6) |
-					((fuzzy_mask & 0x80) << 7)
-				);
-
-			output_short(output, spread_mask);
+			output_short(mfm_bytes[((last_output_ & 1) << 8) | input], spread_bytes[fuzzy_mask]);
 		}
 
 		void add_index_address_mark() final {
@@ -88,7 +90,7 @@ class MFMEncoder: public Encoder {
 		}
 
 	private:
-		uint16_t last_output_;
+		uint16_t last_output_ = 0;
 		void output_short(uint16_t value, uint16_t fuzzy_mask = 0) final {
 			last_output_ = value;
 			Encoder::output_short(value, fuzzy_mask);
@@ -107,29 +109,7 @@ class FMEncoder: public Encoder {
 
 		void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) final {
 			crc_generator_.add(input);
-			output_short(
-				uint16_t(
-					((input & 0x01) << 0) |
-					((input & 0x02) << 1) |
-					((input & 0x04) << 2) |
-					((input & 0x08) << 3) |
-					((input & 0x10) << 4) |
-					((input & 0x20) << 5) |
-					((input & 0x40) << 6) |
-					((input & 0x80) << 7) |
-					0xaaaa
-				),
-				uint16_t(
-					((fuzzy_mask & 0x01) << 0) |
-					((fuzzy_mask & 0x02) << 1) |
-					((fuzzy_mask & 0x04) << 2) |
-					((fuzzy_mask & 0x08) << 3) |
-					((fuzzy_mask & 0x10) << 4) |
-					((fuzzy_mask & 0x20) << 5) |
-					((fuzzy_mask & 0x40) << 6) |
-					((fuzzy_mask & 0x80) << 7)
-				)
-			);
+			output_short(spread_bytes[input] | 0xaaaa, spread_bytes[fuzzy_mask]);
 		}
 
 		void add_index_address_mark() final {
@@ -23,10 +23,19 @@ std::map<std::size_t, Storage::Encodings::MFM::Sector> Storage::Encodings::MFM::
 	std::size_t size = 0;
 	std::size_t start_location = 0;
 
+	// Pack the segment's bits into words, so that the shifter can skip through gaps in bulk.
+	const std::size_t length = segment.data.size();
+	std::vector<uint64_t> bits((length + 63) >> 6);
 	std::size_t bit_cursor = 0;
 	for(const auto bit: segment.data) {
-		shifter.add_input_bit(bit ? 1 : 0);
+		if(bit) bits[bit_cursor >> 6] |= uint64_t(1) << (63 - (bit_cursor & 63));
 		++bit_cursor;
+	}
+
+	bit_cursor = 0;
+	while(bit_cursor < length) {
+		// Bytes matter only while reading; otherwise proceed directly to the next mark.
+		bit_cursor = shifter.add_input_bits(bits.data(), bit_cursor, length, is_reading);
 
 		switch(shifter.get_token()) {
 			case Shifter::Token::None:
@@ -9,8 +9,53 @@
 #include "Shifter.hpp"
 #include "Constants.hpp"
 
+#include <algorithm>
+#include <array>
+
 using namespace Storage::Encodings::MFM;
 
+namespace {
+
+/// Maps from the data bits of an encoded byte — those in even positions — to a packed nibble.
+constexpr auto data_nibbles = [] {
+	std::array<uint8_t, 256> table{};
+	for(int c = 0; c < 256; c++) {
+		table[c] = uint8_t(
+			((c & 0x01) >> 0) |
+			((c & 0x04) >> 1) |
+			((c & 0x10) >> 2) |
+			((c & 0x40) >> 3)
+		);
+	}
+	return table;
+}();
+
+/// @returns the 64 bits starting at @c position within the MSB-first @c bits; anything from @c end onwards is undefined.
+uint64_t read_word(const uint64_t *bits, std::size_t position, std::size_t end) {
+	const auto shift = position & 63;
+	const auto index = position >> 6;
+	if(!shift) return bits[index];
+
+	uint64_t word = bits[index] << shift;
+	if(((index + 1) << 6) < end) word |= bits[index + 1] >> (64 - shift);
+	return word;
+}
+
+int leading_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clzll(value);
+#else
+	int count = 0;
+	while(!(value & 0x8000'0000'0000'0000)) {
+		value <<= 1;
+		++count;
+	}
+	return count;
+#endif
+}
+
+}
+
 Shifter::Shifter() : owned_crc_generator_(new CRC::CCITT()), crc_generator_(owned_crc_generator_.get()) {}
 Shifter::Shifter(CRC::CCITT *crc_generator) : crc_generator_(crc_generator) {}
 
@@ -95,40 +140,133 @@ void Shifter::add_input_bit(int value) {
 	}
 
 	if(bits_since_token_ == 16) {
-		token_ = Token::Byte;
-		bits_since_token_ = 0;
+		complete_byte();
+	}
+}
 
-		if(is_awaiting_marker_value_ && is_double_density_) {
-			is_awaiting_marker_value_ = false;
-			switch(get_byte()) {
-				case Storage::Encodings::MFM::IndexAddressByte:
-					token_ = Token::Index;
-				break;
-				case Storage::Encodings::MFM::IDAddressByte:
-					token_ = Token::ID;
-				break;
-				case Storage::Encodings::MFM::DataAddressByte:
-					token_ = Token::Data;
-				break;
-				case Storage::Encodings::MFM::DeletedDataAddressByte:
-					token_ = Token::DeletedData;
-				break;
-				default: break;
+void Shifter::complete_byte() {
+	token_ = Token::Byte;
+	bits_since_token_ = 0;
+
+	if(is_awaiting_marker_value_ && is_double_density_) {
+		is_awaiting_marker_value_ = false;
+		switch(get_byte()) {
+			case Storage::Encodings::MFM::IndexAddressByte:
+				token_ = Token::Index;
+			break;
+			case Storage::Encodings::MFM::IDAddressByte:
+				token_ = Token::ID;
+			break;
+			case Storage::Encodings::MFM::DataAddressByte:
+				token_ = Token::Data;
+			break;
+			case Storage::Encodings::MFM::DeletedDataAddressByte:
+				token_ = Token::DeletedData;
+			break;
+			default: break;
+		}
+	}
+
+	crc_generator_->add(get_byte());
+}
+
+std::size_t Shifter::add_input_bits(const uint64_t *bits, std::size_t begin, std::size_t end, bool report_bytes) {
+	while(begin < end) {
+		// Other than when a marker value is pending, the only thing that can interrupt the regular
+		// flow of bytes is a mark, so skip directly to the next one of those or to the next
+		// reportable byte, whichever is sooner.
+		//
+		// Searching for marks costs the same however little of a word is relevant, so over spans
+		// of only a few bits it's cheaper to proceed bit by bit.
+		if(!is_awaiting_marker_value_) {
+			std::size_t limit = report_bytes ? std::min(end, begin + std::size_t(15 - bits_since_token_)) : end;
+			if(should_obey_syncs_) {
+				limit = (limit - begin >= 8) ? find_mark(bits, begin, limit) : begin;
+			}
+			if(limit > begin) {
+				skip_bits(bits, begin, limit);
+				begin = limit;
+				if(begin == end) break;
+			}
+		}
+
+		add_input_bit(int((bits[begin >> 6] >> (63 - (begin & 63))) & 1));
+		++begin;
+		if(token_ != Token::None && (report_bytes || token_ != Token::Byte)) break;
+	}
+
+	return begin;
+}
+
+std::size_t Shifter::find_mark(const uint64_t *bits, std::size_t begin, std::size_t end) const {
+	// Test 64 window positions at once: shifted[n] holds, at each bit, the input from n bits earlier,
+	// so a position matches a pattern if every shifted[n] agrees there with bit n of the pattern.
+	uint64_t history = shift_register_;
+	while(begin < end) {
+		const uint64_t word = read_word(bits, begin, end);
+
+		uint64_t shifted[16];
+		shifted[0] = word;
+		for(int c = 1; c < 16; c++) {
+			shifted[c] = (word >> c) | (history << (64 - c));
+		}
+
+		const auto match = [&shifted](uint16_t pattern) {
+			uint64_t result = ~uint64_t(0);
+			for(int c = 0; c < 16; c++) {
+				result &= ((pattern >> c) & 1) ? shifted[c] : ~shifted[c];
 			}
+			return result;
+		};
+
+		uint64_t matches;
+		if(is_double_density_) {
+			matches =
+				match(Storage::Encodings::MFM::MFMIndexSync) |
+				match(Storage::Encodings::MFM::MFMSync);
+		} else {
+			matches =
+				match(Storage::Encodings::MFM::FMIndexAddressMark) |
+				match(Storage::Encodings::MFM::FMIDAddressMark) |
+				match(Storage::Encodings::MFM::FMDataAddressMark) |
+				match(Storage::Encodings::MFM::FMDeletedDataAddressMark);
+		}
+
+		const auto remaining = end - begin;
+		if(remaining < 64) {
+			matches &= ~(~uint64_t(0) >> remaining);
 		}
+		if(matches) {
+			return begin + std::size_t(leading_zeros(matches));
+		}
+
+		history = word;
+		begin += 64;
+	}
 
-		crc_generator_->add(get_byte());
+	return end;
+}
+
+void Shifter::skip_bits(const uint64_t *bits, std::size_t begin, std::size_t end) {
+	// Callers guarantee that no mark is completed within [begin, end), so proceed a byte at a time.
+	token_ = Token::None;
+	while(begin < end) {
+		const int count = int(std::min(end - begin, std::size_t(16 - bits_since_token_)));
+		shift_register_ = (shift_register_ << count) | unsigned(read_word(bits, begin, end) >> (64 - count));
+		bits_since_token_ += count;
+		begin += std::size_t(count);
+
+		if(bits_since_token_ == 16) {
+			complete_byte();
+		} else {
+			token_ = Token::None;
+		}
 	}
 }
 
 uint8_t Shifter::get_byte() const {
 	return uint8_t(
-		((shift_register_ & 0x0001) >> 0) |
-		((shift_register_ & 0x0004) >> 1) |
-		((shift_register_ & 0x0010) >> 2) |
-		((shift_register_ & 0x0040) >> 3) |
-		((shift_register_ & 0x0100) >> 4) |
-		((shift_register_ & 0x0400) >> 5) |
-		((shift_register_ & 0x1000) >> 6) |
-		((shift_register_ & 0x4000) >> 7));
+		data_nibbles[shift_register_ & 0xff] |
+		(data_nibbles[(shift_register_ >> 8) & 0xff] << 4)
+	);
 }
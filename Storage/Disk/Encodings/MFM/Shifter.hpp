@@ -9,6 +9,7 @@
 #ifndef Shifter_hpp
 #define Shifter_hpp
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include "../../../../Numeric/CRC.hpp"
@@ -31,7 +32,8 @@ namespace MFM {
 	detecting a false sync — the received byte value will be either a 0xc1 or 0x14,
 	depending on phase.
 
-	Bits should be fed in with @c add_input_bit.
+	Bits should be fed in with @c add_input_bit or, if already available in bulk, with
+	@c add_input_bits.
 
 	The current output token can be read with @c get_token. It will usually be None but
 	may indicate that an index, ID, data or deleted data mark was found, that an
@@ -54,6 +56,21 @@ class Shifter {
 		void set_should_obey_syncs(bool should_obey_syncs);
 		void add_input_bit(int bit);
 
+		/*!
+			Supplies bits from @c bits, a packed buffer in which each word is consumed from MSB to LSB,
+			starting from bit @c begin and continuing up to but not including bit @c end, stopping
+			early after any bit that produces a token.
+
+			This is equivalent to calling @c add_input_bit for each bit in turn and stopping upon the
+			first token other than @c None, except that if @c report_bytes is @c false then @c Byte
+			tokens do not cause a stop. Bytes passed over in that way are still added to the CRC generator.
+
+			Runs of bits that cannot contain a sync or mark are handled a word at a time.
+
+			@returns the index of the first bit not yet consumed.
+		*/
+		std::size_t add_input_bits(const uint64_t *bits, std::size_t begin, std::size_t end, bool report_bytes = true);
+
 		enum Token {
 			Index, ID, Data, DeletedData, Sync, Byte, None
 		};
@@ -78,6 +95,10 @@ class Shifter {
 
 		std::unique_ptr<CRC::CCITT> owned_crc_generator_;
 		CRC::CCITT *crc_generator_;
+
+		void complete_byte();
+		std::size_t find_mark(const uint64_t *bits, std::size_t begin, std::size_t end) const;
+		void skip_bits(const uint64_t *bits, std::size_t begin, std::size_t end);
 };
 
 }
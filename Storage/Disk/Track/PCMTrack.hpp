@@ -58,6 +58,12 @@ class PCMTrack: public Track {
 		PCMTrack *resampled_clone(size_t bits_per_track);
 		bool is_resampled_clone();
 
+		/*!
+			@returns the only segment that makes up this track if this track consists of exactly one
+			segment; @c nullptr otherwise.
+		*/
+		const PCMSegment *get_sole_segment() const;
+
 		/*!
 			Replaces whatever is currently on the track from @c start_position to @c start_position + segment length
 			with the contents of @c segment.
@@ -24,6 +24,9 @@ Storage::Disk::PCMSegment Storage::Disk::track_serialisation(const Track &track,
 		void digital_phase_locked_loop_output_bit(int value) {
 			if(is_recording) result.data.push_back(!!value);
 		}
+		void digital_phase_locked_loop_output_zeroes(int count) {
+			if(is_recording) result.data.insert(result.data.end(), size_t(count), false);
+		}
 	} result_accumulator;
 	result_accumulator.result.length_of_a_bit = length_of_a_bit;
 	DigitalPhaseLockedLoop<ResultAccumulator> pll(100, result_accumulator);
@@ -44,6 +44,20 @@ struct Time {
 		clock_rate /= common_divisor;
 	}
 
+	/*!
+		@returns this @c Time as a number of ticks of a clock running at @c rate, in 32.32 fixed point.
+		No common divisor is sought, so this is cheap; the result is exact to the final fractional bit,
+		saturating if the integral part won't fit into 32 bits.
+	*/
+	uint64_t get_fixed_cycles(uint32_t rate) const {
+		const uint64_t numerator = uint64_t(length) * uint64_t(rate);
+		const uint64_t whole = numerator / clock_rate;
+		if(whole > std::numeric_limits<uint32_t>::max()) return std::numeric_limits<uint64_t>::max();
+
+		const uint64_t remainder = numerator % clock_rate;
+		return (whole << 32) | ((remainder << 32) / clock_rate);
+	}
+
 	/*!
 		@returns the floating point conversion of this @c Time. This will often be less precise.
 	*/
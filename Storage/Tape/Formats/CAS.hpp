@@ -65,6 +65,15 @@ class CAS: public Tape {
 		} phase_ = Phase::Header;
 		std::size_t distance_into_phase_ = 0;
 		std::size_t distance_into_bit_ = 0;
+
+		struct ParsingState: public State {
+			std::size_t chunk_pointer;
+			Phase phase;
+			std::size_t distance_into_phase;
+			std::size_t distance_into_bit;
+		};
+		std::unique_ptr<State> get_state() final;
+		void set_state(const State &) final;
 };
 
 }
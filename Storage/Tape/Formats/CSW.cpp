@@ -122,6 +122,19 @@ void CSW::virtual_reset() {
 	source_data_pointer_ = 0;
 }
 
+std::unique_ptr<Tape::State> CSW::get_state() {
+	auto state = std::make_unique<ParsingState>();
+	state->pulse = pulse_;
+	state->source_data_pointer = source_data_pointer_;
+	return state;
+}
+
+void CSW::set_state(const State &state) {
+	const auto &csw_state = static_cast<const ParsingState &>(state);
+	pulse_ = csw_state.pulse;
+	source_data_pointer_ = csw_state.source_data_pointer;
+}
+
 Tape::Pulse CSW::virtual_get_next_pulse() {
 	invert_pulse();
 	pulse_.length.length = get_next_byte();
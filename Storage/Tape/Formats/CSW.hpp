@@ -60,6 +60,13 @@ class CSW: public Tape {
 
 		std::vector<uint8_t> source_data_;
 		std::size_t source_data_pointer_;
+
+		struct ParsingState: public State {
+			Pulse pulse;
+			std::size_t source_data_pointer;
+		};
+		std::unique_ptr<State> get_state() final;
+		void set_state(const State &) final;
 };
 
 }
@@ -49,6 +49,21 @@ bool CommodoreTAP::is_at_end() {
 	return is_at_end_;
 }
 
+std::unique_ptr<Storage::Tape::Tape::State> CommodoreTAP::get_state() {
+	auto state = std::make_unique<ParsingState>();
+	state->file_offset = file_.tell();
+	state->current_pulse = current_pulse_;
+	state->is_at_end = is_at_end_;
+	return state;
+}
+
+void CommodoreTAP::set_state(const State &state) {
+	const auto &tap_state = static_cast<const ParsingState &>(state);
+	file_.seek(tap_state.file_offset, SEEK_SET);
+	current_pulse_ = tap_state.current_pulse;
+	is_at_end_ = tap_state.is_at_end;
+}
+
 Storage::Tape::Tape::Pulse CommodoreTAP::virtual_get_next_pulse() {
 	if(is_at_end_) {
 		return current_pulse_;
@@ -47,6 +47,14 @@ class CommodoreTAP: public Tape {
 
 		Pulse current_pulse_;
 		bool is_at_end_ = false;
+
+		struct ParsingState: public State {
+			long file_offset;
+			Pulse current_pulse;
+			bool is_at_end;
+		};
+		std::unique_ptr<State> get_state() final;
+		void set_state(const State &) final;
 };
 
 }
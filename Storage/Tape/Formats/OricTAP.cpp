@@ -31,6 +31,33 @@ void OricTAP::virtual_reset() {
 	pulse_counter_ = 0;
 }
 
+std::unique_ptr<Tape::State> OricTAP::get_state() {
+	auto state = std::make_unique<ParsingState>();
+	state->file_offset = file_.tell();
+	state->current_value = current_value_;
+	state->bit_count = bit_count_;
+	state->pulse_counter = pulse_counter_;
+	state->phase = phase_;
+	state->next_phase = next_phase_;
+	state->phase_counter = phase_counter_;
+	state->data_end_address = data_end_address_;
+	state->data_start_address = data_start_address_;
+	return state;
+}
+
+void OricTAP::set_state(const State &state) {
+	const auto &oric_state = static_cast<const ParsingState &>(state);
+	file_.seek(oric_state.file_offset, SEEK_SET);
+	current_value_ = oric_state.current_value;
+	bit_count_ = oric_state.bit_count;
+	pulse_counter_ = oric_state.pulse_counter;
+	phase_ = oric_state.phase;
+	next_phase_ = oric_state.next_phase;
+	phase_counter_ = oric_state.phase_counter;
+	data_end_address_ = oric_state.data_end_address;
+	data_start_address_ = oric_state.data_start_address;
+}
+
 Tape::Pulse OricTAP::virtual_get_next_pulse() {
 	// Each byte byte is written as 13 bits: 0, eight bits of data, parity, three 1s.
 	if(bit_count_ == 13) {
@@ -52,6 +52,18 @@ class OricTAP: public Tape {
 		} phase_, next_phase_;
 		int phase_counter_;
 		uint16_t data_end_address_, data_start_address_;
+
+		struct ParsingState: public State {
+			long file_offset;
+			uint16_t current_value;
+			int bit_count;
+			int pulse_counter;
+			Phase phase, next_phase;
+			int phase_counter;
+			uint16_t data_end_address, data_start_address;
+		};
+		std::unique_ptr<State> get_state() final;
+		void set_state(const State &) final;
 };
 
 }
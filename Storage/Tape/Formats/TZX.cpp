@@ -48,6 +48,19 @@ void TZX::virtual_reset() {
 	post_gap(500);
 }
 
+std::unique_ptr<Tape::State> TZX::get_source_state() {
+	auto state = std::make_unique<ParsingState>();
+	state->file_offset = file_.tell();
+	state->current_level = current_level_;
+	return state;
+}
+
+void TZX::set_source_state(const State &state) {
+	const auto &tzx_state = static_cast<const ParsingState &>(state);
+	file_.seek(tzx_state.file_offset, SEEK_SET);
+	current_level_ = tzx_state.current_level;
+}
+
 void TZX::get_next_pulses() {
 	while(empty()) {
 		uint8_t chunk_id = file_.get8();
@@ -97,6 +97,13 @@ class TZX: public PulseQueuedTape {
 		void post_gap(unsigned int milliseconds);
 
 		void post_pulse(const Storage::Time &time);
+
+		struct ParsingState: public State {
+			long file_offset;
+			bool current_level;
+		};
+		std::unique_ptr<State> get_source_state() final;
+		void set_source_state(const State &) final;
 };
 
 }
@@ -87,6 +87,31 @@ Storage::Tape::Tape::Pulse PRG::virtual_get_next_pulse() {
 	return pulse;
 }
 
+std::unique_ptr<Storage::Tape::Tape::State> PRG::get_state() {
+	auto state = std::make_unique<ParsingState>();
+	state->file_offset = file_.tell();
+	state->file_phase = file_phase_;
+	state->phase_offset = phase_offset_;
+	state->bit_phase = bit_phase_;
+	state->output_token = output_token_;
+	state->output_byte = output_byte_;
+	state->check_digit = check_digit_;
+	state->copy_mask = copy_mask_;
+	return state;
+}
+
+void PRG::set_state(const State &state) {
+	const auto &prg_state = static_cast<const ParsingState &>(state);
+	file_.seek(prg_state.file_offset, SEEK_SET);
+	file_phase_ = prg_state.file_phase;
+	phase_offset_ = prg_state.phase_offset;
+	bit_phase_ = prg_state.bit_phase;
+	output_token_ = prg_state.output_token;
+	output_byte_ = prg_state.output_byte;
+	check_digit_ = prg_state.check_digit;
+	copy_mask_ = prg_state.copy_mask;
+}
+
 void PRG::virtual_reset() {
 	bit_phase_ = 3;
 	file_.seek(2, SEEK_SET);
@@ -68,6 +68,19 @@ class PRG: public Tape {
 		uint8_t output_byte_;
 		uint8_t check_digit_;
 		uint8_t copy_mask_ = 0x80;
+
+		struct ParsingState: public State {
+			long file_offset;
+			FilePhase file_phase;
+			int phase_offset;
+			int bit_phase;
+			OutputToken output_token;
+			uint8_t output_byte;
+			uint8_t check_digit;
+			uint8_t copy_mask;
+		};
+		std::unique_ptr<State> get_state() final;
+		void set_state(const State &) final;
 };
 
 }
@@ -11,14 +11,69 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
+#include <zlib.h>
 
 #include "../../../Outputs/Log.hpp"
 
-// MARK: - ZLib extensions
+using namespace Storage::Tape;
+
+UEF::UEF(const std::string &file_name) {
+	// Decompress the entire file up front; UEFs are small, and parsing from memory
+	// allows seeking in either direction at no cost.
+	gzFile file = gzopen(file_name.c_str(), "rb");
+	if(!file) {
+		throw ErrorNotUEF;
+	}
+
+	uint8_t buffer[16384];
+	int bytes_read;
+	while((bytes_read = gzread(file, buffer, sizeof(buffer))) > 0) {
+		source_data_.insert(source_data_.end(), buffer, buffer + bytes_read);
+	}
+	gzclose(file);
+
+	if(source_data_.size() < 12 || std::memcmp(source_data_.data(), "UEF File!", 10)) {
+		throw ErrorNotUEF;
+	}
+
+	const uint8_t *const version = &source_data_[10];
+	if(version[1] > 0 || version[0] > 10) {
+		throw ErrorNotUEF;
+	}
+
+	source_data_pointer_ = 12;
+	set_platform_type();
+}
+
+// MARK: - Source data access
+
+uint8_t UEF::get8() {
+	// Reads beyond the end of the file produce zeroes.
+	if(source_data_pointer_ >= source_data_.size()) {
+		++source_data_pointer_;
+		return 0;
+	}
+	return source_data_[source_data_pointer_++];
+}
+
+int UEF::get16() {
+	const int low = get8();
+	return low | (get8() << 8);
+}
 
-static float gzgetfloat(gzFile file) {
+int UEF::get24() {
+	const int low = get16();
+	return low | (get8() << 16);
+}
+
+int UEF::get32() {
+	const int low = get16();
+	return low | (get16() << 16);
+}
+
+float UEF::get_float() {
 	uint8_t bytes[4];
-	gzread(file, bytes, 4);
+	for(auto &byte: bytes) byte = get8();
 
 	/* assume a four byte array named Float exists, where Float[0]
 	was the first byte read from the UEF, Float[1] the second, etc */
@@ -43,75 +98,40 @@ static float gzgetfloat(gzFile file) {
 	return result;
 }
 
-static uint8_t gzget8(gzFile file) {
-	// This is a workaround for gzgetc, which seems to be broken in ZLib 1.2.8.
-	uint8_t result;
-	gzread(file, &result, 1);
-	return result;
-}
-
-static int gzget16(gzFile file) {
-	uint8_t bytes[2];
-	gzread(file, bytes, 2);
-	return bytes[0] | (bytes[1] << 8);
-}
-
-static int gzget24(gzFile file) {
-	uint8_t bytes[3];
-	gzread(file, bytes, 3);
-	return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16);
-}
-
-static int gzget32(gzFile file) {
-	uint8_t bytes[4];
-	gzread(file, bytes, 4);
-	return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
-}
-
-using namespace Storage::Tape;
-
-UEF::UEF(const std::string &file_name) {
-	file_ = gzopen(file_name.c_str(), "rb");
-
-	char identifier[10];
-	int bytes_read = gzread(file_, identifier, 10);
-	if(bytes_read < 10 || std::strcmp(identifier, "UEF File!")) {
-		throw ErrorNotUEF;
-	}
-
-	uint8_t version[2];
-	gzread(file_, version, 2);
-
-	if(version[1] > 0 || version[0] > 10) {
-		throw ErrorNotUEF;
-	}
-
-	set_platform_type();
-}
-
-UEF::~UEF() {
-	gzclose(file_);
-}
-
 // MARK: - Public methods
 
 void UEF::virtual_reset() {
-	gzseek(file_, 12, SEEK_SET);
+	source_data_pointer_ = 12;
 	set_is_at_end(false);
 	clear();
 }
 
+std::unique_ptr<Storage::Tape::Tape::State> UEF::get_source_state() {
+	auto state = std::make_unique<ParsingState>();
+	state->source_data_pointer = source_data_pointer_;
+	state->time_base = time_base_;
+	state->is_300_baud = is_300_baud_;
+	return state;
+}
+
+void UEF::set_source_state(const State &state) {
+	const auto &uef_state = static_cast<const ParsingState &>(state);
+	source_data_pointer_ = uef_state.source_data_pointer;
+	time_base_ = uef_state.time_base;
+	is_300_baud_ = uef_state.is_300_baud;
+}
+
 // MARK: - Chunk navigator
 
 bool UEF::get_next_chunk(UEF::Chunk &result) {
-	const uint16_t chunk_id = uint16_t(gzget16(file_));
-	const uint32_t chunk_length = uint32_t(gzget32(file_));
-	const z_off_t start_of_next_chunk = gztell(file_) + chunk_length;
-
-	if(gzeof(file_)) {
+	if(source_data_pointer_ + 6 > source_data_.size()) {
 		return false;
 	}
 
+	const uint16_t chunk_id = uint16_t(get16());
+	const uint32_t chunk_length = uint32_t(get32());
+	const std::size_t start_of_next_chunk = source_data_pointer_ + chunk_length;
+
 	result.id = chunk_id;
 	result.length = chunk_length;
 	result.start_of_next_chunk = start_of_next_chunk;
@@ -143,13 +163,13 @@ void UEF::get_next_pulses() {
 			// change of base rate
 			case 0x0113: {
 				// TODO: something smarter than just converting this to an int
-				const float new_time_base = gzgetfloat(file_);
+				const float new_time_base = get_float();
 				time_base_ = unsigned(roundf(new_time_base));
 			}
 			break;
 
 			case 0x0117: {
-				const int baud_rate = gzget16(file_);
+				const int baud_rate = get16();
 				is_300_baud_ = (baud_rate == 300);
 			}
 			break;
@@ -159,7 +179,7 @@ void UEF::get_next_pulses() {
 			break;
 		}
 
-		gzseek(file_, next_chunk.start_of_next_chunk, SEEK_SET);
+		source_data_pointer_ = next_chunk.start_of_next_chunk;
 	}
 }
 
@@ -167,15 +187,15 @@ void UEF::get_next_pulses() {
 
 void UEF::queue_implicit_bit_pattern(uint32_t length) {
 	while(length--) {
-		queue_implicit_byte(gzget8(file_));
+		queue_implicit_byte(get8());
 	}
 }
 
 void UEF::queue_explicit_bit_pattern(uint32_t length) {
-	const std::size_t length_in_bits = (length << 3) - size_t(gzget8(file_));
+	const std::size_t length_in_bits = (length << 3) - size_t(get8());
 	uint8_t current_byte = 0;
 	for(std::size_t bit = 0; bit < length_in_bits; bit++) {
-		if(!(bit&7)) current_byte = gzget8(file_);
+		if(!(bit&7)) current_byte = get8();
 		queue_bit(current_byte&1);
 		current_byte >>= 1;
 	}
@@ -183,13 +203,13 @@ void UEF::queue_explicit_bit_pattern(uint32_t length) {
 
 void UEF::queue_integer_gap() {
 	Time duration;
-	duration.length = unsigned(gzget16(file_));
+	duration.length = unsigned(get16());
 	duration.clock_rate = time_base_;
 	emplace_back(Pulse::Zero, duration);
 }
 
 void UEF::queue_floating_point_gap() {
-	const float length = gzgetfloat(file_);
+	const float length = get_float();
 	Time duration;
 	duration.length = unsigned(length * 4000000);
 	duration.clock_rate = 4000000;
@@ -197,26 +217,26 @@ void UEF::queue_floating_point_gap() {
 }
 
 void UEF::queue_carrier_tone() {
-	unsigned int number_of_cycles = unsigned(gzget16(file_));
+	unsigned int number_of_cycles = unsigned(get16());
 	while(number_of_cycles--) queue_bit(1);
 }
 
 void UEF::queue_carrier_tone_with_dummy() {
-	unsigned int pre_cycles = unsigned(gzget16(file_));
-	unsigned int post_cycles = unsigned(gzget16(file_));
+	unsigned int pre_cycles = unsigned(get16());
+	unsigned int post_cycles = unsigned(get16());
 	while(pre_cycles--) queue_bit(1);
 	queue_implicit_byte(0xaa);
 	while(post_cycles--) queue_bit(1);
 }
 
 void UEF::queue_security_cycles() {
-	int number_of_cycles = gzget24(file_);
-	bool first_is_pulse = gzget8(file_) == 'P';
-	bool last_is_pulse = gzget8(file_) == 'P';
+	int number_of_cycles = get24();
+	bool first_is_pulse = get8() == 'P';
+	bool last_is_pulse = get8() == 'P';
 
 	uint8_t current_byte = 0;
 	for(int cycle = 0; cycle < number_of_cycles; cycle++) {
-		if(!(cycle&7)) current_byte = gzget8(file_);
+		if(!(cycle&7)) current_byte = get8();
 		int bit = (current_byte >> 7);
 		current_byte <<= 1;
 
@@ -238,16 +258,16 @@ void UEF::queue_security_cycles() {
 void UEF::queue_defined_data(uint32_t length) {
 	if(length < 3) return;
 
-	const int bits_per_packet = gzget8(file_);
-	const char parity_type = char(gzget8(file_));
-	int number_of_stop_bits = gzget8(file_);
+	const int bits_per_packet = get8();
+	const char parity_type = char(get8());
+	int number_of_stop_bits = get8();
 
 	const bool has_extra_stop_wave = (number_of_stop_bits < 0);
 	number_of_stop_bits = abs(number_of_stop_bits);
 
 	length -= 3;
 	while(length--) {
-		uint8_t byte = gzget8(file_);
+		uint8_t byte = get8();
 
 		uint8_t parity_value = byte;
 		parity_value ^= (parity_value >> 4);
@@ -326,7 +346,7 @@ void UEF::set_platform_type() {
 	Chunk next_chunk;
 	while(get_next_chunk(next_chunk)) {
 		if(next_chunk.id == 0x0005) {
-			uint8_t target = gzget8(file_);
+			uint8_t target = get8();
 			switch(target >> 4) {
 				case 0:	platform_type_ = TargetPlatform::BBCModelA;		break;
 				case 1:	platform_type_ = TargetPlatform::AcornElectron;	break;
@@ -336,7 +356,7 @@ void UEF::set_platform_type() {
 				default: break;
 			}
 		}
-		gzseek(file_, next_chunk.start_of_next_chunk, SEEK_SET);
+		source_data_pointer_ = next_chunk.start_of_next_chunk;
 	}
 	reset();
 }
@@ -15,7 +15,7 @@
 
 #include <cstdint>
 #include <string>
-#include <zlib.h>
+#include <vector>
 
 namespace Storage {
 namespace Tape {
@@ -31,7 +31,6 @@ class UEF : public PulseQueuedTape, public TargetPlatform::TypeDistinguisher {
 			@throws ErrorNotUEF if this file could not be opened and recognised as a valid UEF.
 		*/
 		UEF(const std::string &file_name);
-		~UEF();
 
 		enum {
 			ErrorNotUEF
@@ -44,14 +43,22 @@ class UEF : public PulseQueuedTape, public TargetPlatform::TypeDistinguisher {
 		TargetPlatform::Type target_platform_type();
 		TargetPlatform::Type platform_type_ = TargetPlatform::Acorn;
 
-		gzFile file_;
+		std::vector<uint8_t> source_data_;
+		std::size_t source_data_pointer_ = 0;
+
+		uint8_t get8();
+		int get16();
+		int get24();
+		int get32();
+		float get_float();
+
 		unsigned int time_base_ = 1200;
 		bool is_300_baud_ = false;
 
 		struct Chunk {
 			uint16_t id;
 			uint32_t length;
-			z_off_t start_of_next_chunk;
+			std::size_t start_of_next_chunk;
 		};
 
 		bool get_next_chunk(Chunk &);
@@ -71,6 +78,14 @@ class UEF : public PulseQueuedTape, public TargetPlatform::TypeDistinguisher {
 
 		void queue_bit(int bit);
 		void queue_implicit_byte(uint8_t byte);
+
+		struct ParsingState: public State {
+			std::size_t source_data_pointer;
+			unsigned int time_base;
+			bool is_300_baud;
+		};
+		std::unique_ptr<State> get_source_state() final;
+		void set_source_state(const State &) final;
 };
 
 }
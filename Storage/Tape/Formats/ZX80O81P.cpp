@@ -50,6 +50,29 @@ bool ZX80O81P::is_at_end() {
 	return has_finished_data() && has_ended_final_byte_;
 }
 
+std::unique_ptr<Tape::State> ZX80O81P::get_state() {
+	auto state = std::make_unique<ParsingState>();
+	state->byte = byte_;
+	state->bit_pointer = bit_pointer_;
+	state->wave_pointer = wave_pointer_;
+	state->is_past_silence = is_past_silence_;
+	state->has_ended_final_byte = has_ended_final_byte_;
+	state->is_high = is_high_;
+	state->data_pointer = data_pointer_;
+	return state;
+}
+
+void ZX80O81P::set_state(const State &state) {
+	const auto &zx_state = static_cast<const ParsingState &>(state);
+	byte_ = zx_state.byte;
+	bit_pointer_ = zx_state.bit_pointer;
+	wave_pointer_ = zx_state.wave_pointer;
+	is_past_silence_ = zx_state.is_past_silence;
+	has_ended_final_byte_ = zx_state.has_ended_final_byte;
+	is_high_ = zx_state.is_high;
+	data_pointer_ = zx_state.data_pointer;
+}
+
 Tape::Pulse ZX80O81P::virtual_get_next_pulse() {
 	Tape::Pulse pulse;
 
@@ -57,6 +57,16 @@ class ZX80O81P: public Tape, public TargetPlatform::TypeDistinguisher {
 
 		std::vector<uint8_t> data_;
 		std::size_t data_pointer_;
+
+		struct ParsingState: public State {
+			uint8_t byte;
+			int bit_pointer, wave_pointer;
+			bool is_past_silence, has_ended_final_byte;
+			bool is_high;
+			std::size_t data_pointer;
+		};
+		std::unique_ptr<State> get_state() final;
+		void set_state(const State &) final;
 };
 
 }
@@ -89,3 +89,7 @@ void Shifter::digital_phase_locked_loop_output_bit(int value) {
 		default:	break;
 	}
 }
+
+void Shifter::digital_phase_locked_loop_output_zeroes(int count) {
+	while(count--) digital_phase_locked_loop_output_bit(0);
+}
@@ -32,6 +32,7 @@ class Shifter {
 		}
 
 		void digital_phase_locked_loop_output_bit(int value);
+		void digital_phase_locked_loop_output_zeroes(int count);
 
 	private:
 		Storage::DigitalPhaseLockedLoop<Shifter, 15> pll_;
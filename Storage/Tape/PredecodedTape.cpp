@@ -0,0 +1,252 @@
+//
+//  PredecodedTape.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#include "PredecodedTape.hpp"
+
+#include "../../Concurrency/AsyncTaskQueue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <map>
+#include <mutex>
+
+using namespace Storage::Tape;
+
+namespace {
+
+Tape::Pulse::Type opposite(Tape::Pulse::Type type) {
+	return type == Tape::Pulse::High ? Tape::Pulse::Low : Tape::Pulse::High;
+}
+
+}
+
+// MARK: - Decoding.
+
+struct PredecodedTape::Decoding {
+	Decoding(std::shared_ptr<Tape> source) : source_(std::move(source)) {
+		clock_rates_[0] = FixedPointClockRate;
+		decoding_queue_.enqueue([this] {
+			decode();
+		});
+	}
+
+	~Decoding() {
+		should_stop_ = true;
+	}
+
+	static constexpr std::size_t BlockSize = 4096;
+	static constexpr unsigned int FixedPointClockRate = 1 << 24;
+	std::array<unsigned int, 256> clock_rates_;
+	std::size_t clock_rate_count_ = 1;
+
+	// Decoded blocks are published under mutex_; each published block is immutable,
+	// as are clock_rates_ entries once used by a published block.
+	std::mutex mutex_;
+	std::condition_variable block_published_;
+	std::vector<std::unique_ptr<Block>> blocks_;
+	bool is_decoded_ = false;
+	Pulse end_pulse_;
+
+	std::shared_ptr<Tape> source_;
+	std::atomic<bool> should_stop_ = false;
+	void decode();
+	uint8_t clock_rate_index(const Time &length, uint32_t &adjusted_length);
+
+	// Declared last so that it is destroyed first, while everything the decoder uses remains valid.
+	Concurrency::AsyncTaskQueue decoding_queue_;
+};
+
+std::shared_ptr<PredecodedTape::Decoding> PredecodedTape::decoding_for(const std::shared_ptr<Tape> &source) {
+	// Decodings are looked up by source. The source is also retained weakly, so that a source that has since
+	// been destroyed can't be confused with a new tape that happens to occupy the same address.
+	struct Entry {
+		std::weak_ptr<Tape> source;
+		std::weak_ptr<Decoding> decoding;
+	};
+	static std::mutex mutex;
+	static std::map<const Tape *, Entry> decodings;
+
+	std::lock_guard lock(mutex);
+
+	// Forget anything that is no longer of use.
+	for(auto iterator = decodings.begin(); iterator != decodings.end();) {
+		if(iterator->second.source.expired() || iterator->second.decoding.expired()) {
+			iterator = decodings.erase(iterator);
+		} else {
+			++iterator;
+		}
+	}
+
+	auto &entry = decodings[source.get()];
+	auto decoding = entry.decoding.lock();
+	if(!decoding) {
+		decoding = std::make_shared<Decoding>(source);
+		entry.source = source;
+		entry.decoding = decoding;
+	}
+	return decoding;
+}
+
+PredecodedTape::PredecodedTape(const std::shared_ptr<Tape> &source) : decoding_(decoding_for(source)) {}
+
+uint8_t PredecodedTape::Decoding::clock_rate_index(const Time &length, uint32_t &adjusted_length) {
+	adjusted_length = length.length;
+
+	const auto end = clock_rates_.begin() + long(clock_rate_count_);
+	const auto existing = std::find(clock_rates_.begin() + 1, end, length.clock_rate);
+	if(existing != end) {
+		return uint8_t(existing - clock_rates_.begin());
+	}
+
+	if(clock_rate_count_ < clock_rates_.size()) {
+		clock_rates_[clock_rate_count_] = length.clock_rate;
+		++clock_rate_count_;
+		return uint8_t(clock_rate_count_ - 1);
+	}
+
+	// The table is full; fall back on fixed point.
+	const uint64_t fixed_length = (uint64_t(length.length) * FixedPointClockRate) / length.clock_rate;
+	adjusted_length = uint32_t(std::min(fixed_length, uint64_t(std::numeric_limits<uint32_t>::max())));
+	return 0;
+}
+
+void PredecodedTape::Decoding::decode() {
+	source_->reset();
+
+	auto block = std::make_unique<Block>();
+	block->reserve(BlockSize);
+
+	const auto publish = [&] {
+		std::lock_guard lock(mutex_);
+		blocks_.push_back(std::move(block));
+		block_published_.notify_all();
+	};
+
+	while(!source_->is_at_end() && !should_stop_) {
+		const Pulse pulse = source_->get_next_pulse();
+
+		uint32_t length;
+		const uint8_t clock_rate = clock_rate_index(pulse.length, length);
+
+		// Attempt to extend the current run.
+		if(!block->empty()) {
+			Run &run = block->back();
+			if(
+				run.length == length &&
+				run.clock_rate == clock_rate &&
+				run.count < std::numeric_limits<uint16_t>::max()
+			) {
+				const auto run_type = Pulse::Type(run.type);
+				if(run.count == 1 && run_type != Pulse::Zero && pulse.type == opposite(run_type)) {
+					run.alternates = 1;
+					++run.count;
+					continue;
+				}
+
+				const auto expected_type = (run.alternates && (run.count & 1)) ? opposite(run_type) : run_type;
+				if(pulse.type == expected_type) {
+					++run.count;
+					continue;
+				}
+			}
+		}
+
+		// Otherwise start a new one, publishing the current block first if it is full.
+		if(block->size() == BlockSize) {
+			publish();
+			block = std::make_unique<Block>();
+			block->reserve(BlockSize);
+		}
+
+		Run run;
+		run.length = length;
+		run.count = 1;
+		run.clock_rate = clock_rate;
+		run.type = pulse.type;
+		run.alternates = 0;
+		block->push_back(run);
+	}
+
+	// Capture whatever the source supplies beyond its end, for repetition.
+	end_pulse_ = source_->get_next_pulse();
+
+	if(!block->empty()) {
+		publish();
+	}
+
+	std::lock_guard lock(mutex_);
+	is_decoded_ = true;
+	source_.reset();
+	block_published_.notify_all();
+}
+
+// MARK: - Reading.
+
+bool PredecodedTape::find_pulse() {
+	while(true) {
+		if(block_) {
+			if(position_.run < block_->size()) return true;
+
+			++position_.block;
+			position_.run = 0;
+			position_.pulse = 0;
+			block_ = nullptr;
+		}
+
+		std::unique_lock lock(decoding_->mutex_);
+		decoding_->block_published_.wait(lock, [this] {
+			return position_.block < decoding_->blocks_.size() || decoding_->is_decoded_;
+		});
+		if(position_.block == decoding_->blocks_.size()) return false;
+		block_ = decoding_->blocks_[position_.block].get();
+	}
+}
+
+bool PredecodedTape::is_at_end() {
+	return !find_pulse();
+}
+
+Tape::Pulse PredecodedTape::virtual_get_next_pulse() {
+	if(!find_pulse()) {
+		return decoding_->end_pulse_;
+	}
+
+	const Run &run = (*block_)[position_.run];
+	const auto run_type = Pulse::Type(run.type);
+	const Pulse pulse(
+		(run.alternates && (position_.pulse & 1)) ? opposite(run_type) : run_type,
+		Time(run.length, decoding_->clock_rates_[run.clock_rate])
+	);
+
+	++position_.pulse;
+	if(position_.pulse == run.count) {
+		position_.pulse = 0;
+		++position_.run;
+	}
+
+	return pulse;
+}
+
+void PredecodedTape::virtual_reset() {
+	position_ = Position();
+	block_ = nullptr;
+}
+
+std::unique_ptr<Tape::State> PredecodedTape::get_state() {
+	auto state = std::make_unique<PositionState>();
+	state->position = position_;
+	return state;
+}
+
+void PredecodedTape::set_state(const State &state) {
+	position_ = static_cast<const PositionState &>(state).position;
+	block_ = nullptr;
+}
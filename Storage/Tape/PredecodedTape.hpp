@@ -0,0 +1,88 @@
+//
+//  PredecodedTape.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 18/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef PredecodedTape_hpp
+#define PredecodedTape_hpp
+
+#include "Tape.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace Storage {
+namespace Tape {
+
+/*!
+	Provides a @c Tape that decodes another, once, into a compact run-length list of pulses, and
+	thereafter serves pulses from that list.
+
+	Decoding occurs on a background thread, beginning at construction; pulses are available as soon as
+	the first block of runs has been decoded, and a request for a pulse that has not yet been decoded
+	will block until it has been.
+
+	All PredecodedTapes of the same source share a single decoding, so the source is read by only one
+	thread however many players are supplied with it, e.g. by a multimachine. Each has its own read position.
+
+	Each run is a count of pulses of identical length, either of the same type or alternating between
+	high and low. Lengths are retained exactly, as an integral number of ticks of one of a small table
+	of clock rates; a tape that uses more distinct clock rates than that table can hold has its
+	remaining lengths stored in fixed point.
+*/
+class PredecodedTape: public Tape {
+	public:
+		/*!
+			Begins decoding @c source, unless a decoding of it is already ongoing or complete. @c source is read
+			on a background thread until decoding is complete, and is released thereafter. Tapes aren't thread safe,
+			so the caller must not use @c source for anything other than constructing further PredecodedTapes.
+		*/
+		PredecodedTape(const std::shared_ptr<Tape> &source);
+
+		// implemented to satisfy @c Tape
+		bool is_at_end() final;
+
+	private:
+		Pulse virtual_get_next_pulse() final;
+		void virtual_reset() final;
+
+		std::unique_ptr<State> get_state() final;
+		void set_state(const State &) final;
+
+		// MARK: - Decoded storage.
+		struct Run {
+			uint32_t length;
+			uint16_t count;
+			uint8_t clock_rate;
+			uint8_t type : 2;
+			uint8_t alternates : 1;
+		};
+		static_assert(sizeof(Run) == 8);
+		using Block = std::vector<Run>;
+
+		/// The decoding of a single source tape, shared by all PredecodedTapes of that source.
+		struct Decoding;
+		std::shared_ptr<Decoding> decoding_;
+		static std::shared_ptr<Decoding> decoding_for(const std::shared_ptr<Tape> &source);
+
+		// MARK: - Read position.
+		struct Position {
+			std::size_t block = 0;
+			std::size_t run = 0;
+			std::size_t pulse = 0;
+		} position_;
+		const Block *block_ = nullptr;
+		bool find_pulse();
+
+		struct PositionState: public State {
+			Position position;
+		};
+};
+
+}
+}
+
+#endif /* PredecodedTape_hpp */
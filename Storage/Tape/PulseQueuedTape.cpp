@@ -63,3 +63,23 @@ Tape::Pulse PulseQueuedTape::virtual_get_next_pulse() {
 	pulse_pointer_++;
 	return queued_pulses_[read_pointer];
 }
+
+std::unique_ptr<Tape::State> PulseQueuedTape::get_state() {
+	// The queue itself isn't captured, so decline to capture state unless it is exhausted.
+	if(pulse_pointer_ != queued_pulses_.size()) return nullptr;
+
+	auto source_state = get_source_state();
+	if(!source_state) return nullptr;
+
+	auto state = std::make_unique<QueueState>();
+	state->is_at_end = is_at_end_;
+	state->source_state = std::move(source_state);
+	return state;
+}
+
+void PulseQueuedTape::set_state(const State &state) {
+	const auto &queue_state = static_cast<const QueueState &>(state);
+	clear();
+	is_at_end_ = queue_state.is_at_end;
+	set_source_state(*queue_state.source_state);
+}
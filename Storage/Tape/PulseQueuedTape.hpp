@@ -24,6 +24,10 @@ namespace Tape {
 	Otherwise get_next_pulse() returns something from the pulse queue if there is
 	anything there, and otherwise calls get_next_pulses(). get_next_pulses() is
 	virtual, giving subclasses a chance to provide the next batch of pulses.
+
+	Positions can be captured only while the queue is exhausted, i.e. between
+	batches; subclasses that can capture the position of their source should
+	implement get_source_state() and set_source_state().
 */
 class PulseQueuedTape: public Tape {
 	public:
@@ -39,10 +43,21 @@ class PulseQueuedTape: public Tape {
 		void set_is_at_end(bool);
 		virtual void get_next_pulses() = 0;
 
+		virtual std::unique_ptr<State> get_source_state() { return nullptr; }
+		virtual void set_source_state(const State &) {}
+
 	private:
 		Pulse virtual_get_next_pulse();
 		Pulse silence();
 
+		std::unique_ptr<State> get_state() final;
+		void set_state(const State &) final;
+
+		struct QueueState: public State {
+			bool is_at_end;
+			std::unique_ptr<State> source_state;
+		};
+
 		std::vector<Pulse> queued_pulses_;
 		std::size_t pulse_pointer_;
 		bool is_at_end_;
@@ -7,6 +7,9 @@
 //
 
 #include "Tape.hpp"
+#include "PredecodedTape.hpp"
+
+#include <algorithm>
 
 using namespace Storage::Tape;
 
@@ -19,25 +22,74 @@ TapePlayer::TapePlayer(int input_clock_rate) :
 // MARK: - Seeking
 
 void Storage::Tape::Tape::seek(Time &seek_time) {
-	Time next_time(0);
-	reset();
+	const Checkpoint &checkpoint = checkpoint_for_time(seek_time);
+	restore(checkpoint);
+
+	Time next_time = checkpoint.time;
 	while(next_time <= seek_time) {
-		get_next_pulse();
-		next_time += pulse_.length;
+		get_next_indexed_pulse(next_time);
 	}
 }
 
 Storage::Time Tape::get_current_time() {
-	Time time(0);
-	uint64_t steps = get_offset();
-	reset();
-	while(steps--) {
-		get_next_pulse();
-		time += pulse_.length;
+	const uint64_t target = offset_;
+	const Checkpoint &checkpoint = checkpoint_for_offset(target);
+	restore(checkpoint);
+
+	Time time = checkpoint.time;
+	while(offset_ < target) {
+		get_next_indexed_pulse(time);
 	}
 	return time;
 }
 
+// MARK: - Checkpoint index
+
+const Tape::Checkpoint &Tape::checkpoint_for_offset(uint64_t offset) {
+	if(checkpoints_.empty()) checkpoints_.push_back(Checkpoint{0, Time(0), nullptr});
+
+	// Find the final checkpoint that is no later than offset; the first checkpoint is
+	// always at offset 0 so this search can't fail.
+	const auto next = std::upper_bound(checkpoints_.begin(), checkpoints_.end(), offset, [](uint64_t offset, const Checkpoint &checkpoint) {
+		return offset < checkpoint.offset;
+	});
+	return *(next - 1);
+}
+
+const Tape::Checkpoint &Tape::checkpoint_for_time(const Time &time) {
+	if(checkpoints_.empty()) checkpoints_.push_back(Checkpoint{0, Time(0), nullptr});
+
+	const auto next = std::upper_bound(checkpoints_.begin(), checkpoints_.end(), time, [](const Time &time, const Checkpoint &checkpoint) {
+		return time < checkpoint.time;
+	});
+	return *(next - 1);
+}
+
+void Tape::restore(const Checkpoint &checkpoint) {
+	if(!checkpoint.state) {
+		reset();
+		return;
+	}
+
+	offset_ = checkpoint.offset;
+	set_state(*checkpoint.state);
+}
+
+void Tape::get_next_indexed_pulse(Time &time) {
+	get_next_pulse();
+	time += pulse_.length;
+
+	// Attempt to add a checkpoint if this is sufficiently far beyond the end of the index.
+	// Subclasses may decline to capture state at any given offset, in which case the attempt
+	// will be repeated at the next.
+	if(offset_ >= checkpoints_.back().offset + CheckpointInterval) {
+		auto state = get_state();
+		if(state) {
+			checkpoints_.push_back(Checkpoint{offset_, time, std::move(state)});
+		}
+	}
+}
+
 void Storage::Tape::Tape::reset() {
 	offset_ = 0;
 	virtual_reset();
@@ -55,11 +107,22 @@ uint64_t Tape::get_offset() {
 
 void Tape::set_offset(uint64_t offset) {
 	if(offset == offset_) return;
-	if(offset < offset_) {
-		reset();
+
+	// If the target is ahead of the current position and there's no checkpoint in between,
+	// just proceed forwards. Otherwise jump to the closest checkpoint and proceed from there,
+	// which might add to the index.
+	const Checkpoint &checkpoint = checkpoint_for_offset(offset);
+	if(offset > offset_ && checkpoint.offset <= offset_) {
+		offset -= offset_;
+		while(offset--) get_next_pulse();
+		return;
+	}
+
+	restore(checkpoint);
+	Time time = checkpoint.time;
+	while(offset_ < offset) {
+		get_next_indexed_pulse(time);
 	}
-	offset -= offset_;
-	while(offset--) get_next_pulse();
 }
 
 // MARK: - Player
@@ -68,8 +131,12 @@ ClockingHint::Preference TapePlayer::preferred_clocking() const {
 	return (!tape_ || tape_->is_at_end()) ? ClockingHint::Preference::None : ClockingHint::Preference::JustInTime;
 }
 
-void TapePlayer::set_tape(std::shared_ptr<Storage::Tape::Tape> tape) {
-	tape_ = tape;
+void TapePlayer::set_tape(std::shared_ptr<Storage::Tape::Tape> tape, bool predecode) {
+	if(predecode && tape) {
+		tape_ = std::make_shared<PredecodedTape>(tape);
+	} else {
+		tape_ = std::move(tape);
+	}
 	reset_timer();
 	get_next_pulse();
 	update_clocking_observer();
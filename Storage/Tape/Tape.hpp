@@ -10,6 +10,7 @@
 #define Tape_hpp
 
 #include <memory>
+#include <vector>
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../../ClockReceiver/ClockingHintSource.hpp"
@@ -29,6 +30,11 @@ namespace Tape {
 	Subclasses should implement at least @c get_next_pulse and @c reset to provide a serial feeding
 	of pulses and the ability to return to the start of the feed. They may also implement @c seek if
 	a better implementation than a linear search from the @c reset time can be implemented.
+
+	Subclasses that can capture their parsing position should also implement @c get_state and
+	@c set_state; if they do then @c seek, @c get_current_time and @c set_offset will operate via a
+	lazily-built index of checkpoints, and will cost at most a checkpoint interval's worth of pulses
+	rather than a linear search from the start of the tape.
 */
 class Tape {
 	public:
@@ -80,12 +86,48 @@ class Tape {
 
 		virtual ~Tape() {};
 
+	protected:
+		/*!
+			A base for whatever a subclass needs to store in order to resume from a captured position.
+		*/
+		struct State {
+			virtual ~State() {}
+		};
+
+		/*!
+			@returns an object sufficient to return this tape to its current position via @c set_state,
+				or @c nullptr if the current position can't be captured. The default implementation
+				always returns @c nullptr.
+		*/
+		virtual std::unique_ptr<State> get_state() { return nullptr; }
+
+		/*!
+			Returns this tape to a position previously captured via @c get_state.
+		*/
+		virtual void set_state(const State &) {}
+
 	private:
-		uint64_t offset_;
+		uint64_t offset_ = 0;
 		Tape::Pulse pulse_;
 
 		virtual Pulse virtual_get_next_pulse() = 0;
 		virtual void virtual_reset() = 0;
+
+		// The checkpoint index; checkpoints are added as a side effect of any seek, offset change or time
+		// query that proceeds beyond the current final checkpoint. Entry 0 is the start of the tape,
+		// for which no state is stored.
+		struct Checkpoint {
+			uint64_t offset;
+			Time time;
+			std::unique_ptr<State> state;
+		};
+		std::vector<Checkpoint> checkpoints_;
+		static constexpr uint64_t CheckpointInterval = 4096;
+
+		const Checkpoint &checkpoint_for_offset(uint64_t offset);
+		const Checkpoint &checkpoint_for_time(const Time &time);
+		void restore(const Checkpoint &);
+		void get_next_indexed_pulse(Time &time);
 };
 
 /*!
@@ -100,7 +142,17 @@ class TapePlayer: public TimedEventLoop, public ClockingHint::Source {
 		TapePlayer(int input_clock_rate);
 		virtual ~TapePlayer() {}
 
-		void set_tape(std::shared_ptr<Storage::Tape::Tape> tape);
+		/*!
+			Sets the tape to play. If @c predecode is @c true then the tape will be decoded once, in the
+			background, to an in-memory list of pulses, from which it will subsequently be played;
+			@c get_tape will then return that list rather than the original.
+
+			A predecoded tape is read from the decoding thread, so it is handed over to this player:
+			the caller must release or otherwise stop using it. It may be supplied to other players only
+			for predecoding, in which case all share the same decoding. The player itself retains only
+			the decoded list.
+		*/
+		void set_tape(std::shared_ptr<Storage::Tape::Tape> tape, bool predecode = false);
 		bool has_tape();
 		std::shared_ptr<Storage::Tape::Tape> get_tape();
 
@@ -10,7 +10,7 @@
 
 #include <algorithm>
 #include <cassert>
-#include <cmath>
+#include <limits>
 
 using namespace Storage;
 
@@ -54,7 +54,7 @@ Cycles::IntType TimedEventLoop::get_input_clock_rate() const {
 }
 
 void TimedEventLoop::reset_timer() {
-	subcycles_until_event_ = 0.0;
+	subcycles_until_event_ = 0;
 	cycles_until_event_ = 0;
 }
 
@@ -64,21 +64,27 @@ void TimedEventLoop::jump_to_next_event() {
 }
 
 void TimedEventLoop::set_next_event_time_interval(Time interval) {
-	set_next_event_time_interval(interval.get<float>());
+	set_next_event_cycles_interval(interval.get_fixed_cycles(uint32_t(input_clock_rate_)));
 }
 
 void TimedEventLoop::set_next_event_time_interval(float interval) {
-	// Calculate [interval]*[input clock rate] + [subcycles until this event]
-	const float float_interval = interval * float(input_clock_rate_) + subcycles_until_event_;
+	const double cycles = std::max(double(interval), 0.0) * double(input_clock_rate_) * 4294967296.0;
+	set_next_event_cycles_interval(
+		cycles < double(std::numeric_limits<uint64_t>::max()) ? uint64_t(cycles) : std::numeric_limits<uint64_t>::max()
+	);
+}
+
+void TimedEventLoop::set_next_event_cycles_interval(uint64_t interval) {
+	// Add [interval] to [subcycles until this event]; saturate rather than overflowing.
+	const uint64_t total = (interval > std::numeric_limits<uint64_t>::max() - subcycles_until_event_) ?
+		std::numeric_limits<uint64_t>::max() : interval + subcycles_until_event_;
 
 	// This event will fire in the integral number of cycles from now, putting us at the remainder
 	// number of subcycles.
-	const Cycles::IntType addition = Cycles::IntType(float_interval);
-	cycles_until_event_ += addition;
-	subcycles_until_event_ = fmodf(float_interval, 1.0f);
+	cycles_until_event_ += Cycles::IntType(total >> 32);
+	subcycles_until_event_ = uint32_t(total);
 
 	assert(cycles_until_event_ >= 0);
-	assert(subcycles_until_event_ >= 0.0f);
 }
 
 Time TimedEventLoop::get_time_into_next_event() {
@@ -32,6 +32,10 @@ namespace Storage {
 
 		Subclasses may also call @c jump_to_next_event to cause the next event to be communicated instantly.
 
+		Time is tracked internally in 32.32 fixed point, in units of the input clock, so intervals supplied
+		as @c Time are converted without any floating point or common-divisor arithmetic, and fractional
+		cycles don't drift over long runs.
+
 		Subclasses are therefore expected to call @c set_next_event_time_interval upon obtaining an event stream,
 		and again in response to each call to @c process_next_event while events are ongoing. They may use
 		@c reset_timer to initiate a distinctly-timed stream or @c jump_to_next_event to short-circuit the timing
@@ -66,6 +70,12 @@ namespace Storage {
 			void set_next_event_time_interval(Time interval);
 			void set_next_event_time_interval(float interval);
 
+			/*!
+				Sets the time interval until the next event as a number of input clock cycles,
+				in 32.32 fixed point.
+			*/
+			void set_next_event_cycles_interval(uint64_t interval);
+
 			/*!
 				Communicates that the next event is triggered. A subclass will idiomatically process that event
 				and make a fresh call to @c set_next_event_time_interval to keep the event loop running.
@@ -103,7 +113,7 @@ namespace Storage {
 		private:
 			Cycles::IntType input_clock_rate_ = 0;
 			Cycles::IntType cycles_until_event_ = 0;
-			float subcycles_until_event_ = 0.0f;
+			uint32_t subcycles_until_event_ = 0;
 	};
 
 }